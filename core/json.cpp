@@ -0,0 +1,429 @@
+#include "json.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+
+namespace nicxlive::core::serde {
+
+namespace detail {
+
+namespace {
+
+template <typename T>
+bool parseWhole(std::string_view text, T& out) {
+    if (text.empty()) return false;
+    const char* first = text.data();
+    const char* last = first + text.size();
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    auto [ptr, ec] = std::from_chars(first, last, out);
+    return ec == std::errc{} && ptr == last;
+#else
+    if constexpr (std::is_floating_point_v<T>) {
+        // Numbers are short; copy one into a terminated buffer for strto*.
+        char buffer[64];
+        if (text.size() >= sizeof(buffer)) return false;
+        std::memcpy(buffer, first, text.size());
+        buffer[text.size()] = '\0';
+        char* end = nullptr;
+        errno = 0;
+        if constexpr (std::is_same_v<T, float>) {
+            out = std::strtof(buffer, &end);
+        } else {
+            out = std::strtod(buffer, &end);
+        }
+        return errno == 0 && end == buffer + text.size();
+    } else {
+        auto [ptr, ec] = std::from_chars(first, last, out);
+        return ec == std::errc{} && ptr == last;
+    }
+#endif
+}
+
+} // namespace
+
+bool jsonToValue(std::string_view text, bool& out) {
+    if (text == "true" || text == "1") {
+        out = true;
+        return true;
+    }
+    if (text == "false" || text == "0") {
+        out = false;
+        return true;
+    }
+    return false;
+}
+
+bool jsonToValue(std::string_view text, float& out) { return parseWhole(text, out); }
+
+bool jsonToValue(std::string_view text, double& out) { return parseWhole(text, out); }
+
+bool jsonToValue(std::string_view text, long long& out) { return parseWhole(text, out); }
+
+bool jsonToValue(std::string_view text, unsigned long long& out) {
+    // Stream extraction wraps negative input into the unsigned range; keep that.
+    if (!text.empty() && text.front() == '-') {
+        long long signedValue = 0;
+        if (!parseWhole(text, signedValue)) return false;
+        out = static_cast<unsigned long long>(signedValue);
+        return true;
+    }
+    return parseWhole(text, out);
+}
+
+} // namespace detail
+
+JsonValue::const_iterator JsonValue::find(std::string_view key) const {
+    for (auto it = begin(); it != end(); ++it) {
+        if (it->first == key) return it;
+    }
+    return end();
+}
+
+std::size_t JsonValue::count(std::string_view key) const {
+    std::size_t n = 0;
+    for (const auto& child : *this) {
+        if (child.first == key) ++n;
+    }
+    return n;
+}
+
+const JsonValue* JsonValue::get_child_optional(std::string_view path) const {
+    const JsonValue* node = this;
+    while (node) {
+        const auto dot = path.find('.');
+        const auto segment = path.substr(0, dot);
+        const auto it = node->find(segment);
+        if (it == node->end()) return nullptr;
+        node = &it->second;
+        if (dot == std::string_view::npos) break;
+        path.remove_prefix(dot + 1);
+    }
+    return node;
+}
+
+const JsonValue& JsonValue::get_child(std::string_view path) const {
+    if (const auto* node = get_child_optional(path)) return *node;
+    throw JsonError("No such node (" + std::string(path) + ")");
+}
+
+void JsonValue::readFloats(std::vector<float>& out) const {
+    out.reserve(out.size() + count_);
+    for (const auto& child : *this) {
+        float v = 0.0f;
+        if (!detail::jsonToValue(child.second.text_, v)) {
+            throw JsonError("conversion of JSON value '" + std::string(child.second.text_) + "' to float failed");
+        }
+        out.push_back(v);
+    }
+}
+
+// Recursive-descent parser. Children of the container being parsed collect on a shared scratch
+// stack and move into the arena in one block once the container closes, so every container is a
+// single contiguous allocation and nothing is ever reallocated or freed individually.
+class JsonParser {
+public:
+    JsonParser(std::string_view text, std::pmr::memory_resource& arena) : cur_(text.data()), end_(text.data() + text.size()), arena_(arena) {}
+
+    JsonValue parseDocument() {
+        JsonValue root;
+        skipWhitespace();
+        parseValue(root, 0);
+        skipWhitespace();
+        if (cur_ != end_) fail("unexpected trailing characters");
+        return root;
+    }
+
+private:
+    static constexpr int kMaxDepth = 512;
+
+    [[noreturn]] void fail(const char* what) const {
+        throw JsonError(std::string("JSON parse error: ") + what);
+    }
+
+    void skipWhitespace() {
+        while (cur_ != end_ && (*cur_ == ' ' || *cur_ == '\n' || *cur_ == '\r' || *cur_ == '\t')) ++cur_;
+    }
+
+    void expect(char c, const char* what) {
+        skipWhitespace();
+        if (cur_ == end_ || *cur_ != c) fail(what);
+        ++cur_;
+    }
+
+    void parseValue(JsonValue& out, int depth) {
+        if (cur_ == end_) fail("unexpected end of input");
+        switch (*cur_) {
+        case '{':
+            parseContainer(out, depth, true);
+            return;
+        case '[':
+            parseContainer(out, depth, false);
+            return;
+        case '"':
+            out.kind_ = JsonValue::Kind::String;
+            out.text_ = parseString();
+            return;
+        case 't':
+            parseLiteral(out, "true", JsonValue::Kind::Bool);
+            return;
+        case 'f':
+            parseLiteral(out, "false", JsonValue::Kind::Bool);
+            return;
+        case 'n':
+            parseLiteral(out, "null", JsonValue::Kind::Null);
+            return;
+        default:
+            parseNumber(out);
+            return;
+        }
+    }
+
+    void parseLiteral(JsonValue& out, std::string_view literal, JsonValue::Kind kind) {
+        if (static_cast<std::size_t>(end_ - cur_) < literal.size() || std::string_view(cur_, literal.size()) != literal) {
+            fail("invalid literal");
+        }
+        out.kind_ = kind;
+        out.text_ = std::string_view(cur_, literal.size());
+        cur_ += literal.size();
+    }
+
+    void parseNumber(JsonValue& out) {
+        const char* start = cur_;
+        if (cur_ != end_ && *cur_ == '-') ++cur_;
+        const char* digits = cur_;
+        while (cur_ != end_ && *cur_ >= '0' && *cur_ <= '9') ++cur_;
+        if (cur_ == digits) fail("invalid value");
+        if (cur_ != end_ && *cur_ == '.') {
+            ++cur_;
+            const char* frac = cur_;
+            while (cur_ != end_ && *cur_ >= '0' && *cur_ <= '9') ++cur_;
+            if (cur_ == frac) fail("invalid number");
+        }
+        if (cur_ != end_ && (*cur_ == 'e' || *cur_ == 'E')) {
+            ++cur_;
+            if (cur_ != end_ && (*cur_ == '+' || *cur_ == '-')) ++cur_;
+            const char* exp = cur_;
+            while (cur_ != end_ && *cur_ >= '0' && *cur_ <= '9') ++cur_;
+            if (cur_ == exp) fail("invalid number");
+        }
+        out.kind_ = JsonValue::Kind::Number;
+        out.text_ = std::string_view(start, static_cast<std::size_t>(cur_ - start));
+    }
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    uint32_t parseHex4() {
+        if (end_ - cur_ < 4) fail("invalid escape");
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int h = hexValue(*cur_++);
+            if (h < 0) fail("invalid escape");
+            v = (v << 4) | static_cast<uint32_t>(h);
+        }
+        return v;
+    }
+
+    // Plain strings stay views into the source; only strings with escapes get an arena copy.
+    std::string_view parseString() {
+        ++cur_; // opening quote
+        const char* start = cur_;
+        while (cur_ != end_ && *cur_ != '"' && *cur_ != '\\') ++cur_;
+        if (cur_ == end_) fail("unterminated string");
+        if (*cur_ == '"') {
+            std::string_view view(start, static_cast<std::size_t>(cur_ - start));
+            ++cur_;
+            return view;
+        }
+        unescaped_.assign(start, cur_);
+        while (true) {
+            if (cur_ == end_) fail("unterminated string");
+            const char c = *cur_++;
+            if (c == '"') break;
+            if (c != '\\') {
+                unescaped_.push_back(c);
+                continue;
+            }
+            if (cur_ == end_) fail("unterminated string");
+            const char e = *cur_++;
+            switch (e) {
+            case '"': unescaped_.push_back('"'); break;
+            case '\\': unescaped_.push_back('\\'); break;
+            case '/': unescaped_.push_back('/'); break;
+            case 'b': unescaped_.push_back('\b'); break;
+            case 'f': unescaped_.push_back('\f'); break;
+            case 'n': unescaped_.push_back('\n'); break;
+            case 'r': unescaped_.push_back('\r'); break;
+            case 't': unescaped_.push_back('\t'); break;
+            case 'u': appendCodepoint(); break;
+            default: fail("invalid escape");
+            }
+        }
+        auto* copy = static_cast<char*>(arena_.allocate(unescaped_.size() ? unescaped_.size() : 1, alignof(char)));
+        std::memcpy(copy, unescaped_.data(), unescaped_.size());
+        return std::string_view(copy, unescaped_.size());
+    }
+
+    void appendCodepoint() {
+        uint32_t cp = parseHex4();
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            if (end_ - cur_ < 6 || cur_[0] != '\\' || cur_[1] != 'u') fail("invalid surrogate pair");
+            cur_ += 2;
+            const uint32_t low = parseHex4();
+            if (low < 0xDC00 || low > 0xDFFF) fail("invalid surrogate pair");
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+        }
+        if (cp < 0x80) {
+            unescaped_.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            unescaped_.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            unescaped_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            unescaped_.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            unescaped_.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            unescaped_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            unescaped_.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            unescaped_.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            unescaped_.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            unescaped_.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    void parseContainer(JsonValue& out, int depth, bool object) {
+        if (depth >= kMaxDepth) fail("nesting too deep");
+        ++cur_; // opening bracket
+        const std::size_t base = scratch_.size();
+        skipWhitespace();
+        const char close = object ? '}' : ']';
+        if (cur_ != end_ && *cur_ == close) {
+            ++cur_;
+        } else {
+            while (true) {
+                std::string_view key{};
+                if (object) {
+                    skipWhitespace();
+                    if (cur_ == end_ || *cur_ != '"') fail("expected object key");
+                    key = parseString();
+                    expect(':', "expected ':'");
+                }
+                skipWhitespace();
+                JsonValue child;
+                parseValue(child, depth + 1);
+                scratch_.emplace_back(key, child);
+                skipWhitespace();
+                if (cur_ == end_) fail("unexpected end of input");
+                if (*cur_ == ',') {
+                    ++cur_;
+                    continue;
+                }
+                if (*cur_ != close) fail(object ? "expected ',' or '}'" : "expected ',' or ']'");
+                ++cur_;
+                break;
+            }
+        }
+        const std::size_t count = scratch_.size() - base;
+        out.kind_ = object ? JsonValue::Kind::Object : JsonValue::Kind::Array;
+        out.count_ = static_cast<uint32_t>(count);
+        if (count) {
+            auto* block = static_cast<JsonValue::value_type*>(
+                arena_.allocate(count * sizeof(JsonValue::value_type), alignof(JsonValue::value_type)));
+            std::uninitialized_copy(scratch_.begin() + static_cast<std::ptrdiff_t>(base), scratch_.end(), block);
+            out.children_ = block;
+        }
+        scratch_.resize(base);
+    }
+
+    const char* cur_;
+    const char* end_;
+    std::pmr::memory_resource& arena_;
+    std::vector<JsonValue::value_type> scratch_{};
+    std::string unescaped_{};
+};
+
+JsonDocument::JsonDocument(std::string_view text) : arena_(text.size() + 256) {
+    JsonParser parser(text, arena_);
+    root_ = parser.parseDocument();
+}
+
+JsonDocument::JsonDocument(const JsonFlatNode* nodes, std::size_t count, std::string_view strings)
+    : arena_(count * sizeof(JsonValue::value_type) + 256) {
+    if (!nodes || count == 0) throw JsonError("empty JSON node table");
+    JsonValue::value_type* slots = nullptr;
+    if (count > 1) {
+        slots = static_cast<JsonValue::value_type*>(
+            arena_.allocate((count - 1) * sizeof(JsonValue::value_type), alignof(JsonValue::value_type)));
+        std::uninitialized_default_construct_n(slots, count - 1);
+    }
+    auto view = [&](uint32_t offset, uint32_t length) {
+        if (offset > strings.size() || length > strings.size() - offset) throw JsonError("JSON node text out of range");
+        return strings.substr(offset, length);
+    };
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& node = nodes[i];
+        if (node.kind > static_cast<uint8_t>(JsonValue::Kind::Object)) throw JsonError("invalid JSON node kind");
+        JsonValue& value = i == 0 ? root_ : slots[i - 1].second;
+        if (i) slots[i - 1].first = view(node.keyOffset, node.keyLength);
+        value.kind_ = static_cast<JsonValue::Kind>(node.kind);
+        value.text_ = view(node.textOffset, node.textLength);
+        if (node.childCount == 0) continue;
+        // Children always come after their parent, so a table that passes this cannot loop.
+        if (!value.isContainer() || node.firstChild <= i || node.firstChild >= count ||
+            node.childCount > count - node.firstChild) {
+            throw JsonError("invalid JSON node children");
+        }
+        value.children_ = slots + (node.firstChild - 1);
+        value.count_ = node.childCount;
+    }
+}
+
+void JsonDocument::flatten(std::vector<JsonFlatNode>& nodes, std::string& strings, const FlattenPrune& prune) const {
+    constexpr std::size_t kSharedStringLimit = 16;
+    nodes.clear();
+    strings.clear();
+    std::unordered_map<std::string_view, uint32_t> shared;
+    auto store = [&](std::string_view s) -> uint32_t {
+        if (s.size() <= kSharedStringLimit) {
+            auto [it, inserted] = shared.try_emplace(s, static_cast<uint32_t>(strings.size()));
+            if (!inserted) return it->second;
+        }
+        if (strings.size() + s.size() > UINT32_MAX) throw JsonError("JSON document too large to flatten");
+        const auto offset = static_cast<uint32_t>(strings.size());
+        strings.append(s);
+        return offset;
+    };
+    auto fill = [&](JsonFlatNode& node, std::string_view key, const JsonValue& value) {
+        node.keyOffset = store(key);
+        node.keyLength = static_cast<uint32_t>(key.size());
+        node.textOffset = store(value.text_);
+        node.textLength = static_cast<uint32_t>(value.text_.size());
+        node.kind = static_cast<uint8_t>(value.kind_);
+    };
+
+    std::vector<const JsonValue*> values{&root_};
+    nodes.emplace_back();
+    fill(nodes.back(), {}, root_);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        // Pruned values keep their key and kind but lose their children.
+        if (!values[i] || values[i]->empty()) continue;
+        const JsonValue& value = *values[i];
+        if (nodes.size() + value.size() > UINT32_MAX) throw JsonError("JSON document too large to flatten");
+        nodes[i].firstChild = static_cast<uint32_t>(nodes.size());
+        nodes[i].childCount = value.count_;
+        for (const auto& child : value) {
+            values.push_back(prune && prune(value, child.first) ? nullptr : &child.second);
+            nodes.emplace_back();
+            fill(nodes.back(), child.first, child.second);
+        }
+    }
+}
+
+} // namespace nicxlive::core::serde
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nicxlive::core::serde {
+
+class JsonError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+// Scalar conversion with stream-extraction semantics (whole text must be consumed).
+bool jsonToValue(std::string_view text, bool& out);
+bool jsonToValue(std::string_view text, float& out);
+bool jsonToValue(std::string_view text, double& out);
+bool jsonToValue(std::string_view text, long long& out);
+bool jsonToValue(std::string_view text, unsigned long long& out);
+} // namespace detail
+
+// One value of a JsonDocument. The read API mirrors the boost::property_tree subset the
+// deserializers were written against: children are (key, value) pairs with empty keys for array
+// elements, scalars convert on access, and lookups take '.'-separated paths. Unlike a ptree the
+// nodes live in one arena, scalars are views into the source text and numbers convert with
+// from_chars rather than through a stringstream.
+class JsonValue {
+public:
+    enum class Kind : uint8_t { Null, Bool, Number, String, Array, Object };
+    using value_type = std::pair<std::string_view, JsonValue>;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    Kind kind() const { return kind_; }
+    bool isNumber() const { return kind_ == Kind::Number; }
+    bool isContainer() const { return kind_ == Kind::Array || kind_ == Kind::Object; }
+    // Scalar text (strings unescaped, literals as written); empty for arrays and objects.
+    std::string_view text() const { return text_; }
+    std::string data() const { return std::string(text_); }
+
+    const_iterator begin() const { return children_; }
+    const_iterator end() const { return children_ + count_; }
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    const value_type& front() const { return children_[0]; }
+    const value_type& back() const { return children_[count_ - 1]; }
+    // First child with this key (not a path); not_found() if there is none.
+    const_iterator find(std::string_view key) const;
+    const_iterator not_found() const { return end(); }
+    std::size_t count(std::string_view key) const;
+
+    // Child at a '.'-separated path; nullptr if any segment is missing.
+    const JsonValue* get_child_optional(std::string_view path) const;
+    const JsonValue& get_child(std::string_view path) const;
+
+    template <typename T>
+    std::optional<T> get_value_optional() const {
+        if constexpr (std::is_same_v<T, std::string>) {
+            return std::string(text_);
+        } else if constexpr (std::is_same_v<T, bool> || std::is_floating_point_v<T>) {
+            T out{};
+            if (!detail::jsonToValue(text_, out)) return std::nullopt;
+            return out;
+        } else {
+            static_assert(std::is_integral_v<T>, "unsupported JSON value type");
+            using Wide = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+            Wide wide{};
+            if (!detail::jsonToValue(text_, wide)) return std::nullopt;
+            return static_cast<T>(wide);
+        }
+    }
+
+    template <typename T>
+    T get_value() const {
+        if (auto v = get_value_optional<T>()) return *std::move(v);
+        throw JsonError("conversion of JSON value '" + std::string(text_) + "' failed");
+    }
+
+    template <typename T>
+    T get_value(const T& fallback) const {
+        if (auto v = get_value_optional<T>()) return *std::move(v);
+        return fallback;
+    }
+
+    template <typename T>
+    std::optional<T> get_optional(std::string_view path) const {
+        const auto* node = get_child_optional(path);
+        if (!node) return std::nullopt;
+        return node->get_value_optional<T>();
+    }
+
+    template <typename T>
+    T get(std::string_view path) const {
+        return get_child(path).get_value<T>();
+    }
+
+    template <typename T>
+    T get(std::string_view path, const T& fallback) const {
+        if (auto v = get_optional<T>(path)) return *std::move(v);
+        return fallback;
+    }
+
+    // Appends every child as a float, straight from the source text. Throws JsonError on a
+    // child that is not a number, like get_value<float>() would.
+    void readFloats(std::vector<float>& out) const;
+
+private:
+    friend class JsonParser;
+    friend class JsonDocument;
+
+    std::string_view text_{};
+    const value_type* children_{nullptr};
+    uint32_t count_{0};
+    Kind kind_{Kind::Null};
+};
+
+// One value of a flattened document (see JsonDocument::flatten). Plain data with a fixed layout so
+// it can be stored in binary files and read back in place.
+struct JsonFlatNode {
+    uint32_t keyOffset{0};
+    uint32_t keyLength{0};
+    uint32_t textOffset{0};
+    uint32_t textLength{0};
+    uint32_t firstChild{0};
+    uint32_t childCount{0};
+    uint8_t kind{0};
+    uint8_t reserved[3]{};
+};
+
+// A parsed JSON text. Values point into the source text, so it must outlive the document;
+// containers are allocated from the document's arena. Throws JsonError on malformed input.
+class JsonDocument {
+public:
+    explicit JsonDocument(std::string_view text);
+    // Rebuilds a flattened document without parsing any text. Values point into `strings`, which
+    // must outlive the document. Throws JsonError if the table is inconsistent.
+    JsonDocument(const JsonFlatNode* nodes, std::size_t count, std::string_view strings);
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    const JsonValue& root() const { return root_; }
+
+    // Writes the document as a node table in breadth-first order (node 0 is the root and the
+    // children of every container are consecutive) plus one blob holding every key and scalar.
+    // Short strings are stored once. Members for which `prune(object, key)` holds are written as
+    // empty containers.
+    using FlattenPrune = std::function<bool(const JsonValue& parent, std::string_view key)>;
+    void flatten(std::vector<JsonFlatNode>& nodes, std::string& strings, const FlattenPrune& prune = {}) const;
+
+private:
+    std::pmr::monotonic_buffer_resource arena_;
+    JsonValue root_{};
+};
+
+} // namespace nicxlive::core::serde
@@ -386,8 +386,9 @@ bool Composite::createSimpleMesh() {
                              std::abs(newTextureOffset.y - textureOffset.y) > TextureOffsetEpsilon;
         if (offsetChanged) {
             textureInvalidated = true;
-            mesh->vertices = vertexArray;
-            mesh->indices = {0, 1, 2, 2, 1, 3};
+            auto& resized = mutableMesh();
+            resized.vertices = vertexArray;
+            resized.indices = {0, 1, 2, 2, 1, 3};
             shouldUpdateVertices = true;
             autoResizedSize = Vec2{bounds.z - bounds.x, bounds.w - bounds.y};
             updateVertices();
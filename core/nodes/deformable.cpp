@@ -2,6 +2,8 @@
 #include "../puppet.hpp"
 #include "../render/profiler.hpp"
 
+#include <cstring>
+
 namespace nicxlive::core::nodes {
 namespace {
 template <typename HookVector>
@@ -29,6 +31,17 @@ void eraseDeformHook(HookVector& hooks, int stage, std::uintptr_t tag) {
         return hook.stage == stage && hook.tag == tag;
     }), hooks.end());
 }
+
+// Bitwise, so a reused hook result is exactly the one a fresh call would produce.
+bool sameValues(const Vec2Array& a, const Vec2Array& b) {
+    const std::size_t n = a.size();
+    if (n != b.size()) return false;
+    if (n == 0) return true;
+    return std::memcmp(a.dataX(), b.dataX(), n * sizeof(float)) == 0 &&
+           std::memcmp(a.dataY(), b.dataY(), n * sizeof(float)) == 0;
+}
+
+bool sameMatrix(const Mat4& a, const Mat4& b) { return std::memcmp(&a, &b, sizeof(Mat4)) == 0; }
 } // namespace
 
 void Deformation::update(const Vec2Array& points) { vertexOffsets = points; }
@@ -82,8 +95,9 @@ void DeformationStack::update() {
     owner_->refreshDeform();
 }
 
-void DeformationStack::push(const Deformation& deform) {
-    const auto& d = deform.vertexOffsets;
+void DeformationStack::push(const Deformation& deform) { push(deform.vertexOffsets); }
+
+void DeformationStack::push(const Vec2Array& d) {
     if (!owner_ || owner_->deformation.size() != d.size()) return;
     owner_->deformation += d;
     float maxAbs = 0.0f;
@@ -164,7 +178,7 @@ void Deformable::preProcess() {
     bool anyNotify = false;
     for (const auto& hook : deformPreProcessFilters) {
         Mat4 matrix = overrideTransformMatrix ? *overrideTransformMatrix : transform().toMat4();
-        auto result = hook.func(shared_from_this(), vertices, deformation, &matrix);
+        auto result = runDeformHook(hook, false, matrix);
         if (result.transform.has_value()) {
             overrideTransformMatrix = *result.transform;
         }
@@ -184,7 +198,7 @@ void Deformable::postProcess(int id) {
     for (const auto& hook : deformPostProcessFilters) {
         if (hook.stage != id) continue;
         Mat4 matrix = overrideTransformMatrix ? *overrideTransformMatrix : transform().toMat4();
-        auto result = hook.func(shared_from_this(), vertices, deformation, &matrix);
+        auto result = runDeformHook(hook, true, matrix);
         if (result.transform.has_value()) {
             overrideTransformMatrix = *result.transform;
         }
@@ -197,6 +211,41 @@ void Deformable::postProcess(int id) {
     }
 }
 
+Node::DeformFilterResult Deformable::runDeformHook(const Node::DeformFilterHook& hook, bool post, const Mat4& matrix) {
+    if (!hook.revision) return hook.func(shared_from_this(), vertices, deformation, &matrix);
+    auto memo = std::find_if(deformHookMemos.begin(), deformHookMemos.end(), [&](const DeformHookMemo& m) {
+        return m.post == post && m.stage == hook.stage && m.tag == hook.tag;
+    });
+    if (memo == deformHookMemos.end()) {
+        memo = deformHookMemos.insert(memo, DeformHookMemo{});
+        memo->post = post;
+        memo->stage = hook.stage;
+        memo->tag = hook.tag;
+    }
+    const bool sameVertices = memo->valid && sameValues(memo->vertices, vertices);
+    if (sameVertices && memo->revision == *hook.revision && sameMatrix(memo->matrix, matrix) &&
+        sameValues(memo->input, deformation)) {
+        if (memo->rewrites) deformation = memo->output;
+        return memo->result;
+    }
+    memo->revision = *hook.revision;
+    memo->matrix = matrix;
+    if (!sameVertices) memo->vertices = vertices;
+    memo->input = deformation;
+    memo->result = hook.func(shared_from_this(), vertices, deformation, &matrix);
+    memo->rewrites = !sameValues(deformation, memo->input);
+    if (memo->rewrites) memo->output = deformation;
+    // A hook that resized the buffer cannot be replayed into it.
+    memo->valid = deformation.size() == memo->input.size();
+    return memo->result;
+}
+
+void Deformable::dropDeformHookMemo(bool post, int stage, std::uintptr_t tag) {
+    deformHookMemos.erase(std::remove_if(deformHookMemos.begin(), deformHookMemos.end(), [&](const DeformHookMemo& m) {
+        return m.post == post && m.stage == stage && m.tag == tag;
+    }), deformHookMemos.end());
+}
+
 void Deformable::copyFrom(const Node& src, bool clone, bool deepCopy) {
     Node::copyFrom(src, clone, deepCopy);
     if (auto deformable = dynamic_cast<const Deformable*>(&src)) {
@@ -222,6 +271,21 @@ void Deformable::runPostTaskImpl(std::size_t priority, core::RenderContext& ctx)
     updateDeform();
 }
 
+bool Deformable::describeTaskAccess(core::TaskOrder order, core::TaskAccess& access) const {
+    // updateDeform() resizes a mismatched buffer, which moves the shared atlas under every other task.
+    if (deformation.size() != vertices.size()) return false;
+    if (!Node::describeTaskAccess(order, access)) return false;
+    // Deform hooks read their source deformer (which the wave planner orders first), so chains
+    // under independent deformers run side by side.
+    for (const auto* hooks : {&deformPreProcessFilters, &deformPostProcessFilters}) {
+        for (const auto& hook : *hooks) {
+            if (!describeFilterAccess(hook.source, hook.state, access)) return false;
+        }
+    }
+    access.writes.push_back(&deformation);
+    return true;
+}
+
 void Deformable::notifyDeformPushed(const Vec2Array& deform) { onDeformPushed(deform); }
 
 bool Deformable::hasDeformPreProcessFilter(int stage, std::uintptr_t tag) const {
@@ -234,19 +298,23 @@ bool Deformable::hasDeformPostProcessFilter(int stage, std::uintptr_t tag) const
 
 void Deformable::upsertDeformPreProcessFilter(Node::DeformFilterHook hook, bool prepend) {
     requirePreProcessTask();
+    dropDeformHookMemo(false, hook.stage, hook.tag);
     upsertDeformHook(deformPreProcessFilters, hook, prepend);
 }
 
 void Deformable::upsertDeformPostProcessFilter(Node::DeformFilterHook hook, bool prepend) {
     requirePostTask(static_cast<std::size_t>(std::max(hook.stage, 0)));
+    dropDeformHookMemo(true, hook.stage, hook.tag);
     upsertDeformHook(deformPostProcessFilters, hook, prepend);
 }
 
 void Deformable::removeDeformPreProcessFilter(int stage, std::uintptr_t tag) {
+    dropDeformHookMemo(false, stage, tag);
     eraseDeformHook(deformPreProcessFilters, stage, tag);
 }
 
 void Deformable::removeDeformPostProcessFilter(int stage, std::uintptr_t tag) {
+    dropDeformHookMemo(true, stage, tag);
     eraseDeformHook(deformPostProcessFilters, stage, tag);
 }
 
@@ -38,6 +38,7 @@ public:
     void update();
 
     void push(const Deformation& deform);
+    void push(const Vec2Array& vertexOffsets);
 
 private:
     Deformable* owner_{};
@@ -81,6 +82,7 @@ public:
     void runPreProcessTask(core::RenderContext& ctx) override;
 
     void runPostTaskImpl(std::size_t priority, core::RenderContext& ctx) override;
+    bool describeTaskAccess(core::TaskOrder order, core::TaskAccess& access) const override;
 
     void notifyDeformPushed(const Vec2Array& deform);
     bool hasDeformPreProcessFilter(int stage, std::uintptr_t tag) const;
@@ -92,6 +94,27 @@ public:
 
 protected:
     virtual void onDeformPushed(const Vec2Array&) {}
+
+private:
+    // Inputs and result of the last call of a deform hook that has a source revision.
+    struct DeformHookMemo {
+        bool post{false};
+        int stage{0};
+        std::uintptr_t tag{0};
+        bool valid{false};
+        bool rewrites{false};
+        std::uint64_t revision{0};
+        Mat4 matrix{};
+        Vec2Array vertices{};
+        Vec2Array input{};
+        Vec2Array output{};
+        Node::DeformFilterResult result{};
+    };
+    std::vector<DeformHookMemo> deformHookMemos{};
+
+    // Runs `hook` on this node's deformation, or replays its memo when nothing it reads changed.
+    Node::DeformFilterResult runDeformHook(const Node::DeformFilterHook& hook, bool post, const Mat4& matrix);
+    void dropDeformHookMemo(bool post, int stage, std::uintptr_t tag);
 };
 
 bool areDeformationNodesCompatible(const std::shared_ptr<Node>& lhs, const std::shared_ptr<Node>& rhs);
@@ -94,35 +94,47 @@ bool calculateTransformInTriangle(const MeshData& mesh, const std::array<std::si
 } // namespace
 
 Drawable::Drawable() : Deformable() {
-    ::nicxlive::core::render::sharedDeformRegister(deformation, &deformOffset);
-    ::nicxlive::core::render::sharedVertexRegister(vertices, &vertexOffset);
-    ::nicxlive::core::render::sharedUvRegister(sharedUvs, &uvOffset);
+    sharedBuffers->deform.registerArray(deformation, &deformOffset);
+    sharedBuffers->vertex.registerArray(vertices, &vertexOffset);
+    sharedBuffers->uv.registerArray(sharedUvs, &uvOffset);
 }
 
 Drawable::Drawable(const std::shared_ptr<Node>& parent) : Deformable(parent) {
-    ::nicxlive::core::render::sharedDeformRegister(deformation, &deformOffset);
-    ::nicxlive::core::render::sharedVertexRegister(vertices, &vertexOffset);
-    ::nicxlive::core::render::sharedUvRegister(sharedUvs, &uvOffset);
+    sharedBuffers->deform.registerArray(deformation, &deformOffset);
+    sharedBuffers->vertex.registerArray(vertices, &vertexOffset);
+    sharedBuffers->uv.registerArray(sharedUvs, &uvOffset);
 }
 
 Drawable::Drawable(const MeshData& data, uint32_t uuidVal, const std::shared_ptr<Node>& parent)
     : Deformable(uuidVal, parent), mesh(std::make_shared<MeshData>(data)) {
-    ::nicxlive::core::render::sharedDeformRegister(deformation, &deformOffset);
-    ::nicxlive::core::render::sharedVertexRegister(vertices, &vertexOffset);
-    ::nicxlive::core::render::sharedUvRegister(sharedUvs, &uvOffset);
-    sharedUvResize(sharedUvs, mesh->uvs.size());
+    sharedBuffers->deform.registerArray(deformation, &deformOffset);
+    sharedBuffers->vertex.registerArray(vertices, &vertexOffset);
+    sharedBuffers->uv.registerArray(sharedUvs, &uvOffset);
+    sharedBuffers->uv.resizeArray(sharedUvs, mesh->uvs.size());
     for (std::size_t i = 0; i < mesh->uvs.size(); ++i) {
         sharedUvs.set(i, mesh->uvs[i]);
     }
-    sharedUvMarkDirty();
+    sharedBuffers->uv.markDirtyRange(uvOffset, sharedUvs.size());
     updateIndices();
     updateVertices();
 }
 
 Drawable::~Drawable() {
-    ::nicxlive::core::render::sharedDeformUnregister(deformation);
-    ::nicxlive::core::render::sharedVertexUnregister(vertices);
-    ::nicxlive::core::render::sharedUvUnregister(sharedUvs);
+    sharedBuffers->deform.unregisterArray(deformation);
+    sharedBuffers->vertex.unregisterArray(vertices);
+    sharedBuffers->uv.unregisterArray(sharedUvs);
+}
+
+void Drawable::moveSharedBuffers(const std::shared_ptr<::nicxlive::core::render::SharedBufferSet>& target) {
+    if (!target || target == sharedBuffers) return;
+    // Register first: the arrays still view the old storage, which registerArray copies from.
+    target->deform.registerArray(deformation, &deformOffset);
+    target->vertex.registerArray(vertices, &vertexOffset);
+    target->uv.registerArray(sharedUvs, &uvOffset);
+    sharedBuffers->deform.unregisterArray(deformation);
+    sharedBuffers->vertex.unregisterArray(vertices);
+    sharedBuffers->uv.unregisterArray(sharedUvs);
+    sharedBuffers = target;
 }
 
 void MeshData::add(const Vec2& vertex, const Vec2& uv) {
@@ -282,29 +294,19 @@ void MeshData::serialize(::nicxlive::core::serde::InochiSerializer& serializer)
     gridAxes.clear();
     origin = Vec2{0, 0};
 
-    if (auto verts = data.get_child_optional("verts")) {
-        for (auto it = verts->begin(); it != verts->end();) {
-            float x = it->second.get_value<float>();
-            ++it;
-            if (it == verts->end()) break;
-            float y = it->second.get_value<float>();
-            ++it;
-            vertices.push_back(Vec2{x, y});
-        }
-    }
-
-    if (auto u = data.get_child_optional("uvs")) {
-        for (auto it = u->begin(); it != u->end();) {
-            float x = it->second.get_value<float>();
-            ++it;
-            if (it == u->end()) break;
-            float y = it->second.get_value<float>();
-            ++it;
-            uvs.push_back(Vec2{x, y});
-        }
-    }
+    // Flat [x0, y0, x1, y1, ...] arrays; a trailing odd element is ignored.
+    thread_local std::vector<float> flat;
+    auto readPairs = [](const ::nicxlive::core::serde::Fghj& node, std::vector<Vec2>& out) {
+        flat.clear();
+        node.readFloats(flat);
+        out.reserve(flat.size() / 2);
+        for (std::size_t i = 0; i + 1 < flat.size(); i += 2) out.push_back(Vec2{flat[i], flat[i + 1]});
+    };
+    if (auto verts = data.get_child_optional("verts")) readPairs(*verts, vertices);
+    if (auto u = data.get_child_optional("uvs")) readPairs(*u, uvs);
 
     if (auto idx = data.get_child_optional("indices")) {
+        indices.reserve(idx->size());
         for (const auto& i : *idx) {
             indices.push_back(i.second.get_value<uint16_t>());
         }
@@ -322,9 +324,7 @@ void MeshData::serialize(::nicxlive::core::serde::InochiSerializer& serializer)
     if (auto ga = data.get_child_optional("grid_axes")) {
         for (const auto& axis : *ga) {
             std::vector<float> vals;
-            for (const auto& v : axis.second) {
-                vals.push_back(v.second.get_value<float>());
-            }
+            axis.second.readFloats(vals);
             gridAxes.push_back(std::move(vals));
         }
     }
@@ -415,6 +415,11 @@ void Drawable::drawMeshPoints() const {
 }
 MeshData& Drawable::getMesh() { return *mesh; }
 
+MeshData& Drawable::mutableMesh() {
+    if (mesh.use_count() > 1) mesh = std::make_shared<MeshData>(*mesh);
+    return *mesh;
+}
+
 void Drawable::updateIndices() {
     auto backend = core::getCurrentRenderBackend();
     if (!backend) return;
@@ -469,43 +474,45 @@ bool Drawable::updateAttachedNodeTransform(const std::shared_ptr<Node>& node) {
 }
 
 void Drawable::updateVertices() {
-    sharedVertexResize(vertices, mesh->vertices.size());
+    sharedBuffers->vertex.resizeArray(vertices, mesh->vertices.size());
     for (std::size_t i = 0; i < mesh->vertices.size(); ++i) {
         vertices.set(i, mesh->vertices[i]);
     }
-    sharedVertexMarkDirty();
+    sharedBuffers->vertex.markDirtyRange(vertexOffset, vertices.size());
 
+    // Resize the atlas slot before touching the view so the fill stays inside this drawable's slot.
+    sharedBuffers->deform.resizeArray(deformation, vertices.size());
     deformation.resize(vertices.size());
     deformation.fill(Vec2{0.0f, 0.0f});
     deformationOffsets.resize(vertices.size(), Vec2{});
-    sharedDeformResize(deformation, deformation.size());
-    sharedDeformMarkDirty();
+    sharedBuffers->deform.markDirtyRange(deformOffset, deformation.size());
     updateDeform();
 }
 
 void Drawable::rebufferMesh(const MeshData& data) {
-    sharedUvResize(sharedUvs, data.uvs.size());
+    sharedBuffers->uv.resizeArray(sharedUvs, data.uvs.size());
     for (std::size_t i = 0; i < data.uvs.size(); ++i) {
         sharedUvs.set(i, data.uvs[i]);
     }
-    sharedUvMarkDirty();
-    *mesh = data;
+    sharedBuffers->uv.markDirtyRange(uvOffset, sharedUvs.size());
+    mesh = std::make_shared<MeshData>(data);
     updateIndices();
     updateVertices();
 }
 
 void Drawable::updateDeform() {
     Deformable::updateDeform();
-    sharedDeformMarkDirty();
+    // Runs every frame for every drawable; only slots whose deformation actually moved get uploaded.
+    sharedBuffers->deform.markDirtyIfChanged(deformOffset, deformation.size());
     updateBounds();
 }
 
 void Drawable::reset() {
-    sharedVertexResize(vertices, mesh->vertices.size());
+    sharedBuffers->vertex.resizeArray(vertices, mesh->vertices.size());
     for (std::size_t i = 0; i < mesh->vertices.size(); ++i) {
         vertices.set(i, mesh->vertices[i]);
     }
-    sharedVertexMarkDirty();
+    sharedBuffers->vertex.markDirtyRange(vertexOffset, vertices.size());
 }
 
 bool Drawable::isWeldedBy(NodeId target) const {
@@ -591,7 +598,7 @@ Node::DeformFilterResult Drawable::weldingProcessor(const std::shared_ptr<Node>&
 
     scatterAddVec2(localSelf, selfIndices, deformation, changed);
     scatterAddVec2(localTarget, targetIndices, origDeformation, changed);
-    sharedDeformMarkDirty();
+    sharedBuffers->deform.markDirtyRange(deformOffset, deformation.size());
     Node::DeformFilterResult result;
     result.changed = changed;
     return result;
@@ -681,9 +688,9 @@ void Drawable::clearCache() {
     bounds.reset();
     weldingApplied.clear();
     attachedIndex.clear();
-    sharedVertexMarkDirty();
-    sharedUvMarkDirty();
-    sharedDeformMarkDirty();
+    sharedBuffers->vertex.markDirtyRange(vertexOffset, vertices.size());
+    sharedBuffers->uv.markDirtyRange(uvOffset, sharedUvs.size());
+    sharedBuffers->deform.markDirtyRange(deformOffset, deformation.size());
 }
 
 void Drawable::runBeginTask(core::RenderContext& ctx) {
@@ -718,7 +725,7 @@ void Drawable::normalizeUv() {
         uv.x += (0.5f - centerX);
         uv.y += (0.5f - centerY);
     }
-    sharedUvMarkDirty();
+    sharedBuffers->uv.markDirtyRange(uvOffset, sharedUvs.size());
 }
 
 void Drawable::centralizeDrawable() {
@@ -732,11 +739,12 @@ void Drawable::centralizeDrawable() {
 }
 
 void Drawable::copyFromDrawable(const Drawable& src) {
-    mesh->vertices = src.mesh->vertices;
-    mesh->uvs = src.mesh->uvs.empty() ? src.mesh->vertices : src.mesh->uvs;
-    mesh->indices = src.mesh->indices;
-    mesh->origin = src.mesh->origin;
-    mesh->gridAxes = src.mesh->gridAxes;
+    auto& target = mutableMesh();
+    target.vertices = src.mesh->vertices;
+    target.uvs = src.mesh->uvs.empty() ? src.mesh->vertices : src.mesh->uvs;
+    target.indices = src.mesh->indices;
+    target.origin = src.mesh->origin;
+    target.gridAxes = src.mesh->gridAxes;
     deformation = src.deformation;
     tint = src.tint;
     screenTint = src.screenTint;
@@ -747,11 +755,11 @@ void Drawable::copyFromDrawable(const Drawable& src) {
     weldedLinks = src.weldedLinks;
     weldingApplied = src.weldingApplied;
     vertexOffset = uvOffset = deformOffset = 0;
-    sharedUvResize(sharedUvs, mesh->uvs.size());
+    sharedBuffers->uv.resizeArray(sharedUvs, mesh->uvs.size());
     for (std::size_t i = 0; i < mesh->uvs.size(); ++i) {
         sharedUvs.set(i, mesh->uvs[i]);
     }
-    sharedUvMarkDirty();
+    sharedBuffers->uv.markDirtyRange(uvOffset, sharedUvs.size());
     updateVertices();
     updateIndices();
 }
@@ -859,9 +867,9 @@ void Drawable::fillDrawPacket(const Node& header, PartDrawPacket& packet, bool /
     packet.vertexOffset = vertexOffset;
     packet.uvOffset = uvOffset;
     packet.deformOffset = deformOffset;
-    packet.vertexAtlasStride = sharedVertexBufferData().size();
-    packet.uvAtlasStride = sharedUvBufferData().size();
-    packet.deformAtlasStride = sharedDeformBufferData().size();
+    packet.vertexAtlasStride = sharedBuffers->vertex.data().size();
+    packet.uvAtlasStride = sharedBuffers->uv.data().size();
+    packet.deformAtlasStride = sharedBuffers->deform.data().size();
     packet.vertexCount = static_cast<uint32_t>(mesh->vertices.size());
     packet.indexCount = static_cast<uint32_t>(mesh->indices.size());
     packet.indexBuffer = ibo;
@@ -937,7 +945,11 @@ void Drawable::serializeSelfImpl(::nicxlive::core::serde::InochiSerializer& seri
 ::nicxlive::core::serde::SerdeException Drawable::deserializeFromFghj(const ::nicxlive::core::serde::Fghj& data) {
     if (auto err = Node::deserializeFromFghj(data)) return err;
     if (auto m = data.get_child_optional("mesh")) {
-        if (auto exc = mesh->deserializeFromFghj(*m)) return exc;
+        if (auto shared = ::nicxlive::core::resolveInstanceTemplateMesh(uuid, typeId())) {
+            mesh = std::move(shared);
+        } else if (auto exc = mesh->deserializeFromFghj(*m)) {
+            return exc;
+        }
         vertices.resize(mesh->vertices.size());
         for (std::size_t i = 0; i < mesh->vertices.size(); ++i) {
             vertices.set(i, mesh->vertices[i]);
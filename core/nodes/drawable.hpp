@@ -65,7 +65,11 @@ struct WeldingLink {
 
 class Drawable : public Deformable {
 public:
+    // May be shared with other instances of the same puppet (fmt::inInstantiatePuppet): replace it
+    // or write through mutableMesh(), never modify it in place.
     std::shared_ptr<MeshData> mesh{std::make_shared<MeshData>()};
+    // Atlas set this drawable's deformation/vertices/UVs live in (captured at construction).
+    std::shared_ptr<::nicxlive::core::render::SharedBufferSet> sharedBuffers{::nicxlive::core::render::currentSharedBufferSet()};
     Vec2Array sharedUvs{};
     std::vector<Vec2> deformationOffsets{};
     std::size_t vertexOffset{0};
@@ -89,6 +93,10 @@ public:
     Drawable(const MeshData& data, uint32_t uuidVal = 0, const std::shared_ptr<Node>& parent = nullptr);
     ~Drawable() override;
 
+    // Re-registers deformation/vertices/UVs in another atlas set, keeping their contents. Used to
+    // hand a puppet loaded off-thread into a private set over to its renderer's set.
+    void moveSharedBuffers(const std::shared_ptr<::nicxlive::core::render::SharedBufferSet>& target);
+
     virtual void updateIndices();
 
     virtual void updateVertices() override;
@@ -99,6 +107,8 @@ public:
     virtual void drawMeshLines() const;
     virtual void drawMeshPoints() const;
     virtual MeshData& getMesh();
+    // The mesh for writing: detaches a private copy first if it is shared.
+    MeshData& mutableMesh();
 
     virtual std::tuple<Vec2Array, Mat4*, bool> nodeAttachProcessor(const std::shared_ptr<Node>& node,
                                                                     const Vec2Array& origVertices,
@@ -17,6 +17,8 @@ public:
     virtual void reset() = 0;
 
     void runBeginTask(core::RenderContext& ctx) override { Node::runBeginTask(ctx); }
+    // Drivers write the parameters they drive.
+    bool describeTaskAccess(core::TaskOrder, core::TaskAccess&) const override { return false; }
 
     const std::string& typeId() const override {
         static const std::string k = "Driver";
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cmath>
+#include <cstring>
 #include <functional>
 #include <limits>
 #include <unordered_map>
@@ -60,10 +61,12 @@ void GridDeformer::setGridAxes(const std::vector<float>& xs, const std::vector<f
             deformation.set(idx, Vec2{0.0f, 0.0f});
         }
     }
+    ++filterRevision;
 }
 
 void GridDeformer::switchDynamic(bool value) {
     dynamic = value;
+    ++filterRevision;
     for (auto& c : childrenRef()) {
         setupChildNoRecurse(c);
     }
@@ -264,8 +267,18 @@ void GridDeformer::runPreProcessTask(core::RenderContext& ctx) {
     Deformable::runPreProcessTask(ctx);
     localTransform.update();
     transform();
-    inverseMatrix = globalTransform.toMat4().inverse();
+    const Mat4 inverse = globalTransform.toMat4().inverse();
+    bool moved = std::memcmp(&inverse, &inverseMatrix, sizeof(Mat4)) != 0;
+    inverseMatrix = inverse;
     updateDeform();
+    const std::size_t n = deformation.size();
+    if (n != filterDeformation.size() ||
+        (n && (std::memcmp(deformation.dataX(), filterDeformation.dataX(), n * sizeof(float)) != 0 ||
+               std::memcmp(deformation.dataY(), filterDeformation.dataY(), n * sizeof(float)) != 0))) {
+        filterDeformation = deformation;
+        moved = true;
+    }
+    if (moved) ++filterRevision;
 }
 
 void GridDeformer::runRenderTask(core::RenderContext&) {
@@ -337,6 +350,10 @@ void GridDeformer::setupChildNoRecurse(const std::shared_ptr<Node>& node, bool p
         Node::DeformFilterHook deformHook;
         deformHook.stage = kGridFilterStage;
         deformHook.tag = tag;
+        deformHook.source = this;
+        // Post-stage (dynamic) calls may see grid offsets written after runPreProcessTask
+        // compared them, and a path deformer's physics flag also decides what the filter does.
+        if (!dynamic && !std::dynamic_pointer_cast<PathDeformer>(node)) deformHook.revision = &filterRevision;
         deformHook.func = [this](std::shared_ptr<Node> t,
                                  const Vec2Array& v,
                                  Vec2Array& d,
@@ -352,6 +369,7 @@ void GridDeformer::setupChildNoRecurse(const std::shared_ptr<Node>& node, bool p
         Node::FilterHook hook;
         hook.stage = kGridFilterStage;
         hook.tag = tag;
+        hook.source = this;
         hook.func = [this](std::shared_ptr<Node> t,
                            const Vec2Array& v,
                            Vec2Array d,
@@ -428,15 +446,11 @@ void GridDeformer::serializeSelfImpl(::nicxlive::core::serde::InochiSerializer&
 
     if (auto xs = data.get_child_optional("grid_axis_x")) {
         axisX.clear();
-        for (const auto& elem : *xs) {
-            axisX.push_back(elem.second.get_value<float>());
-        }
+        xs->readFloats(axisX);
     }
     if (auto ys = data.get_child_optional("grid_axis_y")) {
         axisY.clear();
-        for (const auto& elem : *ys) {
-            axisY.push_back(elem.second.get_value<float>());
-        }
+        ys->readFloats(axisY);
     }
     if (auto fmText = data.get_optional<std::string>("formation")) {
         std::string normalized;
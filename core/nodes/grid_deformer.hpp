@@ -37,7 +37,10 @@ public:
     }
 
     GridFormation gridFormation() const { return formation; }
-    void setGridFormation(GridFormation f) { formation = f; }
+    void setGridFormation(GridFormation f) {
+        formation = f;
+        ++filterRevision;
+    }
 
     // Deformer
     DeformResult deformChildren(const std::shared_ptr<Node>& target,
@@ -71,6 +74,11 @@ public:
     ::nicxlive::core::serde::SerdeException deserializeFromFghj(const ::nicxlive::core::serde::Fghj& data) override;
 
 private:
+    // Revision of what deformChildren reads (axes, offsets, inverseMatrix, mode), and the offsets it
+    // was last bumped for; the targets' deform hooks replay their last result while it holds.
+    std::uint64_t filterRevision{0};
+    Vec2Array filterDeformation{};
+
     void setupChildNoRecurse(const std::shared_ptr<Node>& node, bool prepend = false);
     void releaseChildNoRecurse(const std::shared_ptr<Node>& node);
     struct GridCellCache {
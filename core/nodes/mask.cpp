@@ -63,9 +63,9 @@ void Mask::fillMaskDrawPacket(::nicxlive::core::nodes::MaskDrawPacket& packet) c
 
     packet.origin = mesh->origin;
     packet.vertexOffset = vertexOffset;
-    packet.vertexAtlasStride = sharedVertexBufferData().size();
+    packet.vertexAtlasStride = sharedBuffers->vertex.data().size();
     packet.deformOffset = deformOffset;
-    packet.deformAtlasStride = sharedDeformBufferData().size();
+    packet.deformAtlasStride = sharedBuffers->deform.data().size();
     packet.indexBuffer = ibo;
     packet.indexCount = static_cast<uint32_t>(mesh->indices.size());
     packet.vertexCount = static_cast<uint32_t>(mesh->vertices.size());
@@ -12,6 +12,7 @@
 #include <cstdio>
 #include <cstring>
 #include <limits>
+#include <mutex>
 #include <unordered_map>
 
 namespace nicxlive::core::nodes {
@@ -50,40 +51,30 @@ bool invertMat3(const Mat3& in, Mat3& out) {
     return true;
 }
 
+// Flags are read once; the static initializers are thread-safe, and filterChildren runs from
+// parallel node tasks.
+bool envFlagEnabled(const char* name) {
+    const char* v = std::getenv(name);
+    if (!v) return false;
+    return std::strcmp(v, "1") == 0 || std::strcmp(v, "true") == 0 || std::strcmp(v, "TRUE") == 0;
+}
+
 bool traceMeshGroupChainEnabled() {
-    static int enabled = -1;
-    if (enabled >= 0) return enabled != 0;
-    const char* v = std::getenv("NJCX_TRACE_MESHGROUP_CHAIN");
-    if (!v) {
-        enabled = 0;
-        return false;
-    }
-    enabled = (std::strcmp(v, "1") == 0 || std::strcmp(v, "true") == 0 || std::strcmp(v, "TRUE") == 0) ? 1 : 0;
-    return enabled != 0;
+    static const bool enabled = envFlagEnabled("NJCX_TRACE_MESHGROUP_CHAIN");
+    return enabled;
 }
 
 bool traceMeshGroupEffectEnabled() {
-    static int enabled = -1;
-    if (enabled >= 0) return enabled != 0;
-    const char* v = std::getenv("NJCX_TRACE_MESHGROUP_EFFECT");
-    if (!v) {
-        enabled = 0;
-        return false;
-    }
-    enabled = (std::strcmp(v, "1") == 0 || std::strcmp(v, "true") == 0 || std::strcmp(v, "TRUE") == 0) ? 1 : 0;
-    return enabled != 0;
+    static const bool enabled = envFlagEnabled("NJCX_TRACE_MESHGROUP_EFFECT");
+    return enabled;
 }
 
 const char* meshGroupTargetTraceName() {
-    static const char* cached = nullptr;
-    static bool init = false;
-    if (!init) {
-        cached = std::getenv("NJCX_TRACE_MESHGROUP_TARGET");
-        init = true;
-    }
+    static const char* const cached = std::getenv("NJCX_TRACE_MESHGROUP_TARGET");
     return cached;
 }
 
+std::mutex gMeshGroupFilterCallMutex;
 std::unordered_map<const MeshGroup*, std::size_t> gMeshGroupFilterCallCount;
 } // namespace
 
@@ -139,10 +130,11 @@ void MeshGroup::applyDeformToChildren(const std::vector<std::shared_ptr<core::pa
         recursive);
 
     // After deform transfer, clear own mesh and disable translateChildren like D 実装
-    *mesh = MeshData{};
+    mesh = std::make_shared<MeshData>();
     rebuffer(*mesh);
     translateChildren = false;
     precalculated = false;
+    ++filterRevision;
 }
 
 void MeshGroup::addChild(const std::shared_ptr<Node>& child) {
@@ -169,10 +161,12 @@ void MeshGroup::runPreProcessTask(core::RenderContext& ctx) {
     auto scope = core::render::profileScope("MeshGroup.runPreProcessTask");
     Drawable::runPreProcessTask(ctx);
     if (traceMeshGroupChainEnabled()) {
+        std::lock_guard<std::mutex> lock(gMeshGroupFilterCallMutex);
         gMeshGroupFilterCallCount[this] = 0;
     }
     if (mesh->indices.empty()) return;
     if (!precalculated) precalculate();
+    bool filterInputsMoved = false;
     // update transformedVertices and triangle matrices
     transformedVertices = vertices;
     transformedVertices += deformation;
@@ -202,10 +196,19 @@ void MeshGroup::runPreProcessTask(core::RenderContext& ctx) {
         mat[0][0] = p2.x - p1.x; mat[0][1] = p3.x - p1.x; mat[0][2] = p1.x;
         mat[1][0] = p2.y - p1.y; mat[1][1] = p3.y - p1.y; mat[1][2] = p1.y;
         mat[2][0] = 0; mat[2][1] = 0; mat[2][2] = 1;
-        triangles[tri].transformMatrix = mat * triangles[tri].offsetMatrices;
+        const Mat3 next = mat * triangles[tri].offsetMatrices;
+        if (std::memcmp(&next, &triangles[tri].transformMatrix, sizeof(Mat3)) != 0) {
+            triangles[tri].transformMatrix = next;
+            filterInputsMoved = true;
+        }
     }
     forwardMatrix = transform().toMat4();
-    inverseMatrix = globalTransform.toMat4().inverse();
+    const Mat4 inverse = globalTransform.toMat4().inverse();
+    if (std::memcmp(&inverse, &inverseMatrix, sizeof(Mat4)) != 0) {
+        inverseMatrix = inverse;
+        filterInputsMoved = true;
+    }
+    if (filterInputsMoved) ++filterRevision;
 
     if (traceMeshGroupChainEnabled()) {
         std::size_t taggedPre = 0;
@@ -234,7 +237,11 @@ void MeshGroup::runPreProcessTask(core::RenderContext& ctx) {
         for (auto& c : children) {
             walk(c, walk);
         }
-        const auto calls = gMeshGroupFilterCallCount[this];
+        std::size_t calls = 0;
+        {
+            std::lock_guard<std::mutex> lock(gMeshGroupFilterCallMutex);
+            calls = gMeshGroupFilterCallCount[this];
+        }
         NJCX_DBG_LOG("[nicxlive][MeshGroup][Chain] node=%s uuid=%u visited=%zu taggedNodes=%zu hooks(pre=%zu post=%zu) filterCalls=%zu dynamic=%d translateChildren=%d\n",
                      name.c_str(),
                      uuid,
@@ -267,6 +274,7 @@ void MeshGroup::rebuffer(const MeshData& data) {
     Drawable::rebufferMesh(data);
     if (dynamic) {
         precalculated = false;
+        ++filterRevision;
     }
 }
 
@@ -274,6 +282,7 @@ void MeshGroup::switchMode(bool dyn) {
     if (dynamic != dyn) {
         dynamic = dyn;
         precalculated = false;
+        ++filterRevision;
     }
 }
 
@@ -291,6 +300,7 @@ Node::DeformFilterResult MeshGroup::filterChildren(const std::shared_ptr<Node>&
                                                    const Mat4* origTransform) {
     auto scope = core::render::profileScope("MeshGroup.filterChildren");
     if (traceMeshGroupChainEnabled()) {
+        std::lock_guard<std::mutex> lock(gMeshGroupFilterCallMutex);
         ++gMeshGroupFilterCallCount[this];
     }
     if (!precalculated || !origTransform) return {};
@@ -328,7 +338,7 @@ Node::DeformFilterResult MeshGroup::filterChildren(const std::shared_ptr<Node>&
         float vy = centered.yAt(i);
         float outX = vx, outY = vy;
         if (vx >= minX && vx < maxX && vy >= minY && vy < maxY &&
-            maskWidth && maskHeight && !bitMask.empty()) {
+            maskWidth && maskHeight && bitMask && !bitMask->empty()) {
             ++inBoundsCount;
             auto localX = static_cast<std::ptrdiff_t>(std::floor(vx - minX));
             auto localY = static_cast<std::ptrdiff_t>(std::floor(vy - minY));
@@ -337,8 +347,8 @@ Node::DeformFilterResult MeshGroup::filterChildren(const std::shared_ptr<Node>&
                 std::size_t maskY = static_cast<std::size_t>(localY);
                 if (maskX < maskWidth && maskY < maskHeight) {
                     std::size_t maskIndex = maskY * maskWidth + maskX;
-                    if (maskIndex < bitMask.size()) {
-                        uint16_t bit = bitMask[maskIndex];
+                    if (maskIndex < bitMask->size()) {
+                        uint16_t bit = (*bitMask)[maskIndex];
                         int triIndex = bit ? (bit - 1) : -1;
                         if (triIndex >= 0 && static_cast<std::size_t>(triIndex) < triangles.size()) {
                             ++triHitCount;
@@ -370,7 +380,7 @@ Node::DeformFilterResult MeshGroup::filterChildren(const std::shared_ptr<Node>&
                      maxLocalDelta,
                      precalculated ? 1 : 0,
                      triangles.size(),
-                     bitMask.size());
+                     bitMask ? bitMask->size() : std::size_t{0});
         if (traceThisTarget && centered.size() > 0) {
             NJCX_DBG_LOG("[nicxlive][MeshGroup][Target] group=%s target=%s centerM=[%.6f %.6f %.6f %.6f | %.6f %.6f %.6f %.6f | %.6f %.6f %.6f %.6f | %.6f %.6f %.6f %.6f] inM=[%.6f %.6f %.6f %.6f]\n",
                          name.c_str(),
@@ -406,10 +416,37 @@ Node::DeformFilterResult MeshGroup::filterChildren(const std::shared_ptr<Node>&
     return result;
 }
 
+bool MeshGroup::adoptPrecalculation(const Vec4& cachedBounds, std::vector<TriangleMapping> cachedTriangles,
+                                    std::shared_ptr<const std::vector<uint16_t>> cachedBitMask) {
+    if (mesh->indices.empty() || cachedTriangles.size() != mesh->indices.size() / 3) return false;
+    const int width = static_cast<int>(std::ceil(cachedBounds.z) - std::floor(cachedBounds.x) + 1);
+    const int height = static_cast<int>(std::ceil(cachedBounds.w) - std::floor(cachedBounds.y) + 1);
+    if (width <= 0 || height <= 0 || !cachedBitMask ||
+        cachedBitMask->size() != static_cast<std::size_t>(width) * static_cast<std::size_t>(height)) {
+        return false;
+    }
+    bounds = cachedBounds;
+    triangles = std::move(cachedTriangles);
+    bitMask = std::move(cachedBitMask);
+    precalculated = true;
+    adoptedPrecalculation = true;
+    ++filterRevision;
+    return true;
+}
+
 void MeshGroup::precalculate() {
+    ++filterRevision;
+    if (adoptedPrecalculation && precalculated) {
+        adoptedPrecalculation = false;
+        for (auto& child : children) {
+            setupChild(child);
+        }
+        return;
+    }
+    adoptedPrecalculation = false;
     if (mesh->indices.empty()) {
         triangles.clear();
-        bitMask.clear();
+        bitMask.reset();
         precalculated = false;
         return;
     }
@@ -465,7 +502,7 @@ void MeshGroup::precalculate() {
 
     int width = static_cast<int>(std::ceil(bounds.z) - std::floor(bounds.x) + 1);
     int height = static_cast<int>(std::ceil(bounds.w) - std::floor(bounds.y) + 1);
-    bitMask.assign(static_cast<std::size_t>(width * height), 0);
+    std::vector<uint16_t> mask(static_cast<std::size_t>(width * height), 0);
 
     for (std::size_t idx = 0; idx < triangles.size(); ++idx) {
         auto i0 = mesh->indices[idx * 3];
@@ -487,12 +524,13 @@ void MeshGroup::precalculate() {
                     pt.y -= bounds.y;
                     std::size_t maskIndex = static_cast<std::size_t>(pt.y) * static_cast<std::size_t>(width) +
                                              static_cast<std::size_t>(pt.x);
-                    if (maskIndex < bitMask.size()) bitMask[maskIndex] = static_cast<uint16_t>(idx + 1);
+                    if (maskIndex < mask.size()) mask[maskIndex] = static_cast<uint16_t>(idx + 1);
                 }
             }
         }
     }
 
+    bitMask = std::make_shared<const std::vector<uint16_t>>(std::move(mask));
     precalculated = true;
     for (auto& child : children) {
         setupChild(child);
@@ -534,8 +572,9 @@ void MeshGroup::setupSelf() {
 }
 
 void MeshGroup::clearCache() {
+    ++filterRevision;
     precalculated = false;
-    bitMask.clear();
+    bitMask.reset();
     triangles.clear();
 }
 
@@ -677,6 +716,9 @@ void MeshGroup::setupChildNoRecurse(const std::shared_ptr<Node>& node, bool prep
             Node::DeformFilterHook hook{};
             hook.stage = kMeshGroupFilterStage;
             hook.tag = tag;
+            hook.source = this;
+            // A path deformer's physics flag also decides what the filter does.
+            if (!std::dynamic_pointer_cast<PathDeformer>(node)) hook.revision = &filterRevision;
             hook.func = [this](std::shared_ptr<Node> t,
                                const Vec2Array& verts,
                                Vec2Array& def,
@@ -693,6 +735,7 @@ void MeshGroup::setupChildNoRecurse(const std::shared_ptr<Node>& node, bool prep
         Node::FilterHook hook{};
         hook.stage = kMeshGroupFilterStage;
         hook.tag = tag;
+        hook.source = this;
         hook.func = [this](std::shared_ptr<Node> t,
                            const Vec2Array& verts,
                            Vec2Array def,
@@ -39,7 +39,8 @@ public:
     std::vector<NodeId> members{};
 
     // D相当のフィールド
-    std::vector<uint16_t> bitMask{};
+    // Triangle index + 1 per pixel of `bounds`; immutable once built and shared by puppet instances.
+    std::shared_ptr<const std::vector<uint16_t>> bitMask{};
     Vec4 bounds{};
     std::vector<TriangleMapping> triangles{};
     Vec2Array transformedVertices{};
@@ -77,6 +78,11 @@ public:
     void rebuffer(const MeshData& data);
     void switchMode(bool dynamic);
     void setTranslateChildren(bool value);
+    // Takes a precalculation made for the current mesh elsewhere (a puppet cache): the next
+    // precalculate(), such as the one a forced build runs, keeps it instead of rasterizing the
+    // mask again. False (and nothing adopted) if it does not fit the mesh.
+    bool adoptPrecalculation(const Vec4& bounds, std::vector<TriangleMapping> triangles,
+                             std::shared_ptr<const std::vector<uint16_t>> bitMask);
 
     void serializeSelfImpl(::nicxlive::core::serde::InochiSerializer& serializer, bool recursive, SerializeNodeFlags flags) const override;
     ::nicxlive::core::serde::SerdeException deserializeFromFghj(const ::nicxlive::core::serde::Fghj& data) override;
@@ -92,6 +98,11 @@ public:
     bool mustPropagate() const override { return false; }
 
 private:
+    bool adoptedPrecalculation{false};
+    // Revision of what filterChildren reads (triangles, bounds, mask, inverseMatrix, mode); the
+    // targets' deform hooks replay their last result while it holds.
+    std::uint64_t filterRevision{0};
+
     void precalculate();
     void setupChildNoRecurse(const std::shared_ptr<Node>& node, bool prepend = false);
     void releaseChildNoRecurse(const std::shared_ptr<Node>& node);
@@ -18,13 +18,17 @@
 #include <cmath>
 #include <cstdio>
 #include <limits>
+#include <mutex>
 #include <random>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace nicxlive::core::nodes {
 
 namespace {
-std::vector<uint32_t> g_takenUUIDs{};
+// Loads may run on several threads; the registry is shared by all of them.
+std::mutex g_takenUUIDsMutex;
+std::unordered_set<uint32_t> g_takenUUIDs{};
 constexpr uint32_t kInvalidUUID = std::numeric_limits<uint32_t>::max();
 std::mt19937& uuidRng() {
     static std::mt19937 rng{std::random_device{}()};
@@ -54,6 +58,12 @@ void registerDefaultNodes() {
     Node::inRegisterNodeType("SimplePhysics", [] { return std::make_shared<SimplePhysicsDriver>(); });
 }
 
+// Striped locks guarding the refresh of the lazy transform cache, keyed by node address.
+std::mutex& transformCacheLock(const Node* node) {
+    static std::array<std::mutex, 64> locks{};
+    return locks[(reinterpret_cast<std::uintptr_t>(node) >> 4) % locks.size()];
+}
+
 } // namespace
 
 // Debug line storage (for drawOrientation / drawBounds parity)
@@ -281,35 +291,40 @@ void Node::postProcess(int id) {
 }
 
 Transform Node::transform() {
-    if (recalcTransform) {
-        localTransform.update();
-        offsetTransform.update();
-        Transform combined = localTransform.calcOffset(offsetTransform);
-        if (lockToRoot) {
-            Transform trans{Vec3{0.0f, 0.0f, 0.0f}};
-            if (auto pup = puppetRef()) {
-                if (auto root = pup->root) {
-                    trans = root->localTransform;
-                }
+    if (!recalcTransform.load(std::memory_order_acquire)) return globalTransform;
+    // The parent (or root) is resolved before this node's lock is taken, so a thread never holds two
+    // cache locks; concurrent refreshes of one node compute the same value and the first one wins.
+    std::optional<Transform> base{};
+    if (lockToRoot) {
+        base = Transform{Vec3{0.0f, 0.0f, 0.0f}};
+        if (auto pup = puppetRef()) {
+            if (auto root = pup->root) {
+                std::lock_guard<std::mutex> rootLock(transformCacheLock(root.get()));
+                base = root->localTransform;
             }
-            combined = combined * trans;
-        } else if (auto p = parent.lock()) {
-            combined = combined * p->transform();
         }
-        globalTransform = combined;
-        // Prefer explicit override matrix for dynamic matrix consumers.
-        if (overrideTransformMatrix) {
-            cachedWorld = *overrideTransformMatrix;
-        } else {
-            // Apply one-time transform only to cached world matrix.
-            Mat4 mat = combined.toMat4();
-            if (oneTimeTransformPtr) {
-                mat = Mat4::multiply(mat, *oneTimeTransformPtr);
-            }
-            cachedWorld = mat;
+    } else if (auto p = parent.lock()) {
+        base = p->transform();
+    }
+    std::lock_guard<std::mutex> lock(transformCacheLock(this));
+    if (!recalcTransform.load(std::memory_order_relaxed)) return globalTransform;
+    localTransform.update();
+    offsetTransform.update();
+    Transform combined = localTransform.calcOffset(offsetTransform);
+    if (base) combined = combined * *base;
+    globalTransform = combined;
+    // Prefer explicit override matrix for dynamic matrix consumers.
+    if (overrideTransformMatrix) {
+        cachedWorld = *overrideTransformMatrix;
+    } else {
+        // Apply one-time transform only to cached world matrix.
+        Mat4 mat = combined.toMat4();
+        if (oneTimeTransformPtr) {
+            mat = Mat4::multiply(mat, *oneTimeTransformPtr);
         }
-        recalcTransform = false;
+        cachedWorld = mat;
     }
+    recalcTransform.store(false, std::memory_order_release);
     return globalTransform;
 }
 
@@ -396,9 +411,12 @@ int Node::depth() const {
 
 void Node::insertInto(const std::shared_ptr<Node>& node, std::size_t offset) {
     nodePathCache.clear();
-    if (auto p = parent.lock()) {
-        auto& siblings = p->children;
+    auto oldParent = parent.lock();
+    if (oldParent) {
+        auto& siblings = oldParent->children;
         siblings.erase(std::remove(siblings.begin(), siblings.end(), shared_from_this()), siblings.end());
+        // Only the two parents' subtrees need their tasks re-registered.
+        if (auto pup = oldParent->puppetRef()) pup->recordSubtreeChange(oldParent);
     }
 
     if (!node) {
@@ -417,6 +435,7 @@ void Node::insertInto(const std::shared_ptr<Node>& node, std::size_t offset) {
     }
     if (auto pup = puppetRef()) {
         pup->rescanNodes();
+        pup->recordSubtreeChange(node);
     }
 }
 
@@ -578,7 +597,7 @@ void Node::finalize() {
 }
 
 void Node::transformChanged() {
-    recalcTransform = true;
+    recalcTransform.store(true, std::memory_order_relaxed);
     for (auto& child : children) {
         if (child) child->transformChanged();
     }
@@ -667,7 +686,7 @@ void Node::runRenderBeginTask(core::RenderContext&) {}
 void Node::runRenderEndTask(core::RenderContext&) {}
 
 void Node::registerRenderTasks(core::TaskScheduler& scheduler) {
-    scheduler.addTask(core::TaskOrder::Init, core::TaskKind::Init, [this](core::RenderContext& ctx) { runBeginTask(ctx); });
+    scheduler.addNodeTask(core::TaskOrder::Init, core::TaskKind::Init, this);
 
     auto hasFlag = [&](NodeTaskFlag flag) { return has_flag(taskFlags, flag); };
     bool needPreProcess = (!preProcessFilters.empty()) || hasFlag(NodeTaskFlag::PreProcess);
@@ -686,17 +705,17 @@ void Node::registerRenderTasks(core::TaskScheduler& scheduler) {
     bool needRenderEnd = hasFlag(NodeTaskFlag::RenderEnd);
 
     if (needPreProcess) {
-        scheduler.addTask(core::TaskOrder::PreProcess, core::TaskKind::PreProcess, [this](core::RenderContext& ctx) { runPreProcessTask(ctx); });
+        scheduler.addNodeTask(core::TaskOrder::PreProcess, core::TaskKind::PreProcess, this);
     }
     if (needDynamic) {
-        scheduler.addTask(core::TaskOrder::Dynamic, core::TaskKind::Dynamic, [this](core::RenderContext& ctx) { runDynamicTask(ctx); });
+        scheduler.addNodeTask(core::TaskOrder::Dynamic, core::TaskKind::Dynamic, this);
     }
-    if (needPost[0]) scheduler.addTask(core::TaskOrder::Post0, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(0, ctx); });
-    if (needPost[1]) scheduler.addTask(core::TaskOrder::Post1, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(1, ctx); });
-    if (needPost[2]) scheduler.addTask(core::TaskOrder::Post2, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(2, ctx); });
-    if (needRenderBegin) scheduler.addTask(core::TaskOrder::RenderBegin, core::TaskKind::Render, [this](core::RenderContext& ctx) { runRenderBeginTask(ctx); });
-    if (needRender) scheduler.addTask(core::TaskOrder::Render, core::TaskKind::Render, [this](core::RenderContext& ctx) { runRenderTask(ctx); });
-    scheduler.addTask(core::TaskOrder::Final, core::TaskKind::Finalize, [this](core::RenderContext& ctx) { runFinalTask(ctx); });
+    if (needPost[0]) scheduler.addNodeTask(core::TaskOrder::Post0, core::TaskKind::PostProcess, this);
+    if (needPost[1]) scheduler.addNodeTask(core::TaskOrder::Post1, core::TaskKind::PostProcess, this);
+    if (needPost[2]) scheduler.addNodeTask(core::TaskOrder::Post2, core::TaskKind::PostProcess, this);
+    if (needRenderBegin) scheduler.addNodeTask(core::TaskOrder::RenderBegin, core::TaskKind::Render, this);
+    if (needRender) scheduler.addNodeTask(core::TaskOrder::Render, core::TaskKind::Render, this);
+    scheduler.addNodeTask(core::TaskOrder::Final, core::TaskKind::Finalize, this);
 
     auto orderedChildren = children;
     std::sort(orderedChildren.begin(), orderedChildren.end(), [](const std::shared_ptr<Node>& a, const std::shared_ptr<Node>& b) {
@@ -706,9 +725,43 @@ void Node::registerRenderTasks(core::TaskScheduler& scheduler) {
         return a->zSort() > b->zSort();
     });
     for (auto& child : orderedChildren) {
-        if (child) child->registerRenderTasks(scheduler);
+        if (child) scheduler.addSubtree(child.get());
+    }
+    if (needRenderEnd) scheduler.addNodeTask(core::TaskOrder::RenderEnd, core::TaskKind::Render, this);
+}
+
+bool Node::describeTaskAccess(core::TaskOrder order, core::TaskAccess& access) const {
+    switch (order) {
+    case core::TaskOrder::PreProcess:
+    case core::TaskOrder::Dynamic:
+    case core::TaskOrder::Post0:
+    case core::TaskOrder::Post1:
+    case core::TaskOrder::Post2:
+        break;
+    default:
+        return false;
+    }
+    // Filter hooks are installed by other nodes (deformers, weld partners) and read them.
+    for (const auto* hooks : {&preProcessFilters, &postProcessFilters}) {
+        for (const auto& hook : *hooks) {
+            if (!describeFilterAccess(hook.source, hook.state, access)) return false;
+        }
+    }
+    access.writes.push_back(this);
+    for (auto p = parent.lock(); p; p = p->parent.lock()) {
+        access.reads.push_back(p.get());
     }
-    if (needRenderEnd) scheduler.addTask(core::TaskOrder::RenderEnd, core::TaskKind::Render, [this](core::RenderContext& ctx) { runRenderEndTask(ctx); });
+    if (lockToRoot) {
+        if (auto pup = puppetRef()) access.reads.push_back(pup->root.get());
+    }
+    return true;
+}
+
+bool Node::describeFilterAccess(const Node* source, const void* state, core::TaskAccess& access) {
+    if (!source) return false;
+    access.reads.push_back(source);
+    if (state) access.writes.push_back(state);
+    return true;
 }
 
 RenderScopeHint Node::determineRenderScopeHint() {
@@ -997,22 +1050,21 @@ bool Node::mustPropagate() const {
 
 uint32_t Node::inCreateUUID() {
     std::uniform_int_distribution<uint32_t> dist(std::numeric_limits<uint32_t>::min(), kInvalidUUID - 1);
+    std::lock_guard<std::mutex> lock(g_takenUUIDsMutex);
     uint32_t id = dist(uuidRng());
-    while (std::find(g_takenUUIDs.begin(), g_takenUUIDs.end(), id) != g_takenUUIDs.end()) {
+    while (!g_takenUUIDs.insert(id).second) {
         id = dist(uuidRng());
     }
-    g_takenUUIDs.push_back(id);
     return id;
 }
 
 void Node::inUnloadUUID(uint32_t id) {
-    auto it = std::find(g_takenUUIDs.begin(), g_takenUUIDs.end(), id);
-    if (it != g_takenUUIDs.end()) {
-        g_takenUUIDs.erase(it);
-    }
+    std::lock_guard<std::mutex> lock(g_takenUUIDsMutex);
+    g_takenUUIDs.erase(id);
 }
 
 void Node::inClearUUIDs() {
+    std::lock_guard<std::mutex> lock(g_takenUUIDsMutex);
     g_takenUUIDs.clear();
 }
 
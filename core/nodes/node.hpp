@@ -3,8 +3,11 @@
 #include "common.hpp"
 #include "../serde.hpp"
 #include "../render/render_pass.hpp"
+#include "../render/scheduler.hpp"
 
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -15,10 +18,7 @@
 
 namespace nicxlive::core {
 class Puppet;
-class TaskScheduler;
 class RenderContext;
-enum class TaskOrder;
-enum class TaskKind;
 } // namespace nicxlive::core
 
 namespace nicxlive::core::nodes {
@@ -82,7 +82,7 @@ class Drawable;
 
 using RenderScopeHint = ::nicxlive::core::RenderScopeHint;
 
-class Node : public std::enable_shared_from_this<Node> {
+class Node : public std::enable_shared_from_this<Node>, public core::TaskAccessProvider {
 public:
     struct FilterHook {
         int stage{0};
@@ -90,6 +90,12 @@ public:
         using Func = std::function<std::tuple<Vec2Array, Mat4*, bool>(
             std::shared_ptr<Node>, const Vec2Array&, Vec2Array, const Mat4*)>;
         Func func{};
+        // Node that installed the hook; the target's tasks run after its tasks. Null (unknown)
+        // keeps the target's tasks out of parallel waves.
+        const Node* source{nullptr};
+        // State every call writes besides the target (scratch buffers, caches); calls sharing it
+        // run one at a time.
+        const void* state{nullptr};
     };
     struct DeformFilterResult {
         std::optional<Mat4> transform{};
@@ -101,6 +107,13 @@ public:
         using Func = std::function<DeformFilterResult(
             std::shared_ptr<Node>, const Vec2Array&, Vec2Array&, const Mat4*)>;
         Func func{};
+        // See FilterHook.
+        const Node* source{nullptr};
+        const void* state{nullptr};
+        // Bumped by the source whenever anything the hook reads from it changes. When set, a call
+        // whose target inputs (vertices, deformation, matrix) also match the last one reuses its
+        // result instead of running.
+        const std::uint64_t* revision{nullptr};
     };
 
     uint32_t uuid{0};
@@ -128,7 +141,9 @@ public:
     std::vector<std::shared_ptr<Node>> children{};
 
     Mat4 cachedWorld{Mat4::identity()};
-    bool recalcTransform{true};
+    // Set by transformChanged(), cleared once transform() has refreshed the cache. Parallel stage
+    // tasks of siblings may refresh a shared ancestor concurrently; see transform().
+    std::atomic<bool> recalcTransform{true};
     Transform globalTransform{};
     std::weak_ptr<::nicxlive::core::Puppet> puppet{};
 
@@ -230,6 +245,13 @@ public:
     virtual void runRenderBeginTask(core::RenderContext& ctx);
     virtual void runRenderEndTask(core::RenderContext& ctx);
     virtual void registerRenderTasks(core::TaskScheduler& scheduler);
+    // PreProcess/Dynamic/Post tasks of a node write only the node and read its ancestors'
+    // transforms and the sources of its filter hooks. Node types whose tasks reach other nodes
+    // return false.
+    bool describeTaskAccess(core::TaskOrder order, core::TaskAccess& access) const override;
+    // Adds what running one filter hook touches: a read of its source, a write of its shared
+    // state. False when the hook does not name its source.
+    static bool describeFilterAccess(const Node* source, const void* state, core::TaskAccess& access);
     virtual RenderScopeHint determineRenderScopeHint();
 
     std::array<float, 4> getInitialBoundsSize() const;
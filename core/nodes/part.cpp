@@ -148,11 +148,11 @@ const std::string& Part::typeId() const {
 void Part::initPartTasks() { requireRenderTask(); }
 
 void Part::updateUVs() {
-    sharedUvResize(sharedUvs, mesh->uvs.size());
+    sharedBuffers->uv.resizeArray(sharedUvs, mesh->uvs.size());
     for (std::size_t i = 0; i < mesh->uvs.size(); ++i) {
         sharedUvs.set(i, mesh->uvs[i]);
     }
-    sharedUvMarkDirty();
+    sharedBuffers->uv.markDirtyRange(uvOffset, sharedUvs.size());
 }
 
 void Part::drawSelf(bool /*isMask*/) {
@@ -596,9 +596,9 @@ void Part::fillDrawPacket(const Node& header, PartDrawPacket& packet, bool isMas
     packet.vertexOffset = vertexOffset;
     packet.uvOffset = uvOffset;
     packet.deformOffset = deformOffset;
-    packet.vertexAtlasStride = sharedVertexBufferData().size();
-    packet.uvAtlasStride = sharedUvBufferData().size();
-    packet.deformAtlasStride = sharedDeformBufferData().size();
+    packet.vertexAtlasStride = sharedBuffers->vertex.data().size();
+    packet.uvAtlasStride = sharedBuffers->uv.data().size();
+    packet.deformAtlasStride = sharedBuffers->deform.data().size();
     packet.vertexCount = static_cast<uint32_t>(mesh->vertices.size());
     packet.indexCount = static_cast<uint32_t>(mesh->indices.size());
     packet.indexBuffer = ibo;
@@ -661,7 +661,7 @@ void Part::fillDrawPacket(const Node& header, PartDrawPacket& packet, bool isMas
         const float dx0 = deformation.xAt(0);
         const float dy0 = deformation.yAt(0);
         const float abs0 = std::max(std::fabs(dx0), std::fabs(dy0));
-        const auto& atlas = sharedDeformBufferData();
+        const auto& atlas = sharedBuffers->deform.data();
         const float* atlasX = atlas.dataX();
         const float* localX = deformation.dataX();
         std::ptrdiff_t xDelta = -1;
@@ -31,6 +31,9 @@ using nicxlive::core::common::scatterAddVec2;
 
 namespace {
 constexpr int kPathFilterStage = 1;
+// deformChildren keeps process-wide trace counters besides each deformer's scratch buffers, so
+// every path filter call shares this one state key.
+constexpr char kPathFilterState = 0;
 constexpr std::size_t kInvalidDisableThreshold = 10;
 constexpr std::size_t kInvalidLogInterval = 10;
 constexpr std::size_t kInvalidLogFrameInterval = 30;
@@ -396,6 +399,11 @@ void PathDeformer::cacheClosestPoints(const std::shared_ptr<Node>& node, int nSa
     }
 
     auto& cache = meshCaches[node.get()];
+    if (auto adopted = adoptedClosestPoints.find(node->uuid);
+        adopted != adoptedClosestPoints.end() && adopted->second.size() == nodeVertices.size()) {
+        cache = adopted->second;
+        return;
+    }
     cache.resize(nodeVertices.size());
 
     const auto& curve = prevCurve ? prevCurve : originalCurve;
@@ -1223,6 +1231,7 @@ void PathDeformer::build(bool force) {
     setupSelf();
     refresh();
     Node::build(force);
+    adoptedClosestPoints.clear();
 }
 
 bool PathDeformer::setupChildNoRecurse(const std::shared_ptr<Node>& node, bool prepend) {
@@ -1254,6 +1263,10 @@ bool PathDeformer::setupChildNoRecurse(const std::shared_ptr<Node>& node, bool p
             Node::DeformFilterHook hook;
             hook.stage = kPathFilterStage;
             hook.tag = tag;
+            hook.source = this;
+            hook.state = &kPathFilterState;
+            hook.source = this;
+            hook.state = &kPathFilterState;
             hook.func = [this](std::shared_ptr<Node> t,
                                const Vec2Array& v,
                                Vec2Array& d,
@@ -1269,6 +1282,10 @@ bool PathDeformer::setupChildNoRecurse(const std::shared_ptr<Node>& node, bool p
             Node::FilterHook hook;
             hook.stage = kPathFilterStage;
             hook.tag = tag;
+            hook.source = this;
+            hook.state = &kPathFilterState;
+            hook.source = this;
+            hook.state = &kPathFilterState;
             hook.func = [this](std::shared_ptr<Node> t,
                                const Vec2Array& v,
                                Vec2Array d,
@@ -72,6 +72,10 @@ public:
     std::unique_ptr<Curve> originalCurve{};
     std::unique_ptr<Curve> deformedCurve{};
     std::unordered_map<const Node*, std::vector<float>> meshCaches{};
+    // Closest-point caches made elsewhere (a puppet cache), by target uuid. cacheClosestPoints
+    // copies an entry that matches the target's vertex count instead of sampling the curve;
+    // build() drops them.
+    std::unordered_map<uint32_t, std::vector<float>> adoptedClosestPoints{};
     std::unique_ptr<Curve> prevCurve{};
     Vec2 prevRoot{};
     bool prevRootSet{false};
@@ -150,6 +154,7 @@ public:
     // Node overrides
     void runPreProcessTask(core::RenderContext& ctx) override;
     void runRenderTask(core::RenderContext& ctx) override;
+    bool describeTaskAccess(core::TaskOrder, core::TaskAccess&) const override { return false; }
     bool setupChild(const std::shared_ptr<Node>& child) override;
     bool releaseChild(const std::shared_ptr<Node>& child) override;
     void captureTarget(const std::shared_ptr<Node>& target) override;
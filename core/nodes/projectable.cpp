@@ -396,8 +396,9 @@ bool Projectable::createSimpleMesh() {
                              std::abs(newTextureOffset.y - textureOffset.y) > TextureOffsetEpsilon;
         if (offsetChanged) {
             textureInvalidated = true;
-            mesh->vertices = vertexArray;
-            mesh->indices = {0, 1, 2, 2, 1, 3};
+            auto& resized = mutableMesh();
+            resized.vertices = vertexArray;
+            resized.indices = {0, 1, 2, 2, 1, 3};
             shouldUpdateVertices = true;
             autoResizedSize = Vec2{bounds.z - bounds.x, bounds.w - bounds.y};
             updateVertices();
@@ -540,10 +541,11 @@ bool Projectable::initTarget() {
     textureOffset.x += deformOffset.x - t.translation.x;
     textureOffset.y += deformOffset.y - t.translation.y;
     textures = {};
-    textures[0] = std::make_shared<Texture>(static_cast<int>(texWidth), static_cast<int>(texHeight));
-    stencil = std::make_shared<Texture>(static_cast<int>(texWidth), static_cast<int>(texHeight), 1, true);
-    if (prevTexture) prevTexture->dispose();
-    if (prevStencil) prevStencil->dispose();
+    // Hand the old surfaces back first so a resize within the same size class reuses them.
+    inReleaseRenderTarget(prevTexture);
+    inReleaseRenderTarget(prevStencil);
+    textures[0] = inAcquireRenderTarget(static_cast<int>(texWidth), static_cast<int>(texHeight));
+    stencil = inAcquireRenderTarget(static_cast<int>(texWidth), static_cast<int>(texHeight), 1, true);
     if (offscreenSurface) {
         if (auto backend = core::getCurrentRenderBackend()) {
             backend->destroyDynamicComposite(offscreenSurface);
@@ -775,20 +777,20 @@ void Projectable::renderNestedOffscreen(core::RenderContext& ctx) {
 }
 
 void Projectable::registerRenderTasks(core::TaskScheduler& scheduler) {
-    scheduler.addTask(core::TaskOrder::Init, core::TaskKind::Init, [this](core::RenderContext& ctx) { runBeginTask(ctx); });
-    scheduler.addTask(core::TaskOrder::PreProcess, core::TaskKind::PreProcess, [this](core::RenderContext& ctx) { runPreProcessTask(ctx); });
-    scheduler.addTask(core::TaskOrder::Dynamic, core::TaskKind::Dynamic, [this](core::RenderContext& ctx) { runDynamicTask(ctx); });
-    scheduler.addTask(core::TaskOrder::Post0, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(0, ctx); });
-    scheduler.addTask(core::TaskOrder::Post1, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(1, ctx); });
-    scheduler.addTask(core::TaskOrder::Post2, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(2, ctx); });
+    scheduler.addNodeTask(core::TaskOrder::Init, core::TaskKind::Init, this);
+    scheduler.addNodeTask(core::TaskOrder::PreProcess, core::TaskKind::PreProcess, this);
+    scheduler.addNodeTask(core::TaskOrder::Dynamic, core::TaskKind::Dynamic, this);
+    scheduler.addNodeTask(core::TaskOrder::Post0, core::TaskKind::PostProcess, this);
+    scheduler.addNodeTask(core::TaskOrder::Post1, core::TaskKind::PostProcess, this);
+    scheduler.addNodeTask(core::TaskOrder::Post2, core::TaskKind::PostProcess, this);
 
     bool allowRenderTasks = !hasProjectableAncestor(std::dynamic_pointer_cast<Projectable>(shared_from_this()));
     if (allowRenderTasks) {
-    scheduler.addTask(core::TaskOrder::RenderBegin, core::TaskKind::Render, [this](core::RenderContext& ctx) { runRenderBeginTask(ctx); });
-    scheduler.addTask(core::TaskOrder::Render, core::TaskKind::Render, [this](core::RenderContext& ctx) { runRenderTask(ctx); });
+    scheduler.addNodeTask(core::TaskOrder::RenderBegin, core::TaskKind::Render, this);
+    scheduler.addNodeTask(core::TaskOrder::Render, core::TaskKind::Render, this);
     }
 
-    scheduler.addTask(core::TaskOrder::Final, core::TaskKind::Finalize, [this](core::RenderContext& ctx) { runFinalTask(ctx); });
+    scheduler.addNodeTask(core::TaskOrder::Final, core::TaskKind::Finalize, this);
 
     auto orderedChildren = childrenRef();
     std::sort(orderedChildren.begin(), orderedChildren.end(), [](const std::shared_ptr<Node>& a, const std::shared_ptr<Node>& b) {
@@ -796,21 +798,21 @@ void Projectable::registerRenderTasks(core::TaskScheduler& scheduler) {
         return a->zSort() > b->zSort();
     });
     for (auto& child : orderedChildren) {
-        if (child) child->registerRenderTasks(scheduler);
+        if (child) scheduler.addSubtree(child.get());
     }
     if (allowRenderTasks) {
-        scheduler.addTask(core::TaskOrder::RenderEnd, core::TaskKind::Render, [this](core::RenderContext& ctx) { runRenderEndTask(ctx); });
+        scheduler.addNodeTask(core::TaskOrder::RenderEnd, core::TaskKind::Render, this);
     }
 }
 
 void Projectable::registerDelegatedTasks(core::TaskScheduler& scheduler) {
-    scheduler.addTask(core::TaskOrder::Init, core::TaskKind::Init, [this](core::RenderContext& ctx) { runBeginTask(ctx); });
-    scheduler.addTask(core::TaskOrder::PreProcess, core::TaskKind::PreProcess, [this](core::RenderContext& ctx) { runPreProcessTask(ctx); });
-    scheduler.addTask(core::TaskOrder::Dynamic, core::TaskKind::Dynamic, [this](core::RenderContext& ctx) { runDynamicTask(ctx); });
-    scheduler.addTask(core::TaskOrder::Post0, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(0, ctx); });
-    scheduler.addTask(core::TaskOrder::Post1, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(1, ctx); });
-    scheduler.addTask(core::TaskOrder::Post2, core::TaskKind::PostProcess, [this](core::RenderContext& ctx) { runPostTaskImpl(2, ctx); });
-    scheduler.addTask(core::TaskOrder::Final, core::TaskKind::Finalize, [this](core::RenderContext& ctx) { runFinalTask(ctx); });
+    scheduler.addNodeTask(core::TaskOrder::Init, core::TaskKind::Init, this);
+    scheduler.addNodeTask(core::TaskOrder::PreProcess, core::TaskKind::PreProcess, this);
+    scheduler.addNodeTask(core::TaskOrder::Dynamic, core::TaskKind::Dynamic, this);
+    scheduler.addNodeTask(core::TaskOrder::Post0, core::TaskKind::PostProcess, this);
+    scheduler.addNodeTask(core::TaskOrder::Post1, core::TaskKind::PostProcess, this);
+    scheduler.addNodeTask(core::TaskOrder::Post2, core::TaskKind::PostProcess, this);
+    scheduler.addNodeTask(core::TaskOrder::Final, core::TaskKind::Finalize, this);
 }
 
 void Projectable::delegatedRunRenderBeginTask(core::RenderContext& ctx) { dynamicRenderBegin(ctx); }
@@ -94,6 +94,8 @@ public:
     void preProcess() override;
     void postProcess(int id = 0) override;
     void registerRenderTasks(core::TaskScheduler& scheduler) override;
+    // Renders its subtree offscreen from its own tasks.
+    bool describeTaskAccess(core::TaskOrder, core::TaskAccess&) const override { return false; }
     void runRenderBeginTask(core::RenderContext& ctx) override;
     void runRenderTask(core::RenderContext& ctx) override;
     void runRenderEndTask(core::RenderContext& ctx) override;
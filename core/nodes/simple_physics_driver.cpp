@@ -524,9 +524,9 @@ void SimplePhysicsDriver::serializeSelfImpl(::nicxlive::core::serde::InochiSeria
 
 ::nicxlive::core::serde::SerdeException SimplePhysicsDriver::deserializeFromFghj(const ::nicxlive::core::serde::Fghj& data) {
     auto err = Node::deserializeFromFghj(data);
-    const bool hasModelType = data.get_child_optional("model_type").has_value();
-    const bool hasMapMode = data.get_child_optional("map_mode").has_value();
-    const bool hasOutputScale = data.get_child_optional("output_scale").has_value();
+    const bool hasModelType = data.get_child_optional("model_type") != nullptr;
+    const bool hasMapMode = data.get_child_optional("map_mode") != nullptr;
+    const bool hasOutputScale = data.get_child_optional("output_scale") != nullptr;
     if (auto p = data.get_optional<std::size_t>("param")) paramRef = static_cast<uint32_t>(*p);
     if (auto mt = data.get_optional<int>("model_type")) modelType = static_cast<PhysicsModel>(*mt);
     if (auto mts = data.get_optional<std::string>("model_type")) parsePhysicsModel(*mts, modelType);
@@ -63,6 +63,10 @@ public:
     virtual void setTarget(const std::shared_ptr<Node>& node, const std::string& paramName) = 0;
     virtual bool isCompatibleWithNode(const std::shared_ptr<Node>& other) const = 0;
     virtual std::string getName() const = 0;
+    // Takes `other`'s keyframe grid by reference instead of holding a copy (puppet instancing).
+    // False, and nothing shared, if the bindings differ in value type or grid shape.
+    virtual bool shareValues(const ParameterBinding& /*other*/) { return false; }
+    virtual bool sharesValuesWith(const ParameterBinding& /*other*/) const { return false; }
     // Serialize / Deserialize
     virtual ::nicxlive::core::serde::SerdeException serializeSelf(::nicxlive::core::serde::InochiSerializer&) const { return std::nullopt; }
     virtual ::nicxlive::core::serde::SerdeException deserializeFromFghj(const ::nicxlive::core::serde::Fghj&) { return std::nullopt; }
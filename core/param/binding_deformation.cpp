@@ -7,11 +7,9 @@ namespace nicxlive::core::param {
 
 bool pushDeformationToNode(const std::shared_ptr<Node>& node, const DeformSlot& value) {
     if (!node) return false;
-    auto deformable = std::dynamic_pointer_cast<::nicxlive::core::nodes::Deformable>(node);
+    auto* deformable = dynamic_cast<::nicxlive::core::nodes::Deformable*>(node.get());
     if (!deformable) return false;
-    ::nicxlive::core::nodes::Deformation deform;
-    deform.vertexOffsets = value.vertexOffsets;
-    deformable->deformStack.push(deform);
+    deformable->deformStack.push(value.vertexOffsets);
     return true;
 }
 
@@ -19,6 +19,7 @@ namespace nicxlive::core {
 class Puppet;
 std::shared_ptr<nodes::Node> resolvePuppetNodeById(const std::shared_ptr<Puppet>& puppet, uint32_t uuid);
 std::shared_ptr<::nicxlive::core::param::Parameter> resolvePuppetParameterById(const std::shared_ptr<Puppet>& puppet, uint32_t uuid);
+std::shared_ptr<::nicxlive::core::param::ParameterBinding> resolveInstanceTemplateBinding(uint32_t paramUuid, const std::string& bindingKey);
 }
 namespace nicxlive::core::nodes {
 bool areDeformationNodesCompatible(const std::shared_ptr<Node>& lhs, const std::shared_ptr<Node>& rhs);
@@ -43,6 +44,50 @@ inline bool traceParamBindingEnabled() {
     return enabled != 0;
 }
 
+// Keyframe values of a binding, x-major. Copies and puppet instances (ParameterBinding::shareValues)
+// share the rows: const access reads them in place, any non-const access first detaches a private
+// copy, so editing one binding never shows up in another. revision() moves on every non-const
+// access or re-share, which is what invalidates the binding's cached interpolation.
+template <typename T>
+class KeyframeGrid {
+public:
+    using Rows = std::vector<std::vector<T>>;
+
+    KeyframeGrid() : rows_(std::make_shared<Rows>()) {}
+
+    void share(const KeyframeGrid& other) {
+        rows_ = other.rows_;
+        ++revision_;
+    }
+    bool sharedWith(const KeyframeGrid& other) const { return rows_ == other.rows_; }
+    std::uint64_t revision() const { return revision_; }
+
+    std::size_t size() const { return rows_->size(); }
+    bool empty() const { return rows_->empty(); }
+    const std::vector<T>& front() const { return rows_->front(); }
+    const std::vector<T>& operator[](std::size_t x) const { return (*rows_)[x]; }
+    typename Rows::const_iterator begin() const { return rows_->cbegin(); }
+    typename Rows::const_iterator end() const { return rows_->cend(); }
+
+    std::vector<T>& front() { return mut().front(); }
+    std::vector<T>& operator[](std::size_t x) { return mut()[x]; }
+    typename Rows::iterator begin() { return mut().begin(); }
+    typename Rows::iterator end() { return mut().end(); }
+    void assign(std::size_t count, const std::vector<T>& row) { mut().assign(count, row); }
+    typename Rows::iterator insert(typename Rows::const_iterator pos, const std::vector<T>& row) { return mut().insert(pos, row); }
+    typename Rows::iterator erase(typename Rows::const_iterator pos) { return mut().erase(pos); }
+
+private:
+    Rows& mut() {
+        if (rows_.use_count() > 1) rows_ = std::make_shared<Rows>(*rows_);
+        ++revision_;
+        return *rows_;
+    }
+
+    std::shared_ptr<Rows> rows_;
+    std::uint64_t revision_{0};
+};
+
 template <typename T>
 class ParameterBindingImpl : public ParameterBinding {
 public:
@@ -70,8 +115,22 @@ public:
     ::nicxlive::core::serde::SerdeException serializeSelf(::nicxlive::core::serde::InochiSerializer& serializer) const override;
     ::nicxlive::core::serde::SerdeException deserializeFromFghj(const ::nicxlive::core::serde::Fghj& data) override;
 
+    // A parameter sitting still hands back the same keypoint and offset every frame; the target
+    // is reset each frame so the contribution is re-applied, but the interpolation is reused.
     void apply(const Vec2u& leftKeypoint, const Vec2& offset) override {
-        applyToTarget(interpolate(leftKeypoint, offset));
+        const bool vec2 = parameter && parameter->isVec2;
+        if (!applied_.valid || applied_.revision != values.revision() || applied_.mode != interpolateMode_ ||
+            applied_.vec2 != vec2 || applied_.left.x != leftKeypoint.x || applied_.left.y != leftKeypoint.y ||
+            std::memcmp(&applied_.offset, &offset, sizeof(Vec2)) != 0) {
+            applied_.value = interpolate(leftKeypoint, offset);
+            applied_.valid = true;
+            applied_.revision = values.revision();
+            applied_.mode = interpolateMode_;
+            applied_.vec2 = vec2;
+            applied_.left = leftKeypoint;
+            applied_.offset = offset;
+        }
+        applyToTarget(applied_.value);
     }
 
     void reconstruct(const std::shared_ptr<::nicxlive::core::Puppet>& /*puppet*/) override {}
@@ -454,16 +513,46 @@ public:
 
     bool isCompatibleWithNode(const std::shared_ptr<Node>& /*other*/) const override { return true; }
 
+    bool shareValues(const ParameterBinding& other) override {
+        auto* source = dynamic_cast<const ParameterBindingImpl<T>*>(&other);
+        if (!source || source->values.size() != isSetFlags.size()) return false;
+        for (std::size_t x = 0; x < isSetFlags.size(); ++x) {
+            if (source->values[x].size() != isSetFlags[x].size()) return false;
+        }
+        values.share(source->values);
+        return true;
+    }
+
+    bool sharesValuesWith(const ParameterBinding& other) const override {
+        auto* source = dynamic_cast<const ParameterBindingImpl<T>*>(&other);
+        return source && values.sharedWith(source->values);
+    }
+
 protected:
     Parameter* parameter{};
     BindTarget target{};
     uint32_t nodeUuid_{0};
-    std::vector<std::vector<T>> values{};
+    KeyframeGrid<T> values{};
     std::vector<std::vector<bool>> isSetFlags{};
     InterpolateMode interpolateMode_{InterpolateMode::Linear};
 
     virtual void applyToTarget(const T& value) = 0;
 
+private:
+    // Last interpolated contribution and the inputs it was computed from.
+    struct AppliedValue {
+        bool valid{false};
+        std::uint64_t revision{0};
+        InterpolateMode mode{InterpolateMode::Linear};
+        bool vec2{false};
+        Vec2u left{};
+        Vec2 offset{};
+        T value{};
+    };
+    AppliedValue applied_{};
+
+protected:
+
     virtual void clearValue(T& v) { v = T{}; }
 
     T& getValue(const Vec2u& point) { return values[point.x][point.y]; }
@@ -475,7 +564,7 @@ protected:
         reInterpolate();
     }
 
-    T interpolate(const Vec2u& leftKeypoint, const Vec2& offset) {
+    T interpolate(const Vec2u& leftKeypoint, const Vec2& offset) const {
         auto lx = std::min<std::size_t>(leftKeypoint.x, values.size() > 0 ? values.size() - 1 : 0);
         auto ly = std::min<std::size_t>(leftKeypoint.y, values.empty() ? 0 : values[lx].size() > 0 ? values[lx].size() - 1 : 0);
         if (interpolateMode_ == InterpolateMode::Nearest) {
@@ -828,6 +917,9 @@ inline ::nicxlive::core::serde::SerdeException Parameter::deserializeFromFghj(co
                 if (auto err = binding->deserializeFromFghj(child)) return err;
                 auto t = binding->getTarget();
                 auto mapKey = std::to_string(t.uuid) + ":" + binding->getName() + ":" + std::to_string(bindingMap.size());
+                if (auto shared = ::nicxlive::core::resolveInstanceTemplateBinding(uuid, mapKey)) {
+                    binding->shareValues(*shared);
+                }
                 bindingMap[mapKey] = binding;
             }
         }
@@ -896,13 +988,15 @@ inline void Parameter::update() {
     Vec2 sub{};
     auto mapped = mapInternalValue(latestInternal);
     findOffset(mapped, left, sub);
+    // Bindings reuse their last interpolation when left/sub repeat, so an unchanged value and
+    // unchanged driver inputs cost one re-application per binding and no change notifications.
+    const bool changed = valueChanged();
     for (auto& [_, b] : bindingMap) {
         if (!b) continue;
         b->apply(left, sub);
-        if (auto node = b->getTarget().target.lock()) {
-            if (valueChanged()) {
-                node->notifyChange(node);
-            }
+        if (!changed) continue;
+        if (auto node = b->getNode()) {
+            node->notifyChange(node);
         }
     }
     iadd.clear();
@@ -1011,12 +1105,11 @@ inline boost::property_tree::ptree serializeValueNode(const DeformSlot& v) {
     return node;
 }
 
-inline void deserializeValueNode(const boost::property_tree::ptree& node, float& out) {
+inline void deserializeValueNode(const ::nicxlive::core::serde::Fghj& node, float& out) {
     out = node.get_value<float>();
 }
 
-inline void deserializeValueNode(const boost::property_tree::ptree& node, DeformSlot& out) {
-    static const boost::property_tree::ptree empty{};
+inline void deserializeValueNode(const ::nicxlive::core::serde::Fghj& node, DeformSlot& out) {
     if (const auto voIt = node.find("vertexOffsets"); voIt != node.not_found()) {
         deserializeValueNode(voIt->second, out);
         return;
@@ -1024,17 +1117,17 @@ inline void deserializeValueNode(const boost::property_tree::ptree& node, Deform
     const auto xsIt = node.find("x");
     const auto ysIt = node.find("y");
     if (xsIt != node.not_found() && ysIt != node.not_found()) {
-        const auto& xs = xsIt->second;
-        const auto& ys = ysIt->second;
+        thread_local std::vector<float> xs;
+        thread_local std::vector<float> ys;
+        xs.clear();
+        ys.clear();
+        xsIt->second.readFloats(xs);
+        ysIt->second.readFloats(ys);
         std::size_t n = std::min(xs.size(), ys.size());
         out.vertexOffsets.resize(n);
-        std::size_t idx = 0;
-        for (auto it = xs.begin(); it != xs.end() && idx < n; ++it, ++idx) {
-            out.vertexOffsets.xAt(idx) = it->second.get_value<float>();
-        }
-        idx = 0;
-        for (auto it = ys.begin(); it != ys.end() && idx < n; ++it, ++idx) {
-            out.vertexOffsets.yAt(idx) = it->second.get_value<float>();
+        for (std::size_t idx = 0; idx < n; ++idx) {
+            out.vertexOffsets.xAt(idx) = xs[idx];
+            out.vertexOffsets.yAt(idx) = ys[idx];
         }
         return;
     }
@@ -1050,7 +1143,13 @@ inline void deserializeValueNode(const boost::property_tree::ptree& node, Deform
         float y = 0.0f;
         bool parsed = false;
 
-        if (auto ox = v.get_optional<float>("x")) {
+        if (v.kind() == ::nicxlive::core::serde::JsonValue::Kind::Array && v.size() == 2 &&
+            v.front().second.isNumber() && v.back().second.isNumber()) {
+            // The common [x, y] pair: convert both straight from the source text.
+            x = v.front().second.get_value<float>();
+            y = v.back().second.get_value<float>();
+            parsed = true;
+        } else if (auto ox = v.get_optional<float>("x")) {
             x = *ox;
             y = v.get<float>("y", 0.0f);
             parsed = true;
@@ -1140,7 +1239,7 @@ template <typename T>
         else if (mode == "step") interpolateMode_ = InterpolateMode::Step;
     }
 
-    static const boost::property_tree::ptree empty{};
+    static const ::nicxlive::core::serde::Fghj empty{};
     const auto valuesIt = data.find("values");
     const auto isSetIt = data.find("isSet");
     const auto& valuesTree = valuesIt != data.not_found() ? valuesIt->second : empty;
@@ -18,6 +18,7 @@
 #include <cstring>
 #include <limits>
 #include <map>
+#include <unordered_map>
 
 namespace nicxlive::core {
 
@@ -197,11 +198,27 @@ void Puppet::rebuildRenderTasks(const std::shared_ptr<Node>& rootNode) {
     if (!rootNode) return;
     renderScheduler.clearTasks();
     auto rootForTasks = rootNode;
-    rootForTasks->registerRenderTasks(renderScheduler);
+    renderScheduler.addSubtree(rootForTasks.get());
     renderScheduler.addTask(TaskOrder::Parameters, TaskKind::Parameters, [this, rootForTasks](RenderContext&) {
         updateParametersAndDrivers(rootForTasks);
     });
     schedulerCacheValid = true;
+    taskRoot = rootForTasks.get();
+    dirtyTaskSubtrees.clear();
+}
+
+void Puppet::rebuildDirtyTaskSubtrees() {
+    // Held for the rebuild: a parent a node just left may have no other owner.
+    std::vector<std::shared_ptr<Node>> alive;
+    std::vector<Node*> nodes;
+    for (const auto& weak : dirtyTaskSubtrees) {
+        if (auto node = weak.lock()) {
+            nodes.push_back(node.get());
+            alive.push_back(std::move(node));
+        }
+    }
+    dirtyTaskSubtrees.clear();
+    renderScheduler.rebuildSubtrees(std::move(nodes));
 }
 
 void Puppet::updateParametersAndDrivers(const std::shared_ptr<Node>& rootNode) {
@@ -248,6 +265,10 @@ std::shared_ptr<Node> Puppet::findNode(const std::shared_ptr<Node>& n, const std
 
 std::shared_ptr<Node> Puppet::findNode(const std::shared_ptr<Node>& n, uint32_t uuid) {
     if (!n) return nullptr;
+    if (lookupIndex && n == root) {
+        auto it = lookupIndex->nodes.find(uuid);
+        return it != lookupIndex->nodes.end() ? it->second : nullptr;
+    }
     if (n->uuid == uuid) return n;
     for (auto& child : n->childrenRef()) {
         if (auto found = findNode(child, uuid)) return found;
@@ -257,6 +278,8 @@ std::shared_ptr<Node> Puppet::findNode(const std::shared_ptr<Node>& n, uint32_t
 
 void Puppet::update() {
     auto updateProfile = render::profileScope("Puppet.update.total");
+    ScopedRenderBackend backendScope(renderBackend);
+    render::ScopedSharedBufferSet sharedBufferScope(sharedBufferSet);
     const auto totalStart = std::chrono::steady_clock::now();
     double automationMs = 0.0;
     double initParamMs = 0.0;
@@ -276,6 +299,10 @@ void Puppet::update() {
     renderContext.renderGraph = &renderGraph;
     renderContext.renderBackend = renderBackend.get();
     renderContext.gpuState = RenderGpuState::init();
+    const auto atlasWrites = [this]() {
+        return sharedBufferSet->deform.writeCount() + sharedBufferSet->vertex.writeCount() + sharedBufferSet->uv.writeCount();
+    };
+    const std::size_t atlasWritesBefore = atlasWrites();
 
     bool pendingStructure = pendingFrameChanges.structureDirty;
     NJCX_DBG_LOG("[nicxlive] frameChange pending structure=%d attr=%d force=%d cache=%d\n",
@@ -283,10 +310,14 @@ void Puppet::update() {
                  pendingFrameChanges.attributeDirty ? 1 : 0,
                  forceFullRebuild ? 1 : 0,
                  schedulerCacheValid ? 1 : 0);
-    if (forceFullRebuild || !schedulerCacheValid || pendingStructure) {
+    if (forceFullRebuild || !schedulerCacheValid || pendingStructure || rootNode.get() != taskRoot) {
         const auto rebuildStart = std::chrono::steady_clock::now();
         rebuildRenderTasks(rootNode);
         rebuildMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rebuildStart).count();
+    } else if (!dirtyTaskSubtrees.empty()) {
+        const auto rebuildStart = std::chrono::steady_clock::now();
+        rebuildDirtyTaskSubtrees();
+        rebuildMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rebuildStart).count();
     }
 
     const auto initParamStart = std::chrono::steady_clock::now();
@@ -297,9 +328,13 @@ void Puppet::update() {
     NJCX_DBG_LOG("[nicxlive] frameChange consumed1 structure=%d attr=%d\n",
                  frameChanges.structureDirty ? 1 : 0,
                  frameChanges.attributeDirty ? 1 : 0);
-    if (frameChanges.structureDirty) {
+    if (frameChanges.structureDirty || !dirtyTaskSubtrees.empty()) {
         const auto rebuildStart = std::chrono::steady_clock::now();
-        rebuildRenderTasks(rootNode);
+        if (frameChanges.structureDirty) {
+            rebuildRenderTasks(rootNode);
+        } else {
+            rebuildDirtyTaskSubtrees();
+        }
         rebuildMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - rebuildStart).count();
         const auto initParamRetryStart = std::chrono::steady_clock::now();
         renderScheduler.executeRange(renderContext, TaskOrder::Init, TaskOrder::Parameters);
@@ -325,6 +360,12 @@ void Puppet::update() {
                  renderGraph.passDepth(),
                  renderGraph.rootItemCount(),
                  renderGraph.empty() ? 1 : 0);
+    const bool parametersMoved = std::any_of(parameters.begin(), parameters.end(), [](const std::shared_ptr<Parameter>& p) {
+        return p && p->valueChanged();
+    });
+    // Notifications raised after the consume above (deform filters) are still pending and count too.
+    settled = !frameChanges.any() && !pendingFrameChanges.any() && !parametersMoved && automation.empty() &&
+              atlasWrites() == atlasWritesBefore;
     render::renderProfilerFrameCompleted();
     const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - totalStart).count();
     puppetPerfWindow().add(totalMs, automationMs, initParamMs, preFinalMs, rebuildMs);
@@ -346,6 +387,10 @@ std::ptrdiff_t Puppet::findParameterIndex(const std::string& name) {
 }
 
 std::shared_ptr<Parameter> Puppet::findParameter(uint32_t uuid) {
+    if (lookupIndex) {
+        auto it = lookupIndex->parameters.find(uuid);
+        return it != lookupIndex->parameters.end() ? it->second : nullptr;
+    }
     for (auto& p : parameters) {
         if (p && p->uuid == uuid) return p;
     }
@@ -367,6 +412,8 @@ void Puppet::draw() {
         drawImmediateFallback();
         return;
     }
+    ScopedRenderBackend backendScope(renderBackend);
+    render::ScopedSharedBufferSet sharedBufferScope(sharedBufferSet);
     if (renderGraph.empty()) {
         NJCX_DBG_LOG("[nicxlive] puppet.draw fallback reason=graph_empty rootItems=%zu depth=%zu\n",
                      renderGraph.rootItemCount(),
@@ -402,7 +449,27 @@ void Puppet::applyDeformToChildren() {
     walk(root);
 }
 
+void Puppet::buildLookupIndex() {
+    LookupIndex index;
+    std::vector<std::shared_ptr<Node>> stack;
+    if (root) stack.push_back(root);
+    while (!stack.empty()) {
+        auto node = std::move(stack.back());
+        stack.pop_back();
+        const auto& children = node->childrenRef();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            if (*it) stack.push_back(*it);
+        }
+        index.nodes.try_emplace(node->uuid, std::move(node));
+    }
+    for (const auto& param : parameters) {
+        if (param) index.parameters.try_emplace(param->uuid, param);
+    }
+    lookupIndex = std::move(index);
+}
+
 void Puppet::rescanNodes() {
+    lookupIndex.reset();
     auto node = actualRoot();
     scanParts(false, node);
 }
@@ -428,6 +495,20 @@ void Puppet::setRenderBackend(const std::shared_ptr<::nicxlive::core::RenderBack
     }
 }
 
+void Puppet::adoptSharedBuffers(const std::shared_ptr<render::SharedBufferSet>& set) {
+    if (!set || set == sharedBufferSet) return;
+    std::function<void(const std::shared_ptr<Node>&)> move = [&](const std::shared_ptr<Node>& node) {
+        if (!node) return;
+        if (auto drawable = std::dynamic_pointer_cast<nodes::Drawable>(node)) drawable->moveSharedBuffers(set);
+        for (const auto& child : node->childrenList()) move(child);
+    };
+    // A deserialized root is not necessarily parented under puppetRootNode; moves are idempotent.
+    move(actualRoot());
+    move(puppetRootNode);
+    sharedBufferSet = set;
+    forceFullRebuild = true;
+}
+
 bool Puppet::isRenderGraphEmpty() const {
     return renderGraph.empty();
 }
@@ -551,12 +632,23 @@ void Puppet::setRootNode(const std::shared_ptr<Node>& node) {
 
 void Puppet::recordNodeChange(nodes::NotifyReason reason) {
     NJCX_DBG_LOG("[nicxlive] recordNodeChange reason=%d\n", static_cast<int>(reason));
+    std::lock_guard<std::mutex> lock(frameChangeMutex);
     pendingFrameChanges.mark(reason);
     if (reason == nodes::NotifyReason::StructureChanged) {
         forceFullRebuild = true;
     }
 }
 
+void Puppet::recordSubtreeChange(const std::shared_ptr<Node>& node) {
+    if (!node) return;
+    pendingFrameChanges.attributeDirty = true;
+    if (forceFullRebuild || !schedulerCacheValid) return; // the next update registers everything
+    for (const auto& weak : dirtyTaskSubtrees) {
+        if (weak.lock() == node) return;
+    }
+    dirtyTaskSubtrees.push_back(node);
+}
+
 ::nicxlive::core::serde::SerdeException Puppet::deserializeFromFghj(const ::nicxlive::core::serde::Fghj& data) {
     try {
         std::size_t topKeys = 0;
@@ -599,12 +691,21 @@ void Puppet::recordNodeChange(nodes::NotifyReason reason) {
             NJCX_DBG_LOG("[nicxlive] puppet.deserialize params=%zu\n", parameters.size());
         }
 
+        // Reconstruct/finalize resolve node and parameter references by uuid; serve them from one
+        // index for the rest of the load.
+        struct DropLookupIndex {
+            Puppet& puppet;
+            ~DropLookupIndex() { puppet.lookupIndex.reset(); }
+        } dropLookupIndex{*this};
         if (loadedRoot) {
             loadedRoot->setParent(puppetRootNode);
             loadedRoot->setPuppet(shared_from_this());
             loadedRoot->reconstruct();
             root = loadedRoot;
+            buildLookupIndex();
             loadedRoot->finalize();
+        } else {
+            buildLookupIndex();
         }
 
         auto self = shared_from_this();
@@ -617,6 +718,7 @@ void Puppet::recordNodeChange(nodes::NotifyReason reason) {
             root->name = "Root";
             scanParts(true, root);
             selfSort();
+#ifdef NJCX_ENABLE_DEBUG_LOG
             std::size_t totalNodes = 0;
             std::size_t partCount = 0;
             std::size_t meshGroupCount = 0;
@@ -636,6 +738,7 @@ void Puppet::recordNodeChange(nodes::NotifyReason reason) {
             countNodes(root);
             NJCX_DBG_LOG("[nicxlive] load types total=%zu part=%zu meshgroup=%zu pathDeformer=%zu gridDeformer=%zu composite=%zu\n",
                          totalNodes, partCount, meshGroupCount, pathDeformerCount, gridDeformerCount, compositeCount);
+#endif
         }
     } catch (const std::exception& ex) {
         return std::string(ex.what());
@@ -653,4 +756,53 @@ std::shared_ptr<param::Parameter> resolvePuppetParameterById(const std::shared_p
     return puppet->findParameter(uuid);
 }
 
+struct ScopedPuppetInstanceTemplate::Index {
+    struct Mesh {
+        const std::string* typeId{nullptr};
+        std::shared_ptr<nodes::MeshData> data{};
+    };
+    // First node wins for duplicate uuids, like findNodeById.
+    std::unordered_map<uint32_t, Mesh> meshes{};
+    std::unordered_map<uint32_t, std::shared_ptr<param::Parameter>> parameters{};
+};
+
+namespace {
+thread_local const ScopedPuppetInstanceTemplate::Index* tInstanceTemplate = nullptr;
+}
+
+ScopedPuppetInstanceTemplate::ScopedPuppetInstanceTemplate(const Puppet& templ)
+    : index_(std::make_unique<Index>()), previous_(tInstanceTemplate) {
+    auto collect = [&](const std::shared_ptr<Node>& node, const auto& self) -> void {
+        if (!node) return;
+        if (auto drawable = std::dynamic_pointer_cast<nodes::Drawable>(node)) {
+            index_->meshes.try_emplace(drawable->uuid, Index::Mesh{&drawable->typeId(), drawable->mesh});
+        }
+        for (const auto& child : node->childrenRef()) self(child, self);
+    };
+    collect(templ.root, collect);
+    for (const auto& param : templ.parameters) {
+        if (param) index_->parameters.try_emplace(param->uuid, param);
+    }
+    tInstanceTemplate = index_.get();
+}
+
+ScopedPuppetInstanceTemplate::~ScopedPuppetInstanceTemplate() {
+    tInstanceTemplate = previous_;
+}
+
+std::shared_ptr<nodes::MeshData> resolveInstanceTemplateMesh(uint32_t uuid, const std::string& typeId) {
+    if (!tInstanceTemplate) return nullptr;
+    auto it = tInstanceTemplate->meshes.find(uuid);
+    if (it == tInstanceTemplate->meshes.end() || *it->second.typeId != typeId) return nullptr;
+    return it->second.data;
+}
+
+std::shared_ptr<param::ParameterBinding> resolveInstanceTemplateBinding(uint32_t paramUuid, const std::string& bindingKey) {
+    if (!tInstanceTemplate) return nullptr;
+    auto it = tInstanceTemplate->parameters.find(paramUuid);
+    if (it == tInstanceTemplate->parameters.end()) return nullptr;
+    auto binding = it->second->bindingMap.find(bindingKey);
+    return binding == it->second->bindingMap.end() ? nullptr : binding->second;
+}
+
 } // namespace nicxlive::core
@@ -11,6 +11,7 @@
 #include "render/graph_builder.hpp"
 #include "render/scheduler.hpp"
 #include "render/command_emitter.hpp"
+#include "render/shared_deform_buffer.hpp"
 #include "texture.hpp"
 
 #include <algorithm>
@@ -19,8 +20,10 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -54,6 +57,15 @@ struct PuppetPhysics {
     float gravity{9.8f};
 };
 
+// The puppet's JSON as loaded, flattened, without the data its instances share with it instead of
+// reading (node meshes and binding keyframe values). fmt::inInstantiatePuppet builds instances
+// from it.
+struct PuppetInstanceModel {
+    std::vector<serde::JsonFlatNode> nodes{};
+    std::string strings{};
+    bool inpMode{false};
+};
+
 class Puppet : public std::enable_shared_from_this<Puppet> {
 public:
     Puppet();
@@ -75,9 +87,16 @@ public:
         }
     };
     FrameChangeState consumeFrameChanges();
+    // True when the last update() changed nothing observable: no node reported a change, no
+    // parameter value moved, no shared atlas slot was rewritten and no automation is attached.
+    // Hosts may skip further updates while settled as long as their own inputs stay unchanged.
+    bool isSettled() const { return settled; }
     void rebuildRenderTasks(const std::shared_ptr<nodes::Node>& rootNode);
     void updateParametersAndDrivers(const std::shared_ptr<nodes::Node>& rootNode);
     void update();
+    // Runs the independent node tasks of each update stage on `pool`; null (the default) is serial.
+    // Results match the serial path. Must not be the pool that is ticking this puppet.
+    void setTaskWorkerPool(WorkerPool* pool) { renderScheduler.setWorkerPool(pool); }
     void resetDrivers();
 
     // queries
@@ -92,6 +111,9 @@ public:
     std::shared_ptr<Parameter> findParameterById(uint32_t uuid);
     std::vector<std::shared_ptr<nodes::Part>> getAllParts();
     void recordNodeChange(nodes::NotifyReason reason);
+    // `node`'s children changed (Node::insertInto): the next update re-registers the tasks of its
+    // subtree only, in place, instead of rebuilding the whole task list.
+    void recordSubtreeChange(const std::shared_ptr<nodes::Node>& node);
 
     // rendering
     void draw();
@@ -101,6 +123,10 @@ public:
     void updateTextureState();
     RenderCommandEmitter* commandEmitter();
     void setRenderBackend(const std::shared_ptr<::nicxlive::core::RenderBackend>& backend);
+    // Atlas set the puppet's drawables were registered into (current set at construction).
+    const std::shared_ptr<render::SharedBufferSet>& sharedBuffers() const { return sharedBufferSet; }
+    // Moves every drawable into `set` and makes it the puppet's set (see Drawable::moveSharedBuffers).
+    void adoptSharedBuffers(const std::shared_ptr<render::SharedBufferSet>& set);
     bool isRenderGraphEmpty() const;
     std::size_t rootPartCount() const;
     ::nicxlive::core::serde::SerdeException deserializeFromFghj(const ::nicxlive::core::serde::Fghj& data);
@@ -127,6 +153,8 @@ public:
     bool enableDrivers{true};
     nodes::Transform transform{};
     std::map<std::string, std::vector<uint8_t>> extData{};
+    // Set by the loaders; null for puppets built in code.
+    std::shared_ptr<const PuppetInstanceModel> instanceModel{};
 
 private:
     std::shared_ptr<nodes::Node> puppetRootNode{};
@@ -137,21 +165,60 @@ private:
     std::unique_ptr<RenderCommandEmitter> commandEmitterOwned{};
     ::nicxlive::core::RenderGraphBuilder renderGraph{};
     std::shared_ptr<::nicxlive::core::RenderBackend> renderBackend{};
+    std::shared_ptr<render::SharedBufferSet> sharedBufferSet{render::currentSharedBufferSet()};
     ::nicxlive::core::TaskScheduler renderScheduler{};
     ::nicxlive::core::RenderContext renderContext{};
     ::nicxlive::core::RenderCommandEmitter* commandEmitterRaw{nullptr};
 
     FrameChangeState pendingFrameChanges{};
+    // Guards pendingFrameChanges and forceFullRebuild in recordNodeChange, which node tasks call
+    // from parallel waves.
+    std::mutex frameChangeMutex{};
+    bool settled{false};
     bool schedulerCacheValid{false};
     bool forceFullRebuild{true};
+    // Registered root of the task list, and subtrees whose tasks are stale (recordSubtreeChange).
+    const nodes::Node* taskRoot{nullptr};
+    std::vector<std::weak_ptr<nodes::Node>> dirtyTaskSubtrees{};
+    // uuid -> first node in tree order / parameter, built once a load has its tree so resolving the
+    // node and parameter references of every node and binding is not a tree walk each. Only set
+    // during deserializeFromFghj; a structural change (rescanNodes) drops it.
+    struct LookupIndex {
+        std::unordered_map<uint32_t, std::shared_ptr<nodes::Node>> nodes{};
+        std::unordered_map<uint32_t, std::shared_ptr<Parameter>> parameters{};
+    };
+    std::optional<LookupIndex> lookupIndex{};
 
+    void buildLookupIndex();
     void scanPartsRecurse(const std::shared_ptr<nodes::Node>& node, bool driversOnly = false);
     void selfSortInternal() { selfSort(); }
     void rebuildRenderTasksInternal(const std::shared_ptr<nodes::Node>& rootNode) { rebuildRenderTasks(rootNode); }
+    void rebuildDirtyTaskSubtrees();
     void drawImmediateFallbackInternal() { drawImmediateFallback(); }
     std::shared_ptr<Parameter> findParameterInternal(uint32_t uuid) { return findParameter(uuid); }
 };
 
 std::shared_ptr<nodes::Node> resolvePuppetNodeById(const std::shared_ptr<Puppet>& puppet, uint32_t uuid);
 
+// Binds `templ` as the template of the instance the calling thread deserializes next
+// (fmt::inInstantiatePuppet): drawables then take the template's MeshData, and parameter bindings
+// its keyframe grids, instead of building their own.
+class ScopedPuppetInstanceTemplate {
+public:
+    explicit ScopedPuppetInstanceTemplate(const Puppet& templ);
+    ~ScopedPuppetInstanceTemplate();
+    ScopedPuppetInstanceTemplate(const ScopedPuppetInstanceTemplate&) = delete;
+    ScopedPuppetInstanceTemplate& operator=(const ScopedPuppetInstanceTemplate&) = delete;
+
+    struct Index;
+
+private:
+    std::unique_ptr<Index> index_;
+    const Index* previous_{nullptr};
+};
+
+// Lookups into the bound template; null when none is bound or it has no match.
+std::shared_ptr<nodes::MeshData> resolveInstanceTemplateMesh(uint32_t uuid, const std::string& typeId);
+std::shared_ptr<param::ParameterBinding> resolveInstanceTemplateBinding(uint32_t paramUuid, const std::string& bindingKey);
+
 } // namespace nicxlive::core
@@ -5,15 +5,67 @@
 
 namespace nicxlive::core::render {
 
-void QueueRenderBackend::clear() { queue.clear(); }
+namespace {
+// Copies the dirty spans into the mirror; a layout change (size mismatch) needs the whole atlas.
+void applySharedRanges(::nicxlive::core::nodes::Vec2Array& mirror,
+                       const ::nicxlive::core::nodes::Vec2Array& src,
+                       const std::vector<SharedVecAtlas::DirtyRange>& ranges,
+                       std::vector<SharedVecAtlas::DirtyRange>& accumulated) {
+    if (mirror.size() != src.size()) {
+        mirror = src.dup();
+        accumulated.assign(1, SharedVecAtlas::DirtyRange{0, src.size()});
+        return;
+    }
+    for (const auto& range : ranges) {
+        const std::size_t end = std::min(range.offset + range.length, src.size());
+        if (range.offset >= end) continue;
+        std::copy(src.dataX() + range.offset, src.dataX() + end, mirror.dataXMutable() + range.offset);
+        std::copy(src.dataY() + range.offset, src.dataY() + end, mirror.dataYMutable() + range.offset);
+    }
+    accumulated.insert(accumulated.end(), ranges.begin(), ranges.end());
+    mergeDirtyRanges(accumulated);
+}
+
+// Shares `data` when it covers width*height*channels; only a short buffer is copied (zero padded).
+::nicxlive::core::TexturePixels fitTexturePixels(const ::nicxlive::core::TexturePixels& data, int width, int height, int channels) {
+    if (!data || data->empty()) return nullptr;
+    auto expected = static_cast<std::size_t>(std::max(0, width)) * static_cast<std::size_t>(std::max(0, height)) * static_cast<std::size_t>(std::max(0, channels));
+    if (data->size() >= expected) return data;
+    auto padded = std::make_shared<std::vector<uint8_t>>(expected, 0);
+    std::copy(data->begin(), data->end(), padded->begin());
+    return padded;
+}
+} // namespace
+
+void QueueRenderBackend::clear() {
+    queue.clear();
+    vertexDirty.clear();
+    uvDirty.clear();
+    deformDirty.clear();
+}
 // resourceQueue は applyTextureCommands 後に caller で明示的に clearResourceQueue される
 void QueueRenderBackend::initializeDrawableResources() {}
 void QueueRenderBackend::bindDrawableVao() {}
-void QueueRenderBackend::createDrawableBuffers(RenderResourceHandle& outHandle) { outHandle = nextIndexId++; }
-void QueueRenderBackend::uploadDrawableIndices(RenderResourceHandle id, const std::vector<uint16_t>& indices) { indexBuffers[id] = indices; }
+void QueueRenderBackend::createDrawableBuffers(RenderResourceHandle& outHandle) {
+    std::lock_guard<std::mutex> lock(resourceMutex);
+    outHandle = nextIndexId++;
+}
+void QueueRenderBackend::uploadDrawableIndices(RenderResourceHandle id, const std::vector<uint16_t>& indices) {
+    std::lock_guard<std::mutex> lock(resourceMutex);
+    indexBuffers[id] = indices;
+}
 void QueueRenderBackend::uploadSharedVertexBuffer(const ::nicxlive::core::nodes::Vec2Array& v) { sharedVertices = v.dup(); }
 void QueueRenderBackend::uploadSharedUvBuffer(const ::nicxlive::core::nodes::Vec2Array& u) { sharedUvs = u.dup(); }
 void QueueRenderBackend::uploadSharedDeformBuffer(const ::nicxlive::core::nodes::Vec2Array& d) { sharedDeform = d.dup(); }
+void QueueRenderBackend::uploadSharedVertexRanges(const ::nicxlive::core::nodes::Vec2Array& v, const std::vector<SharedVecAtlas::DirtyRange>& ranges) {
+    applySharedRanges(sharedVertices, v, ranges, vertexDirty);
+}
+void QueueRenderBackend::uploadSharedUvRanges(const ::nicxlive::core::nodes::Vec2Array& u, const std::vector<SharedVecAtlas::DirtyRange>& ranges) {
+    applySharedRanges(sharedUvs, u, ranges, uvDirty);
+}
+void QueueRenderBackend::uploadSharedDeformRanges(const ::nicxlive::core::nodes::Vec2Array& d, const std::vector<SharedVecAtlas::DirtyRange>& ranges) {
+    applySharedRanges(sharedDeform, d, ranges, deformDirty);
+}
 void QueueRenderBackend::drawDrawableElements(RenderResourceHandle id, std::size_t count) { lastDraw[id] = count; }
 void QueueRenderBackend::setDebugPointSize(float v) { debugPointSize = v; }
 void QueueRenderBackend::setDebugLineWidth(float v) { debugLineWidth = v; }
@@ -115,7 +167,8 @@ bool QueueRenderBackend::fetchDifferenceAggregationResult(DifferenceEvaluationRe
     return false;
 }
 
-uint32_t QueueRenderBackend::createTexture(const std::vector<uint8_t>& data, int width, int height, int channels, bool stencil) {
+uint32_t QueueRenderBackend::createTexture(const ::nicxlive::core::TexturePixels& data, int width, int height, int channels, bool stencil) {
+    std::lock_guard<std::mutex> lock(resourceMutex);
     TextureHandle handle;
     handle.id = nextId++;
     handle.width = width;
@@ -123,13 +176,8 @@ uint32_t QueueRenderBackend::createTexture(const std::vector<uint8_t>& data, int
     handle.inChannels = channels;
     handle.outChannels = channels;
     handle.stencil = stencil;
-    auto expected = static_cast<std::size_t>(std::max(0, width)) * static_cast<std::size_t>(std::max(0, height)) * static_cast<std::size_t>(std::max(0, channels));
-    handle.data.resize(expected);
-    if (!data.empty()) {
-        auto copyLen = std::min(expected, data.size());
-        std::copy_n(data.begin(), copyLen, handle.data.begin());
-        if (copyLen < expected) std::fill(handle.data.begin() + static_cast<std::ptrdiff_t>(copyLen), handle.data.end(), 0);
-    }
+    auto pixels = fitTexturePixels(data, width, height, channels);
+    handle.data = pixels;
     textures[handle.id] = handle;
     TextureCommand cmd;
     cmd.kind = TextureCommandKind::Create;
@@ -139,25 +187,21 @@ uint32_t QueueRenderBackend::createTexture(const std::vector<uint8_t>& data, int
     cmd.inChannels = channels;
     cmd.outChannels = channels;
     cmd.stencil = stencil;
-    cmd.data = handle.data;
+    cmd.data = std::move(pixels);
     resourceQueue.push_back(std::move(cmd));
     return handle.id;
 }
 
-void QueueRenderBackend::updateTexture(uint32_t id, const std::vector<uint8_t>& data, int width, int height, int channels) {
+void QueueRenderBackend::updateTexture(uint32_t id, const ::nicxlive::core::TexturePixels& data, int width, int height, int channels) {
+    std::lock_guard<std::mutex> lock(resourceMutex);
     auto it = textures.find(id);
     if (it == textures.end()) return;
     it->second.width = width;
     it->second.height = height;
     it->second.inChannels = channels;
     it->second.outChannels = channels;
-    auto expected = static_cast<std::size_t>(std::max(0, width)) * static_cast<std::size_t>(std::max(0, height)) * static_cast<std::size_t>(std::max(0, channels));
-    it->second.data.resize(expected);
-    if (!data.empty()) {
-        auto copyLen = std::min(expected, data.size());
-        std::copy_n(data.begin(), copyLen, it->second.data.begin());
-        if (copyLen < expected) std::fill(it->second.data.begin() + static_cast<std::ptrdiff_t>(copyLen), it->second.data.end(), 0);
-    }
+    auto pixels = fitTexturePixels(data, width, height, channels);
+    it->second.data = pixels;
     TextureCommand cmd;
     cmd.kind = TextureCommandKind::Update;
     cmd.id = id;
@@ -165,11 +209,12 @@ void QueueRenderBackend::updateTexture(uint32_t id, const std::vector<uint8_t>&
     cmd.height = height;
     cmd.inChannels = channels;
     cmd.outChannels = channels;
-    cmd.data = it->second.data;
+    cmd.data = std::move(pixels);
     resourceQueue.push_back(std::move(cmd));
 }
 
 void QueueRenderBackend::setTextureParams(uint32_t id, ::nicxlive::core::Filtering filtering, ::nicxlive::core::Wrapping wrapping, float anisotropy) {
+    std::lock_guard<std::mutex> lock(resourceMutex);
     auto it = textures.find(id);
     if (it == textures.end()) return;
     it->second.filtering = filtering;
@@ -185,17 +230,33 @@ void QueueRenderBackend::setTextureParams(uint32_t id, ::nicxlive::core::Filteri
 }
 
 void QueueRenderBackend::disposeTexture(uint32_t id) {
+    std::lock_guard<std::mutex> lock(resourceMutex);
     textures.erase(id);
     TextureCommand cmd;
     cmd.kind = TextureCommandKind::Dispose;
     cmd.id = id;
     resourceQueue.push_back(std::move(cmd));
 }
-bool QueueRenderBackend::hasTexture(uint32_t id) const { return textures.find(id) != textures.end(); }
+bool QueueRenderBackend::hasTexture(uint32_t id) const {
+    std::lock_guard<std::mutex> lock(resourceMutex);
+    return textures.find(id) != textures.end();
+}
 const TextureHandle* QueueRenderBackend::getTexture(uint32_t id) const {
+    std::lock_guard<std::mutex> lock(resourceMutex);
     auto it = textures.find(id);
     if (it == textures.end()) return nullptr;
     return &it->second;
 }
 
+void QueueRenderBackend::takeResourceQueue(std::vector<TextureCommand>& out) {
+    std::lock_guard<std::mutex> lock(resourceMutex);
+    out.clear();
+    out.swap(resourceQueue);
+}
+
+bool QueueRenderBackend::hasPendingResources() const {
+    std::lock_guard<std::mutex> lock(resourceMutex);
+    return !resourceQueue.empty();
+}
+
 } // namespace nicxlive::core::render
@@ -6,6 +6,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include "commands.hpp"
 
@@ -29,7 +30,8 @@ struct TextureHandle {
     int inChannels{0};
     int outChannels{0};
     bool stencil{false};
-    std::vector<uint8_t> data{};
+    // The Texture owns the pixels; the handle only refers to them.
+    std::weak_ptr<const std::vector<uint8_t>> data{};
     ::nicxlive::core::Filtering filtering{::nicxlive::core::Filtering::Linear};
     ::nicxlive::core::Wrapping wrapping{::nicxlive::core::Wrapping::Clamp};
     float anisotropy{1.0f};
@@ -50,7 +52,8 @@ struct TextureCommand {
     int inChannels{0};
     int outChannels{0};
     bool stencil{false};
-    std::vector<uint8_t> data{};
+    // Shares the Texture's buffer until the command is consumed; null when there are no pixels.
+    ::nicxlive::core::TexturePixels data{};
     ::nicxlive::core::Filtering filtering{::nicxlive::core::Filtering::Linear};
     ::nicxlive::core::Wrapping wrapping{::nicxlive::core::Wrapping::Clamp};
     float anisotropy{1.0f};
@@ -66,6 +69,9 @@ public:
     void uploadSharedVertexBuffer(const ::nicxlive::core::common::Vec2Array& v) override;
     void uploadSharedUvBuffer(const ::nicxlive::core::common::Vec2Array& u) override;
     void uploadSharedDeformBuffer(const ::nicxlive::core::common::Vec2Array& d) override;
+    void uploadSharedVertexRanges(const ::nicxlive::core::common::Vec2Array& v, const std::vector<SharedVecAtlas::DirtyRange>& ranges) override;
+    void uploadSharedUvRanges(const ::nicxlive::core::common::Vec2Array& u, const std::vector<SharedVecAtlas::DirtyRange>& ranges) override;
+    void uploadSharedDeformRanges(const ::nicxlive::core::common::Vec2Array& d, const std::vector<SharedVecAtlas::DirtyRange>& ranges) override;
     void drawDrawableElements(RenderResourceHandle id, std::size_t count) override;
     void setDebugPointSize(float v) override;
     void setDebugLineWidth(float v) override;
@@ -101,15 +107,22 @@ public:
     bool evaluateDifferenceAggregation(RenderResourceHandle, int, int) override;
     bool fetchDifferenceAggregationResult(DifferenceEvaluationResult& out) override;
 
-    uint32_t createTexture(const std::vector<uint8_t>& data, int width, int height, int channels, bool stencil) override;
-    void updateTexture(uint32_t id, const std::vector<uint8_t>& data, int width, int height, int channels) override;
+    uint32_t createTexture(const ::nicxlive::core::TexturePixels& data, int width, int height, int channels, bool stencil) override;
+    void updateTexture(uint32_t id, const ::nicxlive::core::TexturePixels& data, int width, int height, int channels) override;
     void setTextureParams(uint32_t id, ::nicxlive::core::Filtering filtering, ::nicxlive::core::Wrapping wrapping, float anisotropy) override;
     void disposeTexture(uint32_t id) override;
     bool hasTexture(uint32_t id) const;
     const TextureHandle* getTexture(uint32_t id) const;
+    // Moves pending texture commands out under the resource lock (puppets may tick on other threads).
+    void takeResourceQueue(std::vector<TextureCommand>& out);
+    bool hasPendingResources() const;
     // Unity DLL 側に受け渡すためのコピー出力
     std::vector<QueuedCommand> queue{};
     std::vector<TextureCommand> resourceQueue{};
+    // Atlas spans uploaded since the last clear(), sorted and merged (the host mirrors these).
+    const std::vector<SharedVecAtlas::DirtyRange>& sharedVertexDirtyRanges() const { return vertexDirty; }
+    const std::vector<SharedVecAtlas::DirtyRange>& sharedUvDirtyRanges() const { return uvDirty; }
+    const std::vector<SharedVecAtlas::DirtyRange>& sharedDeformDirtyRanges() const { return deformDirty; }
 
     // キューを別 backend に再生（D: RenderingBackend.playback 相当）
     void setRenderTargets(std::size_t renderHandle, std::size_t compositeHandle) {
@@ -118,18 +131,23 @@ public:
     }
 
     const std::vector<uint16_t>* getDrawableIndices(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(resourceMutex);
         auto it = indexBuffers.find(id);
         if (it == indexBuffers.end()) return nullptr;
         return &it->second;
     }
     bool hasDrawableIndices(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(resourceMutex);
         return indexBuffers.find(id) != indexBuffers.end();
     }
     std::size_t drawableIndexBufferCount() const {
+        std::lock_guard<std::mutex> lock(resourceMutex);
         return indexBuffers.size();
     }
 
 private:
+    // Guards textures/indexBuffers/resourceQueue; the command queue itself is only touched while drawing.
+    mutable std::mutex resourceMutex{};
     uint32_t nextId{1};
     RenderResourceHandle nextIndexId{1};
     std::map<uint32_t, TextureHandle> textures{};
@@ -137,6 +155,9 @@ private:
     ::nicxlive::core::common::Vec2Array sharedVertices{};
     ::nicxlive::core::common::Vec2Array sharedUvs{};
     ::nicxlive::core::common::Vec2Array sharedDeform{};
+    std::vector<SharedVecAtlas::DirtyRange> vertexDirty{};
+    std::vector<SharedVecAtlas::DirtyRange> uvDirty{};
+    std::vector<SharedVecAtlas::DirtyRange> deformDirty{};
     std::vector<Vec3> debugPositions{};
     std::vector<uint16_t> debugIndices{};
     std::map<RenderResourceHandle, std::size_t> lastDraw{};
@@ -276,36 +276,25 @@ bool QueueCommandEmitter::tryMakeMaskApplyPacket(const std::shared_ptr<nodes::Dr
 
 void QueueCommandEmitter::uploadSharedBuffers() {
     if (!activeBackend_) return;
-    using ::nicxlive::core::render::sharedDeformBufferData;
-    using ::nicxlive::core::render::sharedDeformBufferDirty;
-    using ::nicxlive::core::render::sharedDeformMarkUploaded;
-    using ::nicxlive::core::render::sharedVertexBufferData;
-    using ::nicxlive::core::render::sharedVertexBufferDirty;
-    using ::nicxlive::core::render::sharedVertexMarkUploaded;
-    using ::nicxlive::core::render::sharedUvBufferData;
-    using ::nicxlive::core::render::sharedUvBufferDirty;
-    using ::nicxlive::core::render::sharedUvMarkUploaded;
+    auto buffers = currentSharedBufferSet();
 
-    if (sharedVertexBufferDirty()) {
-        auto& vertices = sharedVertexBufferData();
-        if (vertices.size()) {
-            activeBackend_->uploadSharedVertexBuffer(vertices);
+    if (buffers->vertex.isDirty()) {
+        auto ranges = buffers->vertex.takeDirtyRanges();
+        if (!ranges.empty()) {
+            activeBackend_->uploadSharedVertexRanges(buffers->vertex.data(), ranges);
         }
-        sharedVertexMarkUploaded();
     }
-    if (sharedUvBufferDirty()) {
-        auto& uvs = sharedUvBufferData();
-        if (uvs.size()) {
-            activeBackend_->uploadSharedUvBuffer(uvs);
+    if (buffers->uv.isDirty()) {
+        auto ranges = buffers->uv.takeDirtyRanges();
+        if (!ranges.empty()) {
+            activeBackend_->uploadSharedUvRanges(buffers->uv.data(), ranges);
         }
-        sharedUvMarkUploaded();
     }
-    if (sharedDeformBufferDirty()) {
-        auto& deform = sharedDeformBufferData();
-        if (deform.size()) {
-            activeBackend_->uploadSharedDeformBuffer(deform);
+    if (buffers->deform.isDirty()) {
+        auto ranges = buffers->deform.takeDirtyRanges();
+        if (!ranges.empty()) {
+            activeBackend_->uploadSharedDeformRanges(buffers->deform.data(), ranges);
         }
-        sharedDeformMarkUploaded();
     }
 }
 
@@ -1,17 +1,37 @@
 #include "common.hpp"
 
+#include <mutex>
+
 namespace nicxlive::core {
 
 namespace {
+std::mutex gCurrentBackendMutex;
 std::shared_ptr<RenderBackend> gCurrentBackend{};
+thread_local std::shared_ptr<RenderBackend> tThreadBackend{};
+thread_local bool tThreadBackendBound{false};
 }
 
 std::shared_ptr<RenderBackend> getCurrentRenderBackend() {
+    if (tThreadBackendBound) return tThreadBackend;
+    std::lock_guard<std::mutex> lock(gCurrentBackendMutex);
     return gCurrentBackend;
 }
 
 void setCurrentRenderBackend(const std::shared_ptr<RenderBackend>& backend) {
+    if (tThreadBackendBound) tThreadBackend = backend;
+    std::lock_guard<std::mutex> lock(gCurrentBackendMutex);
     gCurrentBackend = backend;
 }
 
+ScopedRenderBackend::ScopedRenderBackend(const std::shared_ptr<RenderBackend>& backend)
+    : previous_(tThreadBackend), hadPrevious_(tThreadBackendBound) {
+    tThreadBackend = backend;
+    tThreadBackendBound = true;
+}
+
+ScopedRenderBackend::~ScopedRenderBackend() {
+    tThreadBackend = std::move(previous_);
+    tThreadBackendBound = hadPrevious_;
+}
+
 } // namespace nicxlive::core
@@ -6,6 +6,7 @@
 #include "../nodes/projectable.hpp"
 #include "../texture.hpp"
 #include "part_draw_packet.hpp"
+#include "shared_deform_buffer.hpp"
 
 #include <array>
 #include <algorithm>
@@ -88,6 +89,20 @@ public:
     virtual void uploadSharedVertexBuffer(const ::nicxlive::core::common::Vec2Array&) {}
     virtual void uploadSharedUvBuffer(const ::nicxlive::core::common::Vec2Array&) {}
     virtual void uploadSharedDeformBuffer(const ::nicxlive::core::common::Vec2Array&) {}
+    // Partial uploads: ranges are sorted, merged element spans of the atlas that changed since the
+    // last upload. Backends without sub-range updates fall back to a full upload.
+    virtual void uploadSharedVertexRanges(const ::nicxlive::core::common::Vec2Array& v,
+                                          const std::vector<render::SharedVecAtlas::DirtyRange>&) {
+        uploadSharedVertexBuffer(v);
+    }
+    virtual void uploadSharedUvRanges(const ::nicxlive::core::common::Vec2Array& u,
+                                      const std::vector<render::SharedVecAtlas::DirtyRange>&) {
+        uploadSharedUvBuffer(u);
+    }
+    virtual void uploadSharedDeformRanges(const ::nicxlive::core::common::Vec2Array& d,
+                                          const std::vector<render::SharedVecAtlas::DirtyRange>&) {
+        uploadSharedDeformBuffer(d);
+    }
     virtual void drawDrawableElements(RenderResourceHandle /*id*/, std::size_t /*count*/) {}
     virtual void setDebugPointSize(float) {}
     virtual void setDebugLineWidth(float) {}
@@ -99,8 +114,8 @@ public:
     virtual void beginMaskContent() {}
     virtual void endMask() {}
     // Resource ops (D queue backend 用)
-    virtual uint32_t createTexture(const std::vector<uint8_t>& /*data*/, int /*width*/, int /*height*/, int /*channels*/, bool /*stencil*/) { return 0; }
-    virtual void updateTexture(uint32_t /*id*/, const std::vector<uint8_t>& /*data*/, int /*width*/, int /*height*/, int /*channels*/) {}
+    virtual uint32_t createTexture(const TexturePixels& /*data*/, int /*width*/, int /*height*/, int /*channels*/, bool /*stencil*/) { return 0; }
+    virtual void updateTexture(uint32_t /*id*/, const TexturePixels& /*data*/, int /*width*/, int /*height*/, int /*channels*/) {}
     virtual void setTextureParams(uint32_t /*id*/, ::nicxlive::core::Filtering /*filtering*/, ::nicxlive::core::Wrapping /*wrapping*/, float /*anisotropy*/) {}
     virtual void disposeTexture(uint32_t /*id*/) {}
     virtual void beginDynamicComposite(const DynamicCompositePass& /*pass*/) {}
@@ -171,8 +186,8 @@ public:
     virtual void beginDynamicComposite(const std::shared_ptr<nodes::Projectable>& /*composite*/, const DynamicCompositePass& /*pass*/) {}
     virtual void endDynamicComposite(const std::shared_ptr<nodes::Projectable>& /*composite*/, const DynamicCompositePass& /*pass*/) {}
     // Resource ops (queue backend再生用)
-    virtual uint32_t createTexture(const std::vector<uint8_t>& /*data*/, int /*width*/, int /*height*/, int /*channels*/, bool /*stencil*/) { return 0; }
-    virtual void updateTexture(uint32_t /*id*/, const std::vector<uint8_t>& /*data*/, int /*width*/, int /*height*/, int /*channels*/) {}
+    virtual uint32_t createTexture(const TexturePixels& /*data*/, int /*width*/, int /*height*/, int /*channels*/, bool /*stencil*/) { return 0; }
+    virtual void updateTexture(uint32_t /*id*/, const TexturePixels& /*data*/, int /*width*/, int /*height*/, int /*channels*/) {}
     virtual void setTextureParams(uint32_t /*id*/, ::nicxlive::core::Filtering /*filtering*/, ::nicxlive::core::Wrapping /*wrapping*/, float /*anisotropy*/) {}
     virtual void disposeTexture(uint32_t /*id*/) {}
     virtual void drawPart(const std::shared_ptr<nodes::Part>& part, bool isMask) {
@@ -199,4 +214,18 @@ struct DynamicCompositePass {
 std::shared_ptr<RenderBackend> getCurrentRenderBackend();
 void setCurrentRenderBackend(const std::shared_ptr<RenderBackend>& backend);
 
+// Binds a backend as "current" for the calling thread only, so puppets owned by
+// different renderers can tick/draw concurrently without stealing each other's backend.
+class ScopedRenderBackend {
+public:
+    explicit ScopedRenderBackend(const std::shared_ptr<RenderBackend>& backend);
+    ~ScopedRenderBackend();
+    ScopedRenderBackend(const ScopedRenderBackend&) = delete;
+    ScopedRenderBackend& operator=(const ScopedRenderBackend&) = delete;
+
+private:
+    std::shared_ptr<RenderBackend> previous_{};
+    bool hadPrevious_{false};
+};
+
 } // namespace nicxlive::core
@@ -3,6 +3,7 @@
 
 #include <chrono>
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -14,29 +15,29 @@ namespace nicxlive::core::render {
 
 namespace {
 bool profileEnabled() {
-    static int enabled = -1;
-    if (enabled >= 0) return enabled != 0;
-    const char* v = std::getenv("NJCX_PROFILE");
-    if (!v) {
-        enabled = 0;
-        return false;
-    }
-    enabled = (std::strcmp(v, "1") == 0 || std::strcmp(v, "true") == 0 || std::strcmp(v, "TRUE") == 0) ? 1 : 0;
-    return enabled != 0;
+    // Read once; scopes are opened from pool threads too.
+    static const bool enabled = [] {
+        const char* v = std::getenv("NJCX_PROFILE");
+        return v && (std::strcmp(v, "1") == 0 || std::strcmp(v, "true") == 0 || std::strcmp(v, "TRUE") == 0);
+    }();
+    return enabled;
 }
 
 struct RenderProfiler {
+    std::mutex mutex{};
     std::map<std::string, long long> accumUsec{};
     std::map<std::string, std::size_t> callCounts{};
     std::chrono::steady_clock::time_point lastReport{};
     std::size_t frameCount{0};
 
     void addSample(const std::string& label, std::chrono::steady_clock::duration sample) {
+        std::lock_guard<std::mutex> lock(mutex);
         accumUsec[label] += std::chrono::duration_cast<std::chrono::microseconds>(sample).count();
         callCounts[label] += 1;
     }
 
     void frameCompleted() {
+        std::lock_guard<std::mutex> lock(mutex);
         frameCount++;
         auto now = std::chrono::steady_clock::now();
         if (lastReport.time_since_epoch().count() == 0) {
@@ -88,7 +89,18 @@ RenderProfiler& profiler() {
 } // namespace
 
 RenderProfileScope::RenderProfileScope(const std::string& label)
-    : label_(label), active_(profileEnabled()), start_(std::chrono::steady_clock::now()) {}
+    : active_(profileEnabled()) {
+    if (!active_) return;
+    label_ = label;
+    start_ = std::chrono::steady_clock::now();
+}
+
+RenderProfileScope::RenderProfileScope(const char* label)
+    : active_(profileEnabled()) {
+    if (!active_) return;
+    label_ = label;
+    start_ = std::chrono::steady_clock::now();
+}
 
 RenderProfileScope::RenderProfileScope(RenderProfileScope&& other) noexcept
     : label_(std::move(other.label_)), active_(other.active_), start_(other.start_) {
@@ -119,6 +131,12 @@ RenderProfileScope profileScope(const std::string& label) {
     return RenderProfileScope(label);
 }
 
+RenderProfileScope profileScope(const char* label) {
+    return RenderProfileScope(label);
+}
+
+bool renderProfilingEnabled() { return profileEnabled(); }
+
 void renderProfilerFrameCompleted() {
     profiler().frameCompleted();
 }
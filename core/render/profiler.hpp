@@ -7,6 +7,8 @@ namespace nicxlive::core::render {
 
 struct RenderProfileScope {
     explicit RenderProfileScope(const std::string& label);
+    // Touches neither the label nor the clock while profiling is off.
+    explicit RenderProfileScope(const char* label);
     RenderProfileScope(const RenderProfileScope&) = delete;
     RenderProfileScope& operator=(const RenderProfileScope&) = delete;
     RenderProfileScope(RenderProfileScope&& other) noexcept;
@@ -21,6 +23,9 @@ private:
 };
 
 RenderProfileScope profileScope(const std::string& label);
+RenderProfileScope profileScope(const char* label);
+// NJCX_PROFILE=1; lets hot paths skip building a scope at all.
+bool renderProfilingEnabled();
 void renderProfilerFrameCompleted();
 
 } // namespace nicxlive::core::render
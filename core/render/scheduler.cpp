@@ -2,6 +2,10 @@
 #include "profiler.hpp"
 #include "graph_builder.hpp"
 #include "common.hpp"
+#include "../worker_pool.hpp"
+#include "../nodes/node.hpp"
+#include <algorithm>
+#include <functional>
 #include <string>
 
 namespace nicxlive::core {
@@ -36,50 +40,341 @@ const char* taskKindLabel(TaskKind kind) {
     default: return "UnknownKind";
     }
 }
-} // namespace
 
-TaskScheduler::TaskScheduler() {
-    orderSequence_ = {TaskOrder::Init, TaskOrder::Parameters, TaskOrder::PreProcess, TaskOrder::Dynamic,
-                      TaskOrder::Post0, TaskOrder::Post1, TaskOrder::Post2, TaskOrder::Final,
-                      TaskOrder::RenderBegin, TaskOrder::Render, TaskOrder::RenderEnd};
-    for (auto order : orderSequence_) queues_[order] = {};
+constexpr std::size_t kOrderSlots = static_cast<std::size_t>(TaskOrder::Final) + 1;
+constexpr std::size_t kKindSlots = static_cast<std::size_t>(TaskKind::Finalize) + 1;
+
+// Built once; tasks keep pointers into it.
+const std::string* internTaskLabel(TaskOrder order, TaskKind kind) {
+    static const auto labels = [] {
+        std::array<std::array<std::string, kKindSlots>, kOrderSlots> table{};
+        for (std::size_t o = 0; o < kOrderSlots; ++o) {
+            for (std::size_t k = 0; k < kKindSlots; ++k) {
+                table[o][k] = std::string("Task.") + taskOrderLabel(static_cast<TaskOrder>(o)) + "." +
+                              taskKindLabel(static_cast<TaskKind>(k));
+            }
+        }
+        return table;
+    }();
+    return &labels[static_cast<std::size_t>(order)][static_cast<std::size_t>(kind)];
 }
 
+constexpr auto kStageOfOrder = [] {
+    std::array<std::size_t, kOrderSlots> stages{};
+    for (std::size_t i = 0; i < TaskScheduler::kOrderSequence.size(); ++i) {
+        stages[static_cast<std::size_t>(TaskScheduler::kOrderSequence[i])] = i;
+    }
+    return stages;
+}();
+
+std::size_t stageOf(TaskOrder order) { return kStageOfOrder[static_cast<std::size_t>(order)]; }
+} // namespace
+
 void TaskScheduler::clearTasks() {
-    for (auto order : orderSequence_) {
-        queues_[order].clear();
+    tasks_.clear();
+    stageBegin_.fill(0);
+    pending_.clear();
+    pendingCount_.fill(0);
+    handlers_.clear();
+    freeHandlers_.clear();
+    spans_.clear();
+}
+
+void TaskScheduler::addTask(TaskOrder order, TaskKind kind, TaskHandler handler, const TaskAccessProvider* access) {
+    if (!handler) return;
+    Task task{order, kind, TaskOp::Handler};
+    task.access = access;
+    if (!freeHandlers_.empty()) {
+        task.handler = freeHandlers_.back();
+        freeHandlers_.pop_back();
+        handlers_[task.handler] = std::move(handler);
+    } else {
+        task.handler = static_cast<std::uint32_t>(handlers_.size());
+        handlers_.push_back(std::move(handler));
+    }
+    ++pendingCount_[stageOf(order)];
+    pending_.push_back(task);
+}
+
+void TaskScheduler::addNodeTask(TaskOrder order, TaskKind kind, nodes::Node* node) {
+    if (!node) return;
+    TaskOp op = TaskOp::Begin;
+    switch (order) {
+    case TaskOrder::Init: op = TaskOp::Begin; break;
+    case TaskOrder::PreProcess: op = TaskOp::PreProcess; break;
+    case TaskOrder::Dynamic: op = TaskOp::Dynamic; break;
+    case TaskOrder::Post0: op = TaskOp::Post0; break;
+    case TaskOrder::Post1: op = TaskOp::Post1; break;
+    case TaskOrder::Post2: op = TaskOp::Post2; break;
+    case TaskOrder::Final: op = TaskOp::Final; break;
+    case TaskOrder::RenderBegin: op = TaskOp::RenderBegin; break;
+    case TaskOrder::Render: op = TaskOp::Render; break;
+    case TaskOrder::RenderEnd: op = TaskOp::RenderEnd; break;
+    default: return; // nodes have no Parameters entry point
+    }
+    Task task{order, kind, op};
+    task.node = node;
+    task.access = node;
+    ++pendingCount_[stageOf(order)];
+    pending_.push_back(task);
+}
+
+std::uint32_t TaskScheduler::nextStagePosition(std::size_t stage) const {
+    const auto base = splicing_ ? spliceOrigin_[stage] : static_cast<std::uint32_t>(stageBegin_[stage + 1] - stageBegin_[stage]);
+    return base + pendingCount_[stage];
+}
+
+void TaskScheduler::addSubtree(nodes::Node* node) {
+    if (!node) return;
+    auto& spans = splicing_ ? spliceSpans_ : spans_;
+    const auto index = static_cast<std::uint32_t>(spans.size());
+    SubtreeSpan span;
+    span.node = node;
+    span.parent = openSpans_.empty() ? kNoSpan : openSpans_.back();
+    for (std::size_t stage = 0; stage < kStageCount; ++stage) span.begin[stage] = nextStagePosition(stage);
+    spans.push_back(span);
+    openSpans_.push_back(index);
+    node->registerRenderTasks(*this);
+    openSpans_.pop_back();
+    auto& done = spans[index];
+    done.size = static_cast<std::uint32_t>(spans.size()) - index;
+    for (std::size_t stage = 0; stage < kStageCount; ++stage) done.end[stage] = nextStagePosition(stage);
+}
+
+std::size_t TaskScheduler::rebuildSubtrees(std::vector<nodes::Node*> nodes) {
+    if (nodes.empty() || spans_.empty()) return 0;
+    compile();
+    std::sort(nodes.begin(), nodes.end(), std::less<nodes::Node*>{});
+    std::vector<std::uint32_t> found;
+    for (std::uint32_t i = 0; i < spans_.size(); ++i) {
+        if (std::binary_search(nodes.begin(), nodes.end(), spans_[i].node, std::less<nodes::Node*>{})) {
+            found.push_back(i);
+            i += spans_[i].size - 1; // rebuilt whole, nested records included
+        }
+    }
+    // Back to front: a splice only moves what comes after it.
+    for (auto it = found.rbegin(); it != found.rend(); ++it) rebuildSubtree(*it);
+    return found.size();
+}
+
+void TaskScheduler::rebuildSubtree(std::uint32_t index) {
+    const SubtreeSpan old = spans_[index];
+    splicing_ = true;
+    spliceOrigin_ = old.begin;
+    spliceSpans_.clear();
+    addSubtree(old.node);
+    splicing_ = false;
+
+    std::array<std::size_t, kStageCount + 1> fresh{};
+    for (const auto& task : pending_) ++fresh[stageOf(task.order) + 1];
+    for (std::size_t i = 1; i < fresh.size(); ++i) fresh[i] += fresh[i - 1];
+    spliceTasks_.resize(pending_.size());
+    {
+        auto cursor = fresh;
+        for (auto& task : pending_) {
+            task.label = internTaskLabel(task.order, task.kind);
+            spliceTasks_[cursor[stageOf(task.order)]++] = task;
+        }
+    }
+    pending_.clear();
+    pendingCount_.fill(0);
+
+    // Stage by stage, back to front so earlier stages keep their offsets: overwrite the common
+    // length in place and insert or erase only the difference. Counts are unsigned, so `shift`
+    // wraps for shrinking ranges and adding it still lands on the right index.
+    std::array<std::uint32_t, kStageCount> shift{};
+    for (std::size_t stage = kStageCount; stage-- > 0;) {
+        const std::size_t oldCount = old.end[stage] - old.begin[stage];
+        const std::size_t newCount = fresh[stage + 1] - fresh[stage];
+        shift[stage] = static_cast<std::uint32_t>(newCount - oldCount);
+        const auto first = static_cast<std::ptrdiff_t>(stageBegin_[stage] + old.begin[stage]);
+        for (std::size_t i = 0; i < oldCount; ++i) {
+            const auto& task = tasks_[static_cast<std::size_t>(first) + i];
+            if (task.op != TaskOp::Handler) continue;
+            handlers_[task.handler] = nullptr;
+            freeHandlers_.push_back(task.handler);
+        }
+        const auto src = spliceTasks_.begin() + static_cast<std::ptrdiff_t>(fresh[stage]);
+        const auto common = static_cast<std::ptrdiff_t>(std::min(oldCount, newCount));
+        std::copy(src, src + common, tasks_.begin() + first);
+        if (newCount > oldCount) {
+            tasks_.insert(tasks_.begin() + first + common, src + common, src + static_cast<std::ptrdiff_t>(newCount));
+        } else if (newCount < oldCount) {
+            tasks_.erase(tasks_.begin() + first + common, tasks_.begin() + first + static_cast<std::ptrdiff_t>(oldCount));
+        }
+    }
+    std::ptrdiff_t moved = 0;
+    for (std::size_t stage = 0; stage < kStageCount; ++stage) {
+        moved += static_cast<std::ptrdiff_t>(fresh[stage + 1] - fresh[stage]) -
+                 static_cast<std::ptrdiff_t>(old.end[stage] - old.begin[stage]);
+        stageBegin_[stage + 1] = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(stageBegin_[stage + 1]) + moved);
+    }
+
+    // Records: later subtrees move by the stage shifts, ancestors grow by them, and the subtree's
+    // own records are replaced by the fresh ones.
+    const auto oldSize = old.size;
+    const auto newSize = static_cast<std::uint32_t>(spliceSpans_.size());
+    const std::uint32_t oldTail = index + oldSize;
+    for (std::size_t i = oldTail; i < spans_.size(); ++i) {
+        auto& span = spans_[i];
+        for (std::size_t stage = 0; stage < kStageCount; ++stage) {
+            span.begin[stage] += shift[stage];
+            span.end[stage] += shift[stage];
+        }
+        if (span.parent != kNoSpan && span.parent >= oldTail) span.parent += newSize - oldSize;
+    }
+    for (auto p = old.parent; p != kNoSpan; p = spans_[p].parent) {
+        auto& span = spans_[p];
+        span.size += newSize - oldSize;
+        for (std::size_t stage = 0; stage < kStageCount; ++stage) span.end[stage] += shift[stage];
+    }
+    for (auto& span : spliceSpans_) span.parent = span.parent == kNoSpan ? old.parent : span.parent + index;
+    const auto common = std::min(oldSize, newSize);
+    std::copy(spliceSpans_.begin(), spliceSpans_.begin() + common, spans_.begin() + index);
+    if (newSize > oldSize) {
+        spans_.insert(spans_.begin() + oldTail, spliceSpans_.begin() + common, spliceSpans_.end());
+    } else if (newSize < oldSize) {
+        spans_.erase(spans_.begin() + index + newSize, spans_.begin() + oldTail);
+    }
+}
+
+void TaskScheduler::compile() {
+    if (pending_.empty()) return;
+    // Stable counting sort of [compiled..., pending...] by stage keeps submission order per stage.
+    std::vector<Task> merged;
+    merged.reserve(tasks_.size() + pending_.size());
+    merged.insert(merged.end(), tasks_.begin(), tasks_.end());
+    merged.insert(merged.end(), pending_.begin(), pending_.end());
+    pending_.clear();
+    pendingCount_.fill(0);
+
+    stageBegin_.fill(0);
+    for (const auto& task : merged) ++stageBegin_[stageOf(task.order) + 1];
+    for (std::size_t i = 1; i < stageBegin_.size(); ++i) stageBegin_[i] += stageBegin_[i - 1];
+    tasks_.resize(merged.size());
+    auto cursor = stageBegin_;
+    for (auto& task : merged) {
+        task.label = internTaskLabel(task.order, task.kind);
+        tasks_[cursor[stageOf(task.order)]++] = task;
+    }
+}
+
+void TaskScheduler::dispatch(RenderContext& ctx, const Task& task) {
+    switch (task.op) {
+    case TaskOp::Handler: handlers_[task.handler](ctx); break;
+    case TaskOp::Begin: task.node->runBeginTask(ctx); break;
+    case TaskOp::PreProcess: task.node->runPreProcessTask(ctx); break;
+    case TaskOp::Dynamic: task.node->runDynamicTask(ctx); break;
+    case TaskOp::Post0: task.node->runPostTaskImpl(0, ctx); break;
+    case TaskOp::Post1: task.node->runPostTaskImpl(1, ctx); break;
+    case TaskOp::Post2: task.node->runPostTaskImpl(2, ctx); break;
+    case TaskOp::Final: task.node->runFinalTask(ctx); break;
+    case TaskOp::RenderBegin: task.node->runRenderBeginTask(ctx); break;
+    case TaskOp::Render: task.node->runRenderTask(ctx); break;
+    case TaskOp::RenderEnd: task.node->runRenderEndTask(ctx); break;
     }
 }
 
-void TaskScheduler::addTask(TaskOrder order, TaskKind kind, TaskHandler handler) {
-    queues_[order].push_back(Task{order, kind, std::move(handler)});
+void TaskScheduler::runTask(RenderContext& ctx, const Task& task, bool profiling) {
+    if (!profiling) {
+        dispatch(ctx, task);
+        return;
+    }
+    auto scope = render::profileScope(*task.label);
+    dispatch(ctx, task);
 }
 
 void TaskScheduler::executeRange(RenderContext& ctx, TaskOrder startOrder, TaskOrder endOrder) {
-    for (auto order : orderSequence_) {
+    compile();
+    const bool profiling = render::renderProfilingEnabled();
+    const bool parallel = pool_ && pool_->threadCount() > 1;
+    for (std::size_t stage = 0; stage < kOrderSequence.size(); ++stage) {
+        const auto order = kOrderSequence[stage];
         if (static_cast<int>(order) < static_cast<int>(startOrder)) continue;
         if (static_cast<int>(order) > static_cast<int>(endOrder)) break;
-        auto& tasks = queues_[order];
-        for (auto& task : tasks) {
-            if (task.handler) {
-                auto label = std::string("Task.") + taskOrderLabel(order) + "." + taskKindLabel(task.kind);
-                auto profiling = render::profileScope(label.c_str());
-                task.handler(ctx);
-            }
+        const Task* tasks = tasks_.data() + stageBegin_[stage];
+        const std::size_t count = stageBegin_[stage + 1] - stageBegin_[stage];
+        if (parallel && count > 1) {
+            executeStageParallel(ctx, order, tasks, count, profiling);
+            continue;
         }
+        for (std::size_t i = 0; i < count; ++i) runTask(ctx, tasks[i], profiling);
     }
 }
 
-std::size_t TaskScheduler::taskCount(TaskOrder order) const {
-    auto it = queues_.find(order);
-    if (it == queues_.end()) return 0;
-    return it->second.size();
+// Each task goes one wave after the latest earlier task it conflicts with, so conflicting tasks
+// keep their submission order and every wave is a set of mutually independent tasks. A task
+// without an access set is a barrier: it gets a wave of its own and nothing moves across it.
+void TaskScheduler::executeStageParallel(RenderContext& ctx, TaskOrder order, const Task* tasks, std::size_t count,
+                                         bool profiling) {
+    keyWaves_.clear();
+    taskWave_.assign(count, 0);
+    std::size_t floorWave = 0;
+    std::size_t lastWave = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& task = tasks[i];
+        access_.reads.clear();
+        access_.writes.clear();
+        if (!task.access || !task.access->describeTaskAccess(order, access_)) {
+            floorWave = ++lastWave;
+            taskWave_[i] = floorWave;
+            // Everything after a barrier is past every recorded wave; clear() walks all buckets.
+            if (!keyWaves_.empty()) keyWaves_.clear();
+            continue;
+        }
+        std::size_t wave = floorWave;
+        for (const void* key : access_.reads) {
+            auto it = keyWaves_.find(key);
+            if (it != keyWaves_.end()) wave = std::max(wave, it->second.lastWrite);
+        }
+        for (const void* key : access_.writes) {
+            auto it = keyWaves_.find(key);
+            if (it != keyWaves_.end()) wave = std::max({wave, it->second.lastWrite, it->second.lastRead});
+        }
+        ++wave;
+        for (const void* key : access_.reads) {
+            auto& state = keyWaves_[key];
+            state.lastRead = std::max(state.lastRead, wave);
+        }
+        for (const void* key : access_.writes) keyWaves_[key].lastWrite = wave;
+        taskWave_[i] = wave;
+        lastWave = std::max(lastWave, wave);
+    }
+
+    // Bucket by wave; within a wave tasks stay in submission order.
+    waveStart_.assign(lastWave + 2, 0);
+    for (auto wave : taskWave_) {
+        if (wave) ++waveStart_[wave + 1];
+    }
+    for (std::size_t w = 1; w < waveStart_.size(); ++w) waveStart_[w] += waveStart_[w - 1];
+    waveTasks_.resize(waveStart_.back());
+    {
+        auto cursor = waveStart_;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (taskWave_[i]) waveTasks_[cursor[taskWave_[i]]++] = i;
+        }
+    }
+
+    for (std::size_t wave = 1; wave <= lastWave; ++wave) {
+        const std::size_t begin = waveStart_[wave];
+        const std::size_t size = waveStart_[wave + 1] - begin;
+        if (size == 1) {
+            runTask(ctx, tasks[waveTasks_[begin]], profiling);
+            continue;
+        }
+        pool_->parallelFor(size, [&](std::size_t i) { runTask(ctx, tasks[waveTasks_[begin + i]], profiling); });
+    }
 }
 
-std::size_t TaskScheduler::totalTaskCount() const {
-    std::size_t total = 0;
-    for (const auto& kv : queues_) total += kv.second.size();
-    return total;
+std::size_t TaskScheduler::taskCount(TaskOrder order) const {
+    const std::size_t stage = stageOf(order);
+    std::size_t count = stageBegin_[stage + 1] - stageBegin_[stage];
+    for (const auto& task : pending_) {
+        if (task.order == order) ++count;
+    }
+    return count;
 }
 
+std::size_t TaskScheduler::totalTaskCount() const { return tasks_.size() + pending_.size(); }
+
 } // namespace nicxlive::core
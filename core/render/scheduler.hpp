@@ -1,13 +1,21 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <functional>
-#include <map>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+namespace nicxlive::core::nodes {
+class Node;
+} // namespace nicxlive::core::nodes
+
 namespace nicxlive::core {
 
 class RenderContext;
+class WorkerPool;
 
 enum class TaskOrder : int {
     Init = 1,
@@ -35,26 +43,132 @@ enum class TaskKind {
 
 using TaskHandler = std::function<void(RenderContext&)>;
 
+// What one task touches, as opaque identities (a node, a deformation buffer). Two tasks of a stage
+// conflict when one writes a key the other reads or writes; conflicting tasks keep submission order.
+struct TaskAccess {
+    std::vector<const void*> reads{};
+    std::vector<const void*> writes{};
+};
+
+// Implemented by task owners that can state a task's access set. Asked every time a stage runs
+// in parallel, so the answer may follow state that changes between frames (filters, hooks).
+class TaskAccessProvider {
+public:
+    virtual ~TaskAccessProvider() = default;
+    // Returning false means "unknown": the task runs alone, after everything submitted before it
+    // and before everything submitted after it.
+    virtual bool describeTaskAccess(TaskOrder order, TaskAccess& access) const = 0;
+};
+
+// What a task runs: one of a node's stage entry points, or a registered handler.
+enum class TaskOp : std::uint8_t {
+    Handler,
+    Begin,
+    PreProcess,
+    Dynamic,
+    Post0,
+    Post1,
+    Post2,
+    Final,
+    RenderBegin,
+    Render,
+    RenderEnd,
+};
+
 struct Task {
     TaskOrder order;
     TaskKind kind;
-    TaskHandler handler;
+    TaskOp op;
+    nodes::Node* node{nullptr};
+    // Index into the scheduler's handlers (op == Handler).
+    std::uint32_t handler{0};
+    const TaskAccessProvider* access{nullptr};
+    // Interned "Task.<order>.<kind>"; read only while profiling.
+    const std::string* label{nullptr};
 };
 
 class TaskScheduler {
 public:
-    TaskScheduler();
-
     void clearTasks();
-    void addTask(TaskOrder order, TaskKind kind, TaskHandler handler);
+    void addTask(TaskOrder order, TaskKind kind, TaskHandler handler, const TaskAccessProvider* access = nullptr);
+    // Runs the node entry point for `order` (runBeginTask for Init, runPostTaskImpl(n) for PostN...).
+    // The node is the task's access provider; it must outlive the scheduled tasks.
+    void addNodeTask(TaskOrder order, TaskKind kind, nodes::Node* node);
+    // Registers `node`'s subtree (node->registerRenderTasks) and records the range its tasks take in
+    // every stage; Node::registerRenderTasks registers its children through this.
+    void addSubtree(nodes::Node* node);
+    // Re-registers the recorded subtrees of `nodes` in place: each one's recorded tasks, including
+    // those of nodes moved out of it since, give way to the tasks of its current subtree, and the
+    // rest of the list only shifts. Nodes without a record, or inside another listed subtree, are
+    // skipped. Returns the number of subtrees re-registered.
+    std::size_t rebuildSubtrees(std::vector<nodes::Node*> nodes);
     void executeRange(RenderContext& ctx, TaskOrder startOrder, TaskOrder endOrder = TaskOrder::Final);
     void execute(RenderContext& ctx) { executeRange(ctx, TaskOrder::Init, TaskOrder::Final); }
     std::size_t taskCount(TaskOrder order) const;
     std::size_t totalTaskCount() const;
 
+    // Runs the tasks of each stage in waves of non-conflicting tasks on `pool`; null (the default)
+    // or a one-thread pool keeps the serial path. The pool must not be one whose parallelFor is
+    // already running the caller: parallelFor does not nest.
+    void setWorkerPool(WorkerPool* pool) { pool_ = pool; }
+    WorkerPool* workerPool() const { return pool_; }
+
+    // Stages in execution order; executeRange walks this sequence.
+    static constexpr std::array<TaskOrder, 11> kOrderSequence{
+        TaskOrder::Init, TaskOrder::Parameters, TaskOrder::PreProcess, TaskOrder::Dynamic,
+        TaskOrder::Post0, TaskOrder::Post1, TaskOrder::Post2, TaskOrder::Final,
+        TaskOrder::RenderBegin, TaskOrder::Render, TaskOrder::RenderEnd};
+    static constexpr std::size_t kStageCount = kOrderSequence.size();
+
 private:
-    std::map<TaskOrder, std::vector<Task>> queues_;
-    std::vector<TaskOrder> orderSequence_;
+    struct KeyWaves {
+        std::size_t lastWrite{0};
+        std::size_t lastRead{0};
+    };
+
+    static constexpr std::uint32_t kNoSpan = ~std::uint32_t{0};
+
+    // One addSubtree call. spans_ is in registration (pre-)order, so a subtree is its own span and
+    // the `size - 1` after it; [begin, end) is where its tasks sit within each stage.
+    struct SubtreeSpan {
+        nodes::Node* node{nullptr};
+        std::uint32_t parent{kNoSpan};
+        std::uint32_t size{1};
+        std::array<std::uint32_t, kStageCount> begin{};
+        std::array<std::uint32_t, kStageCount> end{};
+    };
+
+    // Sorts tasks added since the last compile into tasks_, grouped by stage in submission order.
+    void compile();
+    // Where the next task added for `stage` will sit once compiled (or spliced).
+    std::uint32_t nextStagePosition(std::size_t stage) const;
+    void rebuildSubtree(std::uint32_t index);
+    void dispatch(RenderContext& ctx, const Task& task);
+    void runTask(RenderContext& ctx, const Task& task, bool profiling);
+    void executeStageParallel(RenderContext& ctx, TaskOrder order, const Task* tasks, std::size_t count, bool profiling);
+
+    // All stages in one array; stage i (kOrderSequence[i]) is [stageBegin_[i], stageBegin_[i + 1]).
+    std::vector<Task> tasks_{};
+    std::array<std::size_t, kStageCount + 1> stageBegin_{};
+    std::vector<Task> pending_{};
+    std::array<std::uint32_t, kStageCount> pendingCount_{};
+    std::vector<TaskHandler> handlers_{};
+    std::vector<std::uint32_t> freeHandlers_{};
+    std::vector<SubtreeSpan> spans_{};
+    // While rebuildSubtree re-registers a subtree, new spans collect here with indices relative to
+    // the subtree, and tasks are placed from the subtree's old range on.
+    bool splicing_{false};
+    std::array<std::uint32_t, kStageCount> spliceOrigin_{};
+    std::vector<SubtreeSpan> spliceSpans_{};
+    std::vector<std::uint32_t> openSpans_{};
+    std::vector<Task> spliceTasks_{};
+    WorkerPool* pool_{nullptr};
+    // Wave planning scratch, reused across stages and frames.
+    TaskAccess access_{};
+    std::unordered_map<const void*, KeyWaves> keyWaves_{};
+    std::vector<std::size_t> taskWave_{};
+    std::vector<std::size_t> waveStart_{};
+    std::vector<std::size_t> waveTasks_{};
 };
 
 } // namespace nicxlive::core
@@ -2,9 +2,12 @@
 #include "../debug_log.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -24,177 +27,448 @@ bool traceSharedEnabled() {
     return enabled != 0;
 }
 
-struct SharedVecAtlas {
-    struct Binding {
-        Vec2Array* target{nullptr};
-        std::size_t* offsetSink{nullptr};
-        std::size_t length{0};
-        std::size_t offset{0};
-    };
-
-    Vec2Array storage{};
-    std::vector<Binding> bindings{};
-    std::unordered_map<Vec2Array*, std::size_t> lookup{};
-    bool dirty{false};
-    std::size_t revision{0};
-
-    void registerArray(Vec2Array& target, std::size_t* offsetSink) {
-        auto ptr = &target;
-        auto it = lookup.find(ptr);
-        if (it != lookup.end()) {
-            bindings[it->second].offsetSink = offsetSink;
-            return;
-        }
-        std::size_t idx = bindings.size();
-        lookup[ptr] = idx;
-        bindings.push_back(Binding{ptr, offsetSink, target.size(), 0});
-        rebuild();
-        if (traceSharedEnabled()) {
-            NJCX_DBG_LOG("[nicxlive][shared-atlas] register target=%p len=%zu bindings=%zu stride=%zu\n",
-                         static_cast<void*>(ptr), target.size(), bindings.size(), storage.size());
+} // namespace
+
+namespace {
+void eraseFreeSpan(std::map<std::size_t, std::size_t>& byOffset,
+                   std::multimap<std::size_t, std::size_t>& bySize,
+                   std::size_t offset) {
+    auto it = byOffset.find(offset);
+    if (it == byOffset.end()) return;
+    auto range = bySize.equal_range(it->second);
+    for (auto sit = range.first; sit != range.second; ++sit) {
+        if (sit->second == offset) {
+            bySize.erase(sit);
+            break;
         }
     }
+    byOffset.erase(it);
+}
 
-    void unregisterArray(Vec2Array& target) {
-        auto ptr = &target;
-        auto it = lookup.find(ptr);
-        if (it == lookup.end()) return;
-        std::size_t idx = it->second;
-        std::size_t last = bindings.size() - 1;
-        lookup.erase(it);
-        if (idx != last) {
-            bindings[idx] = bindings[last];
-            lookup[bindings[idx].target] = idx;
-        }
-        bindings.pop_back();
-        rebuild();
-        if (traceSharedEnabled()) {
-            NJCX_DBG_LOG("[nicxlive][shared-atlas] unregister target=%p bindings=%zu stride=%zu\n",
-                         static_cast<void*>(ptr), bindings.size(), storage.size());
+void copyLanes(Vec2Array& storage, std::size_t dst, std::size_t src, std::size_t length) {
+    if (!length || dst == src) return;
+    float* x = storage.dataXMutable();
+    float* y = storage.dataYMutable();
+    std::memmove(x + dst, x + src, length * sizeof(float));
+    std::memmove(y + dst, y + src, length * sizeof(float));
+}
+
+void zeroLanes(Vec2Array& storage, std::size_t offset, std::size_t length) {
+    if (!length) return;
+    std::fill_n(storage.dataXMutable() + offset, length, 0.0f);
+    std::fill_n(storage.dataYMutable() + offset, length, 0.0f);
+}
+} // namespace
+
+void SharedVecAtlas::registerArray(Vec2Array& target, std::size_t* offsetSink) {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    auto ptr = &target;
+    auto it = lookup.find(ptr);
+    if (it != lookup.end()) {
+        bindings[it->second].offsetSink = offsetSink;
+        return;
+    }
+    Binding binding{ptr, offsetSink, target.size(), target.size(), 0};
+    if (binding.length) {
+        binding.offset = allocate(binding.length);
+        const float* srcX = target.dataX();
+        const float* srcY = target.dataY();
+        if (srcX && srcY) {
+            std::copy_n(srcX, binding.length, storage.dataXMutable() + binding.offset);
+            std::copy_n(srcY, binding.length, storage.dataYMutable() + binding.offset);
+        } else {
+            zeroLanes(storage, binding.offset, binding.length);
         }
     }
+    lookup[ptr] = bindings.size();
+    bindings.push_back(binding);
+    bindSlot(bindings.back());
+    markDirtyRange(binding.offset, binding.length);
+    if (traceSharedEnabled()) {
+        NJCX_DBG_LOG("[nicxlive][shared-atlas] register target=%p len=%zu off=%zu bindings=%zu stride=%zu\n",
+                     static_cast<void*>(ptr), target.size(), binding.offset, bindings.size(), storage.size());
+    }
+}
 
-    void resizeArray(Vec2Array& target, std::size_t newLength) {
-        auto ptr = &target;
-        auto it = lookup.find(ptr);
-        if (it == lookup.end()) return;
-        auto idx = it->second;
-        if (bindings[idx].length == newLength) return;
-        bindings[idx].length = newLength;
-        rebuild();
-        if (traceSharedEnabled()) {
-            NJCX_DBG_LOG("[nicxlive][shared-atlas] resize target=%p newLen=%zu bindings=%zu stride=%zu\n",
-                         static_cast<void*>(ptr), newLength, bindings.size(), storage.size());
+void SharedVecAtlas::unregisterArray(Vec2Array& target) {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    auto ptr = &target;
+    auto it = lookup.find(ptr);
+    if (it == lookup.end()) return;
+    std::size_t idx = it->second;
+    std::size_t last = bindings.size() - 1;
+    lookup.erase(it);
+    slackTotal -= bindings[idx].capacity - bindings[idx].length;
+    release(bindings[idx].offset, bindings[idx].capacity);
+    if (idx != last) {
+        bindings[idx] = bindings[last];
+        lookup[bindings[idx].target] = idx;
+    }
+    bindings.pop_back();
+    maybeCompact();
+    if (traceSharedEnabled()) {
+        NJCX_DBG_LOG("[nicxlive][shared-atlas] unregister target=%p bindings=%zu stride=%zu used=%zu free=%zu\n",
+                     static_cast<void*>(ptr), bindings.size(), storage.size(), used, freeTotal);
+    }
+}
+
+void SharedVecAtlas::resizeArray(Vec2Array& target, std::size_t newLength) {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    auto ptr = &target;
+    auto it = lookup.find(ptr);
+    if (it == lookup.end()) return;
+    auto idx = it->second;
+    if (bindings[idx].length == newLength) return;
+    // Elements the caller already holds in its slot; anything past them is zero-filled.
+    const std::size_t keep = std::min({newLength, target.size(), bindings[idx].capacity});
+    slackTotal -= bindings[idx].capacity - bindings[idx].length;
+    if (newLength > bindings[idx].capacity && !tryExtendInPlace(bindings[idx], newLength)) {
+        const std::size_t oldOffset = bindings[idx].offset;
+        const std::size_t oldCapacity = bindings[idx].capacity;
+        const std::size_t newOffset = allocate(newLength);
+        copyLanes(storage, newOffset, oldOffset, keep);
+        release(oldOffset, oldCapacity);
+        bindings[idx].offset = newOffset;
+        bindings[idx].capacity = newLength;
+    }
+    auto& binding = bindings[idx];
+    binding.length = newLength;
+    slackTotal += binding.capacity - binding.length;
+    zeroLanes(storage, binding.offset + keep, newLength - keep);
+    bindSlot(binding);
+    markDirtyRange(binding.offset, binding.length);
+    maybeCompact();
+    if (traceSharedEnabled()) {
+        NJCX_DBG_LOG("[nicxlive][shared-atlas] resize target=%p newLen=%zu off=%zu bindings=%zu stride=%zu\n",
+                     static_cast<void*>(ptr), newLength, bindings[lookup[ptr]].offset, bindings.size(), storage.size());
+    }
+}
+
+void SharedVecAtlas::markDirty() {
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        fullDirty = true;
+        pendingRanges.clear();
+        syncShadow(0, storage.size());
+    }
+    writes.fetch_add(1, std::memory_order_acq_rel);
+    if (!dirty.exchange(true, std::memory_order_acq_rel)) bumpRevision();
+}
+
+void SharedVecAtlas::markDirtyRange(std::size_t offset, std::size_t length) {
+    if (!length) return;
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        recordRange(offset, length);
+    }
+    if (!dirty.exchange(true, std::memory_order_acq_rel)) bumpRevision();
+}
+
+bool SharedVecAtlas::markDirtyIfChanged(std::size_t offset, std::size_t length) {
+    if (!length) return false;
+    {
+        std::lock_guard<std::mutex> lock(dirtyMutex);
+        const std::size_t end = std::min(offset + length, storage.size());
+        if (offset >= end) return false;
+        if (end <= shadowX.size() &&
+            std::equal(storage.dataX() + offset, storage.dataX() + end, shadowX.data() + offset) &&
+            std::equal(storage.dataY() + offset, storage.dataY() + end, shadowY.data() + offset)) {
+            return false;
         }
+        recordRange(offset, end - offset);
     }
+    if (!dirty.exchange(true, std::memory_order_acq_rel)) bumpRevision();
+    return true;
+}
+
+void SharedVecAtlas::recordRange(std::size_t offset, std::size_t length) {
+    writes.fetch_add(1, std::memory_order_acq_rel);
+    syncShadow(offset, length);
+    if (fullDirty) return;
+    pendingRanges.push_back(DirtyRange{offset, length});
+    if (pendingRanges.size() > kMaxDirtyRanges) {
+        fullDirty = true;
+        pendingRanges.clear();
+    }
+}
 
-    std::size_t stride() const { return storage.size(); }
-    Vec2Array& data() { return storage; }
-    bool isDirty() const { return dirty; }
-    void markDirty() {
-        if (!dirty) bumpRevision();
-        dirty = true;
-    }
-    void markUploaded() { dirty = false; }
-    std::size_t currentRevision() const { return revision; }
-
-private:
-    void bumpRevision() {
-        ++revision;
-        if (revision == 0) revision = 1;
-    }
-
-    void rebuild() {
-        std::size_t total = 0;
-        for (const auto& binding : bindings) total += binding.length;
-        Vec2Array newStorage;
-        if (total) {
-            newStorage.setLength(total);
-            std::size_t offset = 0;
-            for (auto& binding : bindings) {
-                auto len = binding.length;
-                if (len) {
-                    auto copyLen = std::min(len, binding.target->size());
-                    auto dstX = newStorage.dataXMutable() + offset;
-                    auto dstY = newStorage.dataYMutable() + offset;
-                    const float* srcX = binding.target->dataX();
-                    const float* srcY = binding.target->dataY();
-                    if (copyLen && srcX && srcY) {
-                        std::copy_n(srcX, copyLen, dstX);
-                        std::copy_n(srcY, copyLen, dstY);
-                    }
-                    if (copyLen < len) {
-                        std::fill(dstX + static_cast<std::ptrdiff_t>(copyLen), dstX + static_cast<std::ptrdiff_t>(len), 0.0f);
-                        std::fill(dstY + static_cast<std::ptrdiff_t>(copyLen), dstY + static_cast<std::ptrdiff_t>(len), 0.0f);
-                    }
-                } else {
-                    binding.target->clear();
-                }
-                binding.offset = offset;
-                offset += len;
-            }
+void SharedVecAtlas::syncShadow(std::size_t offset, std::size_t length) {
+    if (shadowX.size() != storage.size()) {
+        shadowX.resize(storage.size());
+        shadowY.resize(storage.size());
+        // A resized shadow no longer matches any slot; resync it wholesale.
+        offset = 0;
+        length = storage.size();
+    }
+    const std::size_t end = std::min(offset + length, storage.size());
+    if (offset >= end) return;
+    std::copy(storage.dataX() + offset, storage.dataX() + end, shadowX.data() + offset);
+    std::copy(storage.dataY() + offset, storage.dataY() + end, shadowY.data() + offset);
+}
+
+void SharedVecAtlas::markUploaded() {
+    std::lock_guard<std::mutex> lock(dirtyMutex);
+    pendingRanges.clear();
+    fullDirty = false;
+    dirty.store(false, std::memory_order_release);
+}
+
+std::vector<SharedVecAtlas::DirtyRange> SharedVecAtlas::dirtyRanges() const {
+    std::lock_guard<std::mutex> layoutLock(layoutMutex);
+    std::lock_guard<std::mutex> lock(dirtyMutex);
+    return collectRanges();
+}
+
+std::vector<SharedVecAtlas::DirtyRange> SharedVecAtlas::takeDirtyRanges() {
+    std::lock_guard<std::mutex> layoutLock(layoutMutex);
+    std::lock_guard<std::mutex> lock(dirtyMutex);
+    auto out = collectRanges();
+    pendingRanges.clear();
+    fullDirty = false;
+    dirty.store(false, std::memory_order_release);
+    return out;
+}
+
+std::vector<SharedVecAtlas::DirtyRange> SharedVecAtlas::collectRanges() const {
+    std::vector<DirtyRange> out;
+    if (!isDirty()) return out;
+    if (fullDirty) {
+        if (storage.size()) out.push_back(DirtyRange{0, storage.size()});
+        return out;
+    }
+    out = pendingRanges;
+    mergeDirtyRanges(out);
+    return out;
+}
+
+void mergeDirtyRanges(std::vector<SharedVecAtlas::DirtyRange>& ranges) {
+    using DirtyRange = SharedVecAtlas::DirtyRange;
+    std::sort(ranges.begin(), ranges.end(), [](const DirtyRange& a, const DirtyRange& b) { return a.offset < b.offset; });
+    std::size_t merged = 0;
+    for (std::size_t i = 0; i < ranges.size(); ++i) {
+        if (merged && ranges[merged - 1].offset + ranges[merged - 1].length >= ranges[i].offset) {
+            const auto end = std::max(ranges[merged - 1].offset + ranges[merged - 1].length, ranges[i].offset + ranges[i].length);
+            ranges[merged - 1].length = end - ranges[merged - 1].offset;
         } else {
-            for (auto& binding : bindings) {
-                binding.offset = 0;
-                binding.target->clear();
-            }
+            ranges[merged++] = ranges[i];
         }
-        storage = std::move(newStorage);
-        for (auto& binding : bindings) {
-            if (binding.length) {
-                binding.target->bindExternalStorage(storage, binding.offset, binding.length);
-            } else {
-                binding.target->clear();
-            }
-            if (binding.offsetSink) *binding.offsetSink = binding.offset;
+    }
+    ranges.resize(merged);
+}
+
+std::size_t SharedVecAtlas::usedLength() const {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    return used;
+}
+
+std::size_t SharedVecAtlas::wastedLength() const {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    return freeTotal + slackTotal;
+}
+
+void SharedVecAtlas::bumpRevision() {
+    if (revision.fetch_add(1, std::memory_order_acq_rel) + 1 == 0) revision.store(1, std::memory_order_release);
+}
+
+std::size_t SharedVecAtlas::allocate(std::size_t length) {
+    auto fit = freeBySize.lower_bound(length);
+    if (fit != freeBySize.end()) {
+        const std::size_t offset = fit->second;
+        const std::size_t spanLength = fit->first;
+        freeBySize.erase(fit);
+        freeByOffset.erase(offset);
+        if (spanLength > length) {
+            freeByOffset.emplace(offset + length, spanLength - length);
+            freeBySize.emplace(spanLength - length, offset + length);
         }
-        if (!dirty) bumpRevision();
-        dirty = true;
-        if (traceSharedEnabled()) {
-            std::size_t maxEnd = 0;
-            for (const auto& binding : bindings) {
-                const auto end = binding.offset + binding.length;
-                if (end > maxEnd) maxEnd = end;
-            }
-            NJCX_DBG_LOG("[nicxlive][shared-atlas] rebuild bindings=%zu stride=%zu maxEnd=%zu dirty=%d\n",
-                         bindings.size(), storage.size(), maxEnd, dirty ? 1 : 0);
+        freeTotal -= length;
+        return offset;
+    }
+    const std::size_t offset = used;
+    ensureCapacity(used + length);
+    used += length;
+    return offset;
+}
+
+void SharedVecAtlas::release(std::size_t offset, std::size_t length) {
+    if (!length) return;
+    std::size_t end = offset + length;
+    // Merge with the free span right before this one.
+    auto next = freeByOffset.lower_bound(offset);
+    if (next != freeByOffset.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            freeTotal -= prev->second;
+            eraseFreeSpan(freeByOffset, freeBySize, prev->first);
         }
     }
-};
+    next = freeByOffset.lower_bound(end);
+    if (next != freeByOffset.end() && next->first == end) {
+        end += next->second;
+        freeTotal -= next->second;
+        eraseFreeSpan(freeByOffset, freeBySize, next->first);
+    }
+    if (end == used) {
+        used = offset;
+        return;
+    }
+    freeByOffset.emplace(offset, end - offset);
+    freeBySize.emplace(end - offset, offset);
+    freeTotal += end - offset;
+}
+
+bool SharedVecAtlas::tryExtendInPlace(Binding& binding, std::size_t newLength) {
+    const std::size_t need = newLength - binding.capacity;
+    const std::size_t end = binding.offset + binding.capacity;
+    if (end == used) {
+        ensureCapacity(used + need);
+        used += need;
+        binding.capacity = newLength;
+        return true;
+    }
+    auto it = freeByOffset.find(end);
+    if (it == freeByOffset.end() || it->second < need) return false;
+    const std::size_t spanLength = it->second;
+    eraseFreeSpan(freeByOffset, freeBySize, end);
+    if (spanLength > need) {
+        freeByOffset.emplace(end + need, spanLength - need);
+        freeBySize.emplace(spanLength - need, end + need);
+    }
+    freeTotal -= need;
+    binding.capacity = newLength;
+    return true;
+}
+
+void SharedVecAtlas::ensureCapacity(std::size_t required) {
+    if (required <= storage.size()) return;
+    const std::size_t newCapacity = std::max({required, storage.size() + storage.size() / 2, kMinCapacity});
+    Vec2Array next;
+    next.setLength(newCapacity);
+    if (used && storage.size()) {
+        std::copy_n(storage.dataX(), used, next.dataXMutable());
+        std::copy_n(storage.dataY(), used, next.dataYMutable());
+    }
+    storage = std::move(next);
+    rebindAll();
+    markDirty();
+}
+
+void SharedVecAtlas::bindSlot(Binding& binding) {
+    if (binding.length) {
+        binding.target->bindExternalStorage(storage, binding.offset, binding.length);
+    } else {
+        binding.target->clear();
+    }
+    if (binding.offsetSink) *binding.offsetSink = binding.offset;
+}
+
+void SharedVecAtlas::rebindAll() {
+    for (auto& binding : bindings) bindSlot(binding);
+}
 
-SharedVecAtlas deformAtlas;
-SharedVecAtlas vertexAtlas;
-SharedVecAtlas uvAtlas;
+void SharedVecAtlas::holdCompaction() {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    compactionHeld = true;
+}
+
+void SharedVecAtlas::releaseCompaction() {
+    std::lock_guard<std::mutex> lock(layoutMutex);
+    compactionHeld = false;
+    maybeCompact();
+}
+
+void SharedVecAtlas::maybeCompact() {
+    if (compactionHeld) return;
+    if (used == 0 && storage.size()) {
+        rebuild();
+        return;
+    }
+    const std::size_t waste = freeTotal + slackTotal;
+    if (waste < kCompactMinWaste) return;
+    if (static_cast<float>(waste) <= static_cast<float>(used) * kCompactRatio) return;
+    rebuild();
+}
+
+void SharedVecAtlas::rebuild() {
+    std::size_t total = 0;
+    for (const auto& binding : bindings) total += binding.length;
+    Vec2Array newStorage;
+    if (total) newStorage.setLength(std::max(total, kMinCapacity));
+    std::size_t offset = 0;
+    for (auto& binding : bindings) {
+        if (binding.length) {
+            std::copy_n(storage.dataX() + binding.offset, binding.length, newStorage.dataXMutable() + offset);
+            std::copy_n(storage.dataY() + binding.offset, binding.length, newStorage.dataYMutable() + offset);
+        }
+        binding.offset = binding.length ? offset : 0;
+        binding.capacity = binding.length;
+        offset += binding.length;
+    }
+    storage = std::move(newStorage);
+    freeByOffset.clear();
+    freeBySize.clear();
+    freeTotal = 0;
+    slackTotal = 0;
+    used = total;
+    rebindAll();
+    markDirty();
+    if (traceSharedEnabled()) {
+        NJCX_DBG_LOG("[nicxlive][shared-atlas] compact bindings=%zu stride=%zu used=%zu\n",
+                     bindings.size(), storage.size(), used);
+    }
+}
+
+namespace {
+thread_local std::shared_ptr<SharedBufferSet> tCurrentSet{};
 } // namespace
 
-void sharedDeformRegister(Vec2Array& target, std::size_t* offsetSink) { deformAtlas.registerArray(target, offsetSink); }
-void sharedDeformUnregister(Vec2Array& target) { deformAtlas.unregisterArray(target); }
-void sharedDeformResize(Vec2Array& target, std::size_t newLength) { deformAtlas.resizeArray(target, newLength); }
-std::size_t sharedDeformAtlasStride() { return deformAtlas.stride(); }
-Vec2Array& sharedDeformBufferData() { return deformAtlas.data(); }
-bool sharedDeformBufferDirty() { return deformAtlas.isDirty(); }
-void sharedDeformMarkDirty() { deformAtlas.markDirty(); }
-void sharedDeformMarkUploaded() { deformAtlas.markUploaded(); }
-std::size_t sharedDeformBufferRevision() { return deformAtlas.currentRevision(); }
-
-void sharedVertexRegister(Vec2Array& target, std::size_t* offsetSink) { vertexAtlas.registerArray(target, offsetSink); }
-void sharedVertexUnregister(Vec2Array& target) { vertexAtlas.unregisterArray(target); }
-void sharedVertexResize(Vec2Array& target, std::size_t newLength) { vertexAtlas.resizeArray(target, newLength); }
-std::size_t sharedVertexAtlasStride() { return vertexAtlas.stride(); }
-Vec2Array& sharedVertexBufferData() { return vertexAtlas.data(); }
-bool sharedVertexBufferDirty() { return vertexAtlas.isDirty(); }
-void sharedVertexMarkDirty() { vertexAtlas.markDirty(); }
-void sharedVertexMarkUploaded() { vertexAtlas.markUploaded(); }
-std::size_t sharedVertexBufferRevision() { return vertexAtlas.currentRevision(); }
-
-void sharedUvRegister(Vec2Array& target, std::size_t* offsetSink) { uvAtlas.registerArray(target, offsetSink); }
-void sharedUvUnregister(Vec2Array& target) { uvAtlas.unregisterArray(target); }
-void sharedUvResize(Vec2Array& target, std::size_t newLength) { uvAtlas.resizeArray(target, newLength); }
-std::size_t sharedUvAtlasStride() { return uvAtlas.stride(); }
-Vec2Array& sharedUvBufferData() { return uvAtlas.data(); }
-bool sharedUvBufferDirty() { return uvAtlas.isDirty(); }
-void sharedUvMarkDirty() { uvAtlas.markDirty(); }
-void sharedUvMarkUploaded() { uvAtlas.markUploaded(); }
-std::size_t sharedUvBufferRevision() { return uvAtlas.currentRevision(); }
+std::shared_ptr<SharedBufferSet> defaultSharedBufferSet() {
+    static auto set = std::make_shared<SharedBufferSet>();
+    return set;
+}
+
+std::shared_ptr<SharedBufferSet> currentSharedBufferSet() {
+    return tCurrentSet ? tCurrentSet : defaultSharedBufferSet();
+}
+
+ScopedSharedBufferSet::ScopedSharedBufferSet(const std::shared_ptr<SharedBufferSet>& set)
+    : previous_(tCurrentSet) {
+    tCurrentSet = set;
+}
+
+ScopedSharedBufferSet::~ScopedSharedBufferSet() {
+    tCurrentSet = std::move(previous_);
+}
+
+void sharedDeformRegister(Vec2Array& target, std::size_t* offsetSink) { currentSharedBufferSet()->deform.registerArray(target, offsetSink); }
+void sharedDeformUnregister(Vec2Array& target) { currentSharedBufferSet()->deform.unregisterArray(target); }
+void sharedDeformResize(Vec2Array& target, std::size_t newLength) { currentSharedBufferSet()->deform.resizeArray(target, newLength); }
+std::size_t sharedDeformAtlasStride() { return currentSharedBufferSet()->deform.stride(); }
+Vec2Array& sharedDeformBufferData() { return currentSharedBufferSet()->deform.data(); }
+bool sharedDeformBufferDirty() { return currentSharedBufferSet()->deform.isDirty(); }
+void sharedDeformMarkDirty() { currentSharedBufferSet()->deform.markDirty(); }
+void sharedDeformMarkUploaded() { currentSharedBufferSet()->deform.markUploaded(); }
+std::size_t sharedDeformBufferRevision() { return currentSharedBufferSet()->deform.currentRevision(); }
+
+void sharedVertexRegister(Vec2Array& target, std::size_t* offsetSink) { currentSharedBufferSet()->vertex.registerArray(target, offsetSink); }
+void sharedVertexUnregister(Vec2Array& target) { currentSharedBufferSet()->vertex.unregisterArray(target); }
+void sharedVertexResize(Vec2Array& target, std::size_t newLength) { currentSharedBufferSet()->vertex.resizeArray(target, newLength); }
+std::size_t sharedVertexAtlasStride() { return currentSharedBufferSet()->vertex.stride(); }
+Vec2Array& sharedVertexBufferData() { return currentSharedBufferSet()->vertex.data(); }
+bool sharedVertexBufferDirty() { return currentSharedBufferSet()->vertex.isDirty(); }
+void sharedVertexMarkDirty() { currentSharedBufferSet()->vertex.markDirty(); }
+void sharedVertexMarkUploaded() { currentSharedBufferSet()->vertex.markUploaded(); }
+std::size_t sharedVertexBufferRevision() { return currentSharedBufferSet()->vertex.currentRevision(); }
+
+void sharedUvRegister(Vec2Array& target, std::size_t* offsetSink) { currentSharedBufferSet()->uv.registerArray(target, offsetSink); }
+void sharedUvUnregister(Vec2Array& target) { currentSharedBufferSet()->uv.unregisterArray(target); }
+void sharedUvResize(Vec2Array& target, std::size_t newLength) { currentSharedBufferSet()->uv.resizeArray(target, newLength); }
+std::size_t sharedUvAtlasStride() { return currentSharedBufferSet()->uv.stride(); }
+Vec2Array& sharedUvBufferData() { return currentSharedBufferSet()->uv.data(); }
+bool sharedUvBufferDirty() { return currentSharedBufferSet()->uv.isDirty(); }
+void sharedUvMarkDirty() { currentSharedBufferSet()->uv.markDirty(); }
+void sharedUvMarkUploaded() { currentSharedBufferSet()->uv.markUploaded(); }
+std::size_t sharedUvBufferRevision() { return currentSharedBufferSet()->uv.currentRevision(); }
 
 } // namespace nicxlive::core::render
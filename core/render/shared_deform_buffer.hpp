@@ -2,11 +2,138 @@
 
 #include "../nodes/common.hpp"
 
+#include <atomic>
 #include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace nicxlive::core::render {
 
+// Packs every registered Vec2Array into one contiguous SoA storage and rebinds the
+// registered arrays as views into it, so the host can upload a single buffer.
+// Slots are handed out by a best-fit free list with tail growth; the storage is only
+// reallocated when the tail outgrows its capacity, and only compacted once the wasted
+// space (free spans + slack inside shrunk slots) passes kCompactRatio of the used range.
+class SharedVecAtlas {
+public:
+    struct DirtyRange {
+        std::size_t offset{0};
+        std::size_t length{0};
+    };
+
+    static constexpr std::size_t kMinCapacity = 256;
+    static constexpr std::size_t kCompactMinWaste = 1024;
+    static constexpr float kCompactRatio = 0.5f;
+    static constexpr std::size_t kMaxDirtyRanges = 256;
+
+    void registerArray(::nicxlive::core::common::Vec2Array& target, std::size_t* offsetSink);
+    void unregisterArray(::nicxlive::core::common::Vec2Array& target);
+    void resizeArray(::nicxlive::core::common::Vec2Array& target, std::size_t newLength);
+
+    std::size_t stride() const { return storage.size(); }
+    ::nicxlive::core::common::Vec2Array& data() { return storage; }
+    bool isDirty() const { return dirty.load(std::memory_order_acquire); }
+    // Whole atlas dirty (layout changed or the caller does not know the range).
+    void markDirty();
+    void markDirtyRange(std::size_t offset, std::size_t length);
+    // Records the range only if its contents differ from what was last marked; returns true if it did.
+    // Lets per-frame writers (deform updates) skip slots that were rewritten with identical values.
+    bool markDirtyIfChanged(std::size_t offset, std::size_t length);
+    void markUploaded();
+    std::size_t currentRevision() const { return revision.load(std::memory_order_acquire); }
+    // Counts every mark (range or full), including ones made while already dirty; lets callers tell
+    // whether anything was written between two points without consuming the dirty state.
+    std::size_t writeCount() const { return writes.load(std::memory_order_acquire); }
+    // Sorted, merged element ranges written since the last markUploaded().
+    // A single range covering the whole stride means "upload everything".
+    std::vector<DirtyRange> dirtyRanges() const;
+    // dirtyRanges() + markUploaded() as one step, so a concurrent mark is never dropped in between.
+    std::vector<DirtyRange> takeDirtyRanges();
+    std::size_t usedLength() const;
+    std::size_t wastedLength() const;
+    // While held, unregister/resize never compact; release runs one compaction check.
+    // For bulk moves out of an atlas, where compacting after every removal is quadratic.
+    void holdCompaction();
+    void releaseCompaction();
+
+private:
+    struct Binding {
+        ::nicxlive::core::common::Vec2Array* target{nullptr};
+        std::size_t* offsetSink{nullptr};
+        std::size_t length{0};
+        std::size_t capacity{0};
+        std::size_t offset{0};
+    };
+
+    void bumpRevision();
+    // dirtyMutex must be held.
+    void recordRange(std::size_t offset, std::size_t length);
+    void syncShadow(std::size_t offset, std::size_t length);
+    std::vector<DirtyRange> collectRanges() const;
+    std::size_t allocate(std::size_t length);
+    void release(std::size_t offset, std::size_t length);
+    bool tryExtendInPlace(Binding& binding, std::size_t newLength);
+    void ensureCapacity(std::size_t required);
+    void rebindAll();
+    void bindSlot(Binding& binding);
+    void maybeCompact();
+    void rebuild();
+
+    ::nicxlive::core::common::Vec2Array storage{};
+    std::vector<Binding> bindings{};
+    std::unordered_map<::nicxlive::core::common::Vec2Array*, std::size_t> lookup{};
+    std::map<std::size_t, std::size_t> freeByOffset{};
+    std::multimap<std::size_t, std::size_t> freeBySize{};
+    std::size_t used{0};
+    std::size_t freeTotal{0};
+    std::size_t slackTotal{0};
+    // Structural changes (register/unregister/resize) move the storage, so they are serialized.
+    // Per-frame writes go through the bound views and touch disjoint ranges only.
+    mutable std::mutex layoutMutex{};
+    mutable std::mutex dirtyMutex{};
+    std::vector<DirtyRange> pendingRanges{};
+    // Contents as of the last mark, per lane; markDirtyIfChanged() diffs the slot against it.
+    std::vector<float> shadowX{};
+    std::vector<float> shadowY{};
+    bool fullDirty{false};
+    bool compactionHeld{false};
+    std::atomic<bool> dirty{false};
+    std::atomic<std::size_t> revision{0};
+    std::atomic<std::size_t> writes{0};
+};
+
+// Sorts ranges by offset and merges overlapping or touching ones in place.
+void mergeDirtyRanges(std::vector<SharedVecAtlas::DirtyRange>& ranges);
+
+// The deform/vertex/UV atlases for one renderer (or one standalone puppet).
+// Drawables register into the set that is current when they are constructed.
+struct SharedBufferSet {
+    SharedVecAtlas deform{};
+    SharedVecAtlas vertex{};
+    SharedVecAtlas uv{};
+};
+
+// Thread-bound set if one is bound, otherwise the process-wide default set.
+std::shared_ptr<SharedBufferSet> currentSharedBufferSet();
+std::shared_ptr<SharedBufferSet> defaultSharedBufferSet();
+
+// Binds a set as current for the calling thread (load/update/draw of one puppet).
+class ScopedSharedBufferSet {
+public:
+    explicit ScopedSharedBufferSet(const std::shared_ptr<SharedBufferSet>& set);
+    ~ScopedSharedBufferSet();
+    ScopedSharedBufferSet(const ScopedSharedBufferSet&) = delete;
+    ScopedSharedBufferSet& operator=(const ScopedSharedBufferSet&) = delete;
+
+private:
+    std::shared_ptr<SharedBufferSet> previous_{};
+};
+
 // D: nijilive.core.render.shared_deform_buffer
+// The free functions below operate on currentSharedBufferSet().
 void sharedDeformRegister(::nicxlive::core::common::Vec2Array& target, std::size_t* offsetSink);
 void sharedDeformUnregister(::nicxlive::core::common::Vec2Array& target);
 void sharedDeformResize(::nicxlive::core::common::Vec2Array& target, std::size_t newLength);
@@ -0,0 +1,44 @@
+#include "scene.hpp"
+#include "timing.hpp"
+#include "render/profiler.hpp"
+
+#include <algorithm>
+
+namespace nicxlive::core {
+
+Scene::Scene(std::size_t threadCount)
+    : pool_(threadCount) {}
+
+void Scene::addPuppet(const std::shared_ptr<Puppet>& puppet) {
+    if (!puppet) return;
+    if (std::find(puppets_.begin(), puppets_.end(), puppet) != puppets_.end()) return;
+    puppets_.push_back(puppet);
+}
+
+void Scene::removePuppet(const std::shared_ptr<Puppet>& puppet) {
+    puppets_.erase(std::remove(puppets_.begin(), puppets_.end(), puppet), puppets_.end());
+}
+
+void Scene::setThreadCount(std::size_t threadCount) {
+    pool_.setThreadCount(threadCount);
+}
+
+std::size_t Scene::threadCount() const {
+    return pool_.threadCount();
+}
+
+void Scene::update() {
+    auto profile = render::profileScope("Scene.update");
+    inUpdate();
+    pool_.parallelFor(puppets_.size(), [&](std::size_t i) {
+        puppets_[i]->update();
+    });
+}
+
+void Scene::draw() {
+    for (const auto& puppet : puppets_) {
+        puppet->draw();
+    }
+}
+
+} // namespace nicxlive::core
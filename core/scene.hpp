@@ -0,0 +1,35 @@
+#pragma once
+
+#include "puppet.hpp"
+#include "worker_pool.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace nicxlive::core {
+
+// A set of puppets that advance together: the clock moves once per frame and every
+// puppet is updated on the scene's worker pool. Drawing stays on the calling thread.
+class Scene {
+public:
+    // threadCount: 0 = hardware concurrency, 1 = serial in insertion order.
+    explicit Scene(std::size_t threadCount = 0);
+
+    void addPuppet(const std::shared_ptr<Puppet>& puppet);
+    void removePuppet(const std::shared_ptr<Puppet>& puppet);
+    const std::vector<std::shared_ptr<Puppet>>& puppets() const { return puppets_; }
+
+    void setThreadCount(std::size_t threadCount);
+    std::size_t threadCount() const;
+
+    // Calls inUpdate() once, then Puppet::update() for every puppet in parallel.
+    void update();
+    void draw();
+
+private:
+    std::vector<std::shared_ptr<Puppet>> puppets_{};
+    WorkerPool pool_;
+};
+
+} // namespace nicxlive::core
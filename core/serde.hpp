@@ -2,13 +2,15 @@
 
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include "json.hpp"
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace nicxlive::core::serde {
 
-using Fghj = boost::property_tree::ptree;
+// Deserializers read a parsed JsonDocument; serialization still builds a ptree.
+using Fghj = JsonValue;
 using SerdeException = std::optional<std::string>;
 
 class InochiSerializer {
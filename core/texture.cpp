@@ -4,12 +4,16 @@
 #include "texture.hpp"
 #include "render/common.hpp"
 #include "render/backend_queue.hpp"
+#include "worker_pool.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace nicxlive::core {
@@ -37,9 +41,9 @@ std::vector<uint8_t> loadImage(const std::string& file, int& w, int& h, int& com
     comp = outComp;
     return result;
 }
-std::vector<uint8_t> loadImageBuffer(const std::vector<uint8_t>& buffer, int& w, int& h, int& comp, int reqComp) {
+std::vector<uint8_t> loadImageBuffer(const uint8_t* buffer, std::size_t length, int& w, int& h, int& comp, int reqComp) {
     int width = 0, height = 0, components = 0;
-    stbi_uc* data = stbi_load_from_memory(buffer.data(), static_cast<int>(buffer.size()), &width, &height, &components, reqComp);
+    stbi_uc* data = stbi_load_from_memory(buffer, static_cast<int>(length), &width, &height, &components, reqComp);
     if (!data) return {};
     int outComp = (reqComp == 0) ? components : reqComp;
     std::size_t bytes = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * static_cast<std::size_t>(outComp);
@@ -51,22 +55,167 @@ std::vector<uint8_t> loadImageBuffer(const std::vector<uint8_t>& buffer, int& w,
     comp = outComp;
     return result;
 }
+std::vector<uint8_t> loadImageBuffer(const std::vector<uint8_t>& buffer, int& w, int& h, int& comp, int reqComp) {
+    return loadImageBuffer(buffer.data(), buffer.size(), w, h, comp, reqComp);
+}
+struct FreeRenderTarget {
+    std::weak_ptr<RenderBackend> backend;
+    const RenderBackend* backendKey{nullptr};
+    int widthClass{0};
+    int heightClass{0};
+    int channels{0};
+    bool stencil{false};
+    std::shared_ptr<Texture> texture;
+};
+
+constexpr std::size_t kMaxFreeRenderTargetsPerClass = 2;
+constexpr std::size_t kMaxFreeRenderTargets = 16;
+
+std::mutex gRenderTargetPoolMutex;
+std::vector<FreeRenderTarget> gFreeRenderTargets; // oldest first
+
+// Targets whose backend is gone (renderer destroyed); gRenderTargetPoolMutex must be held.
+// The caller disposes them outside the lock so they never reach another backend's disposal queue.
+void pruneOrphanedRenderTargets(std::vector<std::shared_ptr<Texture>>& out) {
+    auto it = std::remove_if(gFreeRenderTargets.begin(), gFreeRenderTargets.end(), [&](FreeRenderTarget& entry) {
+        if (!entry.backend.expired()) return false;
+        out.push_back(std::move(entry.texture));
+        return true;
+    });
+    gFreeRenderTargets.erase(it, gFreeRenderTargets.end());
+}
+
+WorkerPool& textureDecodePool() {
+    static WorkerPool pool{};
+    return pool;
+}
+
+// What a cached texture was built from; the same bytes give different textures per form.
+enum class CachedTextureForm : uint8_t {
+    Decoded,  // encoded payload, decoded at load
+    Deferred, // encoded payload, decoded on first use
+    Pixels,   // raw pixels
+};
+
+struct TextureCacheKey {
+    uint64_t hash{0};
+    uint64_t check{0};
+    std::size_t length{0};
+    CachedTextureForm form{CachedTextureForm::Decoded};
+
+    bool operator==(const TextureCacheKey&) const = default;
+};
+
+struct TextureCacheKeyHash {
+    std::size_t operator()(const TextureCacheKey& key) const noexcept {
+        return static_cast<std::size_t>(key.hash ^ (static_cast<uint64_t>(key.form) << 62));
+    }
+};
+
+struct CachedTexture {
+    std::weak_ptr<Texture> texture;
+    // Pixels the texture had when cached; any other buffer means it was edited since.
+    std::weak_ptr<const std::vector<uint8_t>> pixels;
+};
+
+std::mutex gTextureCacheMutex;
+std::unordered_map<TextureCacheKey, CachedTexture, TextureCacheKeyHash> gTextureCache;
+std::size_t gTextureCacheSweepAt = 64;
+std::size_t gTextureCacheHits = 0;
+std::size_t gTextureCacheMisses = 0;
+
+uint64_t mixHash(uint64_t v) {
+    v ^= v >> 33;
+    v *= 0xff51afd7ed558ccdull;
+    v ^= v >> 33;
+    v *= 0xc4ceb9fe1a85ec53ull;
+    v ^= v >> 33;
+    return v;
+}
+
+// Two independent 64-bit lanes over the bytes, eight at a time; `salt` separates raw pixel sizes.
+TextureCacheKey textureCacheKey(const uint8_t* data, std::size_t length, CachedTextureForm form, uint64_t salt = 0) {
+    uint64_t a = 0x9e3779b97f4a7c15ull ^ salt;
+    uint64_t b = 0x6a09e667f3bcc909ull + salt;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        a = (a ^ word) * 0x100000001b3ull;
+        a = (a << 31) | (a >> 33);
+        b = (b + word) * 0xc2b2ae3d27d4eb4full;
+        b ^= b >> 29;
+    }
+    uint64_t tail = 0;
+    for (std::size_t shift = 0; i < length; ++i, shift += 8) tail |= static_cast<uint64_t>(data[i]) << shift;
+    a = mixHash(a ^ tail ^ length);
+    b = mixHash(b + tail + (static_cast<uint64_t>(length) << 1));
+    return TextureCacheKey{a, b, length, form};
+}
+
+// A cached texture may still be handed out while it holds what it was cached from.
+bool cachedTextureUsable(const CachedTexture& entry, const Texture& tex, const TextureCacheKey& key, const uint8_t* bytes) {
+    if (key.form == CachedTextureForm::Deferred) {
+        const auto& encoded = tex.encodedData();
+        return encoded.size() == key.length && std::equal(encoded.begin(), encoded.end(), bytes);
+    }
+    const auto& pixels = tex.pixels();
+    return tex.pixelsResident() && !entry.pixels.owner_before(pixels) && !pixels.owner_before(entry.pixels);
+}
+
+std::shared_ptr<Texture> findCachedTexture(const TextureCacheKey& key, const uint8_t* bytes) {
+    std::lock_guard<std::mutex> lock(gTextureCacheMutex);
+    auto it = gTextureCache.find(key);
+    if (it == gTextureCache.end()) return nullptr;
+    auto tex = it->second.texture.lock();
+    if (!tex || !cachedTextureUsable(it->second, *tex, key, bytes)) {
+        gTextureCache.erase(it);
+        return nullptr;
+    }
+    ++gTextureCacheHits;
+    return tex;
+}
+
+// Caches a freshly loaded texture. A load that raced this one may have cached the same bytes
+// first; its texture is returned instead so the slots still share.
+std::shared_ptr<Texture> cacheTexture(const TextureCacheKey& key, const uint8_t* bytes, std::shared_ptr<Texture> tex) {
+    std::lock_guard<std::mutex> lock(gTextureCacheMutex);
+    ++gTextureCacheMisses;
+    auto& entry = gTextureCache[key];
+    if (auto existing = entry.texture.lock(); existing && cachedTextureUsable(entry, *existing, key, bytes)) {
+        return existing;
+    }
+    entry = CachedTexture{tex, tex->pixels()};
+    if (!cachedTextureUsable(entry, *tex, key, bytes)) {
+        // Failed decodes (no pixels) are not cached.
+        gTextureCache.erase(key);
+        return tex;
+    }
+    if (gTextureCache.size() >= gTextureCacheSweepAt) {
+        std::erase_if(gTextureCache, [](const auto& item) { return item.second.texture.expired(); });
+        gTextureCacheSweepAt = (std::max)(std::size_t{64}, gTextureCache.size() * 2);
+    }
+    return tex;
+}
 } // namespace
 
 ShallowTexture::ShallowTexture(const std::string& file, int channels) {
     int w = 0, h = 0, comp = 0;
     auto img = loadImage(file, w, h, comp, channels);
-    data = img;
+    data = std::move(img);
     width = w;
     height = h;
     channels = channels == 0 ? comp : channels;
     convChannels = channels;
 }
 
-ShallowTexture::ShallowTexture(const std::vector<uint8_t>& buffer, int channels) {
+ShallowTexture::ShallowTexture(const std::vector<uint8_t>& buffer, int channels)
+    : ShallowTexture(buffer.data(), buffer.size(), channels) {}
+
+ShallowTexture::ShallowTexture(const uint8_t* bytes, std::size_t length, int channels) {
     int w = 0, h = 0, comp = 0;
-    auto img = loadImageBuffer(buffer, w, h, comp, channels);
-    data = img;
+    auto img = loadImageBuffer(bytes, length, w, h, comp, channels);
+    data = std::move(img);
     width = w;
     height = h;
     this->channels = channels == 0 ? comp : channels;
@@ -88,7 +237,7 @@ Texture::Texture(const std::string& file, int channels, bool useMipmaps) {
     int w = 0, h = 0, comp = 0;
     auto img = loadImage(file, w, h, comp, channels);
     if (!img.empty()) {
-        initFromData(img, w, h, comp, channels == 0 ? comp : channels, false, useMipmaps);
+        initFromData(std::move(img), w, h, comp, channels == 0 ? comp : channels, false, useMipmaps);
     }
 }
 
@@ -96,22 +245,45 @@ Texture::Texture(const ShallowTexture& shallow, bool useMipmaps) {
     if (!shallow.data.empty() && shallow.width > 0 && shallow.height > 0) {
         initFromData(shallow.data, shallow.width, shallow.height, shallow.channels, shallow.convChannels, false, useMipmaps);
     } else {
-        int w = shallow.width;
-        int h = shallow.height;
-        int comp = shallow.channels;
-        auto img = loadImageBuffer(shallow.data, w, h, comp, shallow.convChannels);
-        if (!img.empty()) {
-            initFromData(img, w, h, comp, shallow.convChannels == 0 ? comp : shallow.convChannels, false, useMipmaps);
-        } else {
-            initFromData(std::vector<uint8_t>{}, shallow.width, shallow.height, shallow.channels, shallow.convChannels, false, useMipmaps);
-        }
+        initFromEncoded(shallow, useMipmaps);
+    }
+}
+
+Texture::Texture(ShallowTexture&& shallow, bool useMipmaps) {
+    if (!shallow.data.empty() && shallow.width > 0 && shallow.height > 0) {
+        initFromData(std::move(shallow.data), shallow.width, shallow.height, shallow.channels, shallow.convChannels, false, useMipmaps);
+    } else {
+        initFromEncoded(shallow, useMipmaps);
+    }
+}
+
+Texture::Texture(EncodedImage image, bool useMipmaps) {
+    int w = 0, h = 0, comp = 0;
+    if (!image.data || !stbi_info_from_memory(image.data, static_cast<int>(image.length), &w, &h, &comp)) return;
+    encoded_.assign(image.data, image.data + image.length);
+    width_ = w;
+    height_ = h;
+    channels_ = comp;
+    useMipmaps_ = useMipmaps;
+    runtimeUUID_ = nextUUID();
+}
+
+void Texture::initFromEncoded(const ShallowTexture& shallow, bool useMipmaps) {
+    int w = shallow.width;
+    int h = shallow.height;
+    int comp = shallow.channels;
+    auto img = loadImageBuffer(shallow.data, w, h, comp, shallow.convChannels);
+    if (!img.empty()) {
+        initFromData(std::move(img), w, h, comp, shallow.convChannels == 0 ? comp : shallow.convChannels, false, useMipmaps);
+    } else {
+        initFromData(std::vector<uint8_t>{}, shallow.width, shallow.height, shallow.channels, shallow.convChannels, false, useMipmaps);
     }
 }
 
 Texture::Texture(int w, int h, int channels, bool stencil, bool useMipmaps) {
     std::vector<uint8_t> empty;
     if (!stencil) empty.resize(static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * static_cast<std::size_t>(channels));
-    initFromData(empty, w, h, channels, channels, stencil, useMipmaps);
+    initFromData(std::move(empty), w, h, channels, channels, stencil, useMipmaps);
 }
 
 Texture::Texture(const std::vector<uint8_t>& data, int width, int height, int inChannels, int outChannels, bool stencil, bool useMipmaps) {
@@ -122,23 +294,78 @@ Texture::~Texture() {
     disposeDeferred();
 }
 
-void Texture::initFromData(const std::vector<uint8_t>& data, int width, int height, int inChannels, int outChannels, bool stencil, bool useMipmaps) {
+std::shared_ptr<Texture> Texture::createRenderTarget(int w, int h, int channels, bool stencil) {
+    auto tex = std::make_shared<Texture>();
+    tex->width_ = w;
+    tex->height_ = h;
+    tex->channels_ = channels;
+    tex->stencil_ = stencil;
+    tex->renderTarget_ = true;
+    tex->useMipmaps_ = false;
+    tex->runtimeUUID_ = nextUUID();
+    if (auto backend = getCurrentRenderBackend()) {
+        tex->backend_ = backend;
+        tex->backendId_ = backend->createTexture(nullptr, w, h, channels, stencil);
+    }
+    return tex;
+}
+
+void Texture::resizeRenderTarget(int w, int h) {
+    if (!renderTarget_ || (w == width_ && h == height_)) return;
+    width_ = w;
+    height_ = h;
+    if (auto backend = backend_.lock()) {
+        if (backendId_ != 0) backend->updateTexture(backendId_, nullptr, width_, height_, channels_);
+    }
+}
+
+void Texture::initFromData(std::vector<uint8_t> data, int width, int height, int inChannels, int outChannels, bool stencil, bool useMipmaps) {
     width_ = width;
     height_ = height;
     channels_ = outChannels;
     stencil_ = stencil;
     useMipmaps_ = useMipmaps;
-    data_ = data;
+    pixels_ = std::make_shared<const std::vector<uint8_t>>(std::move(data));
     filtering_ = Filtering::Linear;
     wrapping_ = Wrapping::Clamp;
     anisotropy_ = 1.0f;
     if (runtimeUUID_ == 0) runtimeUUID_ = nextUUID();
     if (auto backend = getCurrentRenderBackend()) {
         backend_ = backend;
-        backendId_ = backend->createTexture(data_, width_, height_, outChannels, stencil_);
+        backendId_ = backend->createTexture(pixels_, width_, height_, outChannels, stencil_);
     }
 }
 
+const std::vector<uint8_t>& Texture::data() const {
+    static const std::vector<uint8_t> empty{};
+    return pixels_ ? *pixels_ : empty;
+}
+
+bool Texture::ensureDecoded() {
+    if (pixelsResident()) return true;
+    if (encoded_.empty()) return false;
+    int w = 0, h = 0, comp = 0;
+    auto img = loadImageBuffer(encoded_.data(), encoded_.size(), w, h, comp, 0);
+    if (img.empty()) return false;
+    width_ = w;
+    height_ = h;
+    channels_ = comp;
+    pixels_ = std::make_shared<const std::vector<uint8_t>>(std::move(img));
+    return true;
+}
+
+std::size_t Texture::releasePixels() {
+    if (encoded_.empty()) return 0;
+    return discardPixels();
+}
+
+std::size_t Texture::discardPixels() {
+    if (locked_ || !pixels_) return 0;
+    const std::size_t bytes = pixels_->size();
+    pixels_.reset();
+    return bytes;
+}
+
 void Texture::setFiltering(bool point) {
     setFiltering(point ? Filtering::Nearest : Filtering::Linear);
 }
@@ -180,22 +407,24 @@ void Texture::setData(const std::vector<uint8_t>& data, int inChannels) {
         modified_ = true;
         return;
     }
-    data_ = data;
+    pixels_ = std::make_shared<const std::vector<uint8_t>>(data);
+    std::vector<uint8_t>().swap(encoded_); // no longer matches the pixels
     modified_ = true;
     auto backend = backend_.lock();
     if (!backend) backend = getCurrentRenderBackend();
     if (backend) {
         backend_ = backend;
         if (backendId_ == 0) {
-            backendId_ = backend->createTexture(data_, width_, height_, channels_, stencil_);
+            backendId_ = backend->createTexture(pixels_, width_, height_, channels_, stencil_);
         } else {
-            backend->updateTexture(backendId_, data_, width_, height_, channels_);
+            backend->updateTexture(backendId_, pixels_, width_, height_, channels_);
         }
     }
 }
 
 void Texture::dispose() {
-    data_.clear();
+    pixels_.reset();
+    encoded_.clear();
     width_ = height_ = 0;
     runtimeUUID_ = 0;
     if (auto backend = backend_.lock()) {
@@ -238,9 +467,165 @@ void inDrainPendingTextureDisposals() {
     }
 }
 
+int inRenderTargetSizeClass(int v) {
+    if (v <= 64) return 64;
+    int octave = 64;
+    while (octave * 2 < v) octave *= 2;
+    const int step = octave / 4;
+    return (v + step - 1) / step * step;
+}
+
+std::shared_ptr<Texture> inAcquireRenderTarget(int w, int h, int channels, bool stencil) {
+    const auto backend = getCurrentRenderBackend();
+    const int widthClass = inRenderTargetSizeClass(w);
+    const int heightClass = inRenderTargetSizeClass(h);
+    std::shared_ptr<Texture> reused;
+    std::vector<std::shared_ptr<Texture>> orphaned;
+    {
+        std::lock_guard<std::mutex> lock(gRenderTargetPoolMutex);
+        pruneOrphanedRenderTargets(orphaned);
+        for (auto it = gFreeRenderTargets.rbegin(); it != gFreeRenderTargets.rend(); ++it) {
+            if (it->backendKey != backend.get() || it->widthClass != widthClass ||
+                it->heightClass != heightClass || it->channels != channels || it->stencil != stencil) {
+                continue;
+            }
+            reused = std::move(it->texture);
+            gFreeRenderTargets.erase(std::next(it).base());
+            break;
+        }
+    }
+    for (auto& tex : orphaned) tex->dispose();
+    if (!reused) return Texture::createRenderTarget(w, h, channels, stencil);
+    reused->resizeRenderTarget(w, h);
+    return reused;
+}
+
+void inReleaseRenderTarget(const std::shared_ptr<Texture>& target) {
+    if (!target) return;
+    if (!target->renderTarget()) {
+        target->dispose();
+        return;
+    }
+    auto backend = target->renderBackend();
+    if (!backend) return;
+    std::vector<std::shared_ptr<Texture>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(gRenderTargetPoolMutex);
+        pruneOrphanedRenderTargets(evicted);
+        FreeRenderTarget entry{backend, backend.get(), inRenderTargetSizeClass(target->width()),
+                               inRenderTargetSizeClass(target->height()), target->channels(), target->stencil(), target};
+        std::size_t sameClass = 0;
+        for (auto it = gFreeRenderTargets.rbegin(); it != gFreeRenderTargets.rend(); ++it) {
+            if (it->backendKey == entry.backendKey && it->widthClass == entry.widthClass && it->heightClass == entry.heightClass &&
+                it->channels == entry.channels && it->stencil == entry.stencil && ++sameClass >= kMaxFreeRenderTargetsPerClass) {
+                evicted.push_back(std::move(it->texture));
+                gFreeRenderTargets.erase(std::next(it).base());
+                break;
+            }
+        }
+        gFreeRenderTargets.push_back(std::move(entry));
+        while (gFreeRenderTargets.size() > kMaxFreeRenderTargets) {
+            evicted.push_back(std::move(gFreeRenderTargets.front().texture));
+            gFreeRenderTargets.erase(gFreeRenderTargets.begin());
+        }
+    }
+    for (auto& tex : evicted) tex->dispose();
+}
+
+void inClearRenderTargetPool() {
+    std::vector<FreeRenderTarget> free;
+    {
+        std::lock_guard<std::mutex> lock(gRenderTargetPoolMutex);
+        free.swap(gFreeRenderTargets);
+    }
+    for (auto& entry : free) entry.texture->dispose();
+}
+
+void inDecodeTextures(const std::vector<EncodedImage>& images,
+                      const std::function<void(std::size_t, ShallowTexture&&)>& sink) {
+    auto& pool = textureDecodePool();
+    const std::size_t window = pool.threadCount();
+    std::vector<ShallowTexture> decoded;
+    for (std::size_t base = 0; base < images.size(); base += window) {
+        const std::size_t count = (std::min)(window, images.size() - base);
+        decoded.assign(count, ShallowTexture{});
+        pool.parallelFor(count, [&](std::size_t i) {
+            decoded[i] = ShallowTexture(images[base + i].data, images[base + i].length);
+        });
+        for (std::size_t i = 0; i < count; ++i) sink(base + i, std::move(decoded[i]));
+    }
+}
+
+void inSetTextureDecodeThreadCount(std::size_t threadCount) {
+    textureDecodePool().setThreadCount(threadCount);
+}
+
+std::vector<std::shared_ptr<Texture>> inLoadTextureSlots(const std::vector<EncodedImage>& images, bool deferDecode) {
+    const auto form = deferDecode ? CachedTextureForm::Deferred : CachedTextureForm::Decoded;
+    std::vector<std::shared_ptr<Texture>> slots(images.size());
+    std::vector<TextureCacheKey> keys;
+    keys.reserve(images.size());
+    // Misses are loaded once even if several slots of this load carry the same bytes.
+    std::unordered_map<TextureCacheKey, std::size_t, TextureCacheKeyHash> firstMiss;
+    std::vector<std::size_t> duplicates;
+    std::vector<EncodedImage> missing;
+    std::vector<std::size_t> missingSlots;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        keys.push_back(textureCacheKey(images[i].data, images[i].length, form));
+        if ((slots[i] = findCachedTexture(keys[i], images[i].data))) continue;
+        if (!firstMiss.try_emplace(keys[i], i).second) {
+            duplicates.push_back(i);
+            continue;
+        }
+        missing.push_back(images[i]);
+        missingSlots.push_back(i);
+    }
+    auto store = [&](std::size_t slot, std::shared_ptr<Texture> tex) {
+        slots[slot] = cacheTexture(keys[slot], images[slot].data, std::move(tex));
+    };
+    if (deferDecode) {
+        for (std::size_t i = 0; i < missing.size(); ++i) store(missingSlots[i], std::make_shared<Texture>(missing[i]));
+    } else {
+        inDecodeTextures(missing, [&](std::size_t i, ShallowTexture&& shallow) {
+            store(missingSlots[i], std::make_shared<Texture>(std::move(shallow)));
+        });
+    }
+    if (!duplicates.empty()) {
+        std::lock_guard<std::mutex> lock(gTextureCacheMutex);
+        for (std::size_t i : duplicates) {
+            slots[i] = slots[firstMiss[keys[i]]];
+            ++gTextureCacheHits;
+        }
+    }
+    return slots;
+}
+
+std::shared_ptr<Texture> inLoadTextureSlot(const uint8_t* pixels, int width, int height, int channels) {
+    const std::size_t length = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * static_cast<std::size_t>(channels);
+    const uint64_t salt = (static_cast<uint64_t>(width) << 36) ^ (static_cast<uint64_t>(height) << 8) ^ static_cast<uint64_t>(channels);
+    const auto key = textureCacheKey(pixels, length, CachedTextureForm::Pixels, salt);
+    if (auto tex = findCachedTexture(key, pixels)) return tex;
+    ShallowTexture shallow;
+    shallow.data.assign(pixels, pixels + length);
+    shallow.width = width;
+    shallow.height = height;
+    shallow.channels = channels;
+    shallow.convChannels = channels;
+    return cacheTexture(key, pixels, std::make_shared<Texture>(std::move(shallow)));
+}
+
+TextureCacheStats inGetTextureCacheStats() {
+    std::lock_guard<std::mutex> lock(gTextureCacheMutex);
+    TextureCacheStats stats{gTextureCacheHits, gTextureCacheMisses, 0};
+    for (const auto& item : gTextureCache) {
+        if (!item.second.texture.expired()) ++stats.entries;
+    }
+    return stats;
+}
+
 void Texture::lock() {
     if (locked_) return;
-    lockedData_ = data_;
+    lockedData_ = data();
     modified_ = false;
     locked_ = true;
 }
@@ -249,15 +634,16 @@ void Texture::unlock() {
     if (!locked_) return;
     locked_ = false;
     if (modified_) {
-        data_ = lockedData_;
+        pixels_ = std::make_shared<const std::vector<uint8_t>>(std::move(lockedData_));
+        std::vector<uint8_t>().swap(encoded_);
         auto backend = backend_.lock();
         if (!backend) backend = getCurrentRenderBackend();
         if (backend) {
             backend_ = backend;
             if (backendId_ == 0) {
-                backendId_ = backend->createTexture(data_, width_, height_, channels_, stencil_);
+                backendId_ = backend->createTexture(pixels_, width_, height_, channels_, stencil_);
             } else {
-                backend->updateTexture(backendId_, data_, width_, height_, channels_);
+                backend->updateTexture(backendId_, pixels_, width_, height_, channels_);
             }
         }
     }
@@ -266,8 +652,9 @@ void Texture::unlock() {
 }
 
 uint32_t Texture::nextUUID() {
-    static uint32_t counter = 1;
-    return counter++;
+    // Puppets may load on background threads.
+    static std::atomic<uint32_t> counter{1};
+    return counter.fetch_add(1, std::memory_order_relaxed);
 }
 
 } // namespace nicxlive::core
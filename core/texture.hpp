@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -9,6 +11,10 @@ namespace nicxlive::core {
 
 class RenderBackend;
 
+// Decoded pixels, shared by reference between a Texture and the backend commands that upload
+// them. A published buffer is never written again; changing pixels publishes a new one.
+using TexturePixels = std::shared_ptr<const std::vector<uint8_t>>;
+
 enum class Filtering {
     Linear,
     Nearest,
@@ -29,20 +35,40 @@ struct ShallowTexture {
     ShallowTexture() = default;
     ShallowTexture(const std::string& file, int channels = 0);
     ShallowTexture(const std::vector<uint8_t>& buffer, int channels = 0);
+    // Decodes an encoded image (PNG/TGA/...) straight from caller-owned bytes.
+    ShallowTexture(const uint8_t* bytes, std::size_t length, int channels = 0);
     ShallowTexture(const std::vector<uint8_t>& buffer, int w, int h, int channels = 4);
     ShallowTexture(const std::vector<uint8_t>& buffer, int w, int h, int channels, int convChannels);
 };
 
+// Encoded image bytes (PNG/TGA/...) owned by the caller.
+struct EncodedImage {
+    const uint8_t* data{nullptr};
+    std::size_t length{0};
+};
+
 class Texture {
 public:
     Texture() = default;
     Texture(const std::string& file, int channels = 0, bool useMipmaps = true);
     Texture(const ShallowTexture& shallow, bool useMipmaps = true);
+    // Takes over the decoded pixels instead of copying them.
+    Texture(ShallowTexture&& shallow, bool useMipmaps = true);
+    // Deferred: keeps a copy of the encoded bytes and reads only the image header (size/channels).
+    // Pixels are decoded by ensureDecoded(); no backend texture is created, hosts upload by runtime UUID.
+    explicit Texture(EncodedImage image, bool useMipmaps = true);
     Texture(int w, int h, int channels = 4, bool stencil = false, bool useMipmaps = true);
     Texture(const std::vector<uint8_t>& data, int width, int height, int inChannels = 4, int outChannels = 4, bool stencil = false, bool useMipmaps = true);
 
     virtual ~Texture();
 
+    // Render target: backend texture only, no CPU pixels (the GPU side owns the contents).
+    static std::shared_ptr<Texture> createRenderTarget(int w, int h, int channels = 4, bool stencil = false);
+    bool renderTarget() const { return renderTarget_; }
+    // Gives a render target a new size, keeping its backend texture id.
+    void resizeRenderTarget(int w, int h);
+    std::shared_ptr<RenderBackend> renderBackend() const { return backend_.lock(); }
+
     virtual void setFiltering(bool point);
     virtual void setFiltering(Filtering mode);
     virtual void setWrapping(Wrapping mode);
@@ -56,7 +82,18 @@ public:
     virtual uint32_t getRuntimeUUID() const { return runtimeUUID_; }
     virtual void setRuntimeUUID(uint32_t v) { runtimeUUID_ = v; }
 
-    const std::vector<uint8_t>& data() const { return data_; }
+    const std::vector<uint8_t>& data() const;
+    const TexturePixels& pixels() const { return pixels_; }
+    // Decodes the kept encoded bytes if the pixels are not resident; false if there are none.
+    bool ensureDecoded();
+    // Drops the pixels of a texture that can decode them again; returns the bytes freed.
+    std::size_t releasePixels();
+    // Drops the pixels even if they cannot be restored (the host holds the only copy); returns the
+    // bytes freed. A deferred texture keeps its encoded payload.
+    std::size_t discardPixels();
+    bool hasEncodedSource() const { return !encoded_.empty(); }
+    bool pixelsResident() const { return pixels_ && !pixels_->empty(); }
+    const std::vector<uint8_t>& encodedData() const { return encoded_; }
     int width() const { return width_; }
     int height() const { return height_; }
     int channels() const { return channels_; }
@@ -66,18 +103,22 @@ public:
 
 private:
     static uint32_t nextUUID();
-    void initFromData(const std::vector<uint8_t>& data, int width, int height, int inChannels, int outChannels, bool stencil, bool useMipmaps);
+    // Shallow textures that still hold encoded bytes (no decoded size yet).
+    void initFromEncoded(const ShallowTexture& shallow, bool useMipmaps);
+    void initFromData(std::vector<uint8_t> data, int width, int height, int inChannels, int outChannels, bool stencil, bool useMipmaps);
     void disposeDeferred();
 
     int width_{0};
     int height_{0};
     int channels_{4};
     bool stencil_{false};
+    bool renderTarget_{false};
     bool useMipmaps_{true};
     Filtering filtering_{Filtering::Linear};
     Wrapping wrapping_{Wrapping::Clamp};
     float anisotropy_{1.0f};
-    std::vector<uint8_t> data_{};
+    TexturePixels pixels_{};
+    std::vector<uint8_t> encoded_{};
     bool locked_{false};
     bool modified_{false};
     std::vector<uint8_t> lockedData_{};
@@ -88,4 +129,40 @@ private:
 
 void inDrainPendingTextureDisposals();
 
+// Free render targets grouped by size class (quarter-octave steps), per backend and format.
+// Re-creating a target of a similar size, as a composite following its bounds does, resizes a free
+// one instead of creating and disposing backend textures. Only a few free targets are kept per class.
+// 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, ...: a class spans at most a quarter octave.
+int inRenderTargetSizeClass(int v);
+std::shared_ptr<Texture> inAcquireRenderTarget(int w, int h, int channels = 4, bool stencil = false);
+void inReleaseRenderTarget(const std::shared_ptr<Texture>& target);
+// Disposes every free render target.
+void inClearRenderTargetPool();
+
+// Decodes `images` on the texture decode pool and hands each result to `sink` on the calling thread,
+// in index order. Images are decoded one window (pool size) at a time, so only that many decoded
+// buffers are in flight regardless of how many slots a puppet has.
+void inDecodeTextures(const std::vector<EncodedImage>& images,
+                      const std::function<void(std::size_t, ShallowTexture&&)>& sink);
+// Threads inDecodeTextures uses, counting the caller (0: hardware concurrency, 1: decode inline).
+void inSetTextureDecodeThreadCount(std::size_t threadCount);
+
+// Process-wide content-addressed texture cache. Slots loaded from the same payload bytes (across
+// puppets, variants and renderers) get the same Texture, so its pixels are decoded and held once
+// and each renderer creates one host texture for it (hosts key them by runtime UUID). Entries are
+// weak: a texture lives as long as a puppet uses it. A texture whose pixels were edited or dropped
+// for good (releaseAfterUpload) is not handed out again; the next load decodes a fresh one.
+struct TextureCacheStats {
+    std::size_t hits{0};    // slots served by a live cached texture
+    std::size_t misses{0};  // slots decoded (or kept encoded) because none matched
+    std::size_t entries{0}; // live cached textures
+};
+
+// Texture slots for `images`, in order. Cache misses are decoded on the texture decode pool, or keep
+// their encoded payload when `deferDecode` (deferred and decoded slots are cached apart).
+std::vector<std::shared_ptr<Texture>> inLoadTextureSlots(const std::vector<EncodedImage>& images, bool deferDecode);
+// The same for already decoded pixels (`width` x `height` x `channels` bytes).
+std::shared_ptr<Texture> inLoadTextureSlot(const uint8_t* pixels, int width, int height, int channels);
+TextureCacheStats inGetTextureCacheStats();
+
 } // namespace nicxlive::core
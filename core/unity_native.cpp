@@ -1,16 +1,29 @@
 // unity_native: C API bridging for Unity plugin (queue backend path)
 
 #include "unity_native.hpp"
+#include "worker_pool.hpp"
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
 #include <exception>
+#include <list>
+#include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #if defined(_WIN32)
 #include <malloc.h>
 #include <windows.h>
@@ -32,29 +45,79 @@ using namespace nicxlive::core::render;
 namespace nodes = ::nicxlive::core::nodes;
 
 namespace {
+// Concurrency model: each RendererCtx / PuppetCtx carries its own mutex, so puppets tick and
+// renderers emit on independent threads. Lock order is renderer -> puppet, never the reverse.
 struct RendererCtx {
+    std::mutex mutex{};
     UnityRendererConfig cfg{};
     UnityResourceCallbacks callbacks{};
     std::shared_ptr<QueueRenderBackend> backend{std::make_shared<QueueRenderBackend>()};
+    // Deform/vertex/UV atlases for the puppets of this renderer only.
+    std::shared_ptr<SharedBufferSet> sharedBuffers{std::make_shared<SharedBufferSet>()};
     std::unique_ptr<RenderCommandEmitter> emitter{};
     std::unique_ptr<RenderGraphBuilder> graph{};
     std::unique_ptr<TaskScheduler> scheduler{};
     RenderContext ctx{};
     std::vector<QueuedCommand> recorded{}; // last emitted commands
-    TextureStats stats{0, 0, 0};
+    TextureStats stats{0, 0, 0, 0, 0, 0};
     SharedBufferSnapshot shared{};
     std::vector<float> packedVertices{};
     std::vector<float> packedUvs{};
     std::vector<float> packedDeform{};
     std::vector<NjgQueuedCommand> queued{};
+    std::vector<uint8_t> stream{}; // compact records for njgEmitCommandStream
+    std::size_t streamCount{0};
+    // Frame-level emit cache: a packed output is reused while the signature it was packed from
+    // (layout serial, viewport, each puppet's change serial) still matches.
+    struct EmitCache {
+        std::vector<std::size_t> signature{};
+        bool valid{false};
+    };
+    EmitCache queuedCache{};
+    EmitCache streamCache{};
+    std::size_t layoutSerial{0}; // bumped on load/unload
+    std::size_t emitSerial{0};   // bumped whenever an emit produced a new command list
+    bool lastEmitUnchanged{false};
+    std::vector<NjgQueuedCommand> deltaBase{}; // list the host holds after the last njgEmitCommandDelta
+    std::vector<uint8_t> delta{};
+    std::size_t deltaOps{0};
+    std::size_t deltaBaseCount{0};
     std::vector<void*> puppetHandles{};
     // Runtime texture UUIDs (loaded from puppet slots) -> Unity texture handles
     std::unordered_map<uint32_t, size_t> runtimeTextureHandles{};
     // Queue backend texture IDs (including dynamic RT/stencil) -> Unity texture handles
     std::unordered_map<uint32_t, size_t> backendTextureHandles{};
     uint32_t syntheticTextureIdCounter{0x70000000u};
+    NjgTexturePolicy texturePolicy{0, SIZE_MAX, 0};
+    // Uploaded deferred textures that still hold their pixels, least recently drawn first.
+    struct ResidentTexture {
+        uint32_t uuid{0};
+        std::weak_ptr<Texture> texture{};
+        std::size_t bytes{0};
+    };
+    std::list<ResidentTexture> residentTextures{};
+    std::unordered_map<uint32_t, std::list<ResidentTexture>::iterator> residentIndex{};
+    std::size_t residentBytes{0};
     size_t renderHandle{0};
     size_t compositeHandle{0};
+    // Host render targets (viewport targets and GPU-only composite surfaces). Ones no longer bound
+    // are parked per size class and handed out again on an exact-size request, so window resizes
+    // and composite bounds that go back and forth do not create and release host textures.
+    struct HostTarget {
+        size_t handle{0};
+        int width{0};
+        int height{0};
+        int channels{0};
+        bool stencil{false};
+        std::size_t freedFrame{0};
+    };
+    static constexpr std::size_t kMaxFreeTargetsPerClass = 4;
+    static constexpr std::size_t kMaxFreeTargets = 32;
+    static constexpr std::size_t kTargetIdleFrames = 120;
+    std::unordered_map<size_t, HostTarget> hostTargets{};                  // bound, by host handle
+    std::unordered_map<uint64_t, std::vector<HostTarget>> freeTargets{};   // parked, oldest first
+    std::size_t freeTargetCount{0};
+    std::size_t frameIndex{0}; // njgBeginFrame count
     int lastViewportW{0};
     int lastViewportH{0};
     struct AnimationState {
@@ -70,12 +133,100 @@ struct RendererCtx {
 };
 
 struct PuppetCtx {
+    std::mutex mutex{};
     std::shared_ptr<Puppet> puppet{};
+    // Host-side input (parameters, transform, animation) arrived since the last update.
+    bool inputsDirty{true};
+    // The render graph built by the last update has not been drawn yet.
+    bool graphPending{false};
+    // Bumped by every update whose output may differ from the previous one.
+    std::size_t changeSerial{0};
 };
 
-std::mutex gMutex;
-std::unordered_map<void*, std::unique_ptr<RendererCtx>> gRenderers;
-std::unordered_map<void*, std::unique_ptr<PuppetCtx>> gPuppets;
+// Copy-on-write handle table: lookups read an immutable snapshot without taking a lock,
+// create/destroy publish a new snapshot. Contexts are shared_ptr-owned so a lookup keeps
+// its context alive even if the handle is destroyed concurrently.
+template <typename T>
+class HandleTable {
+public:
+    using Map = std::unordered_map<void*, std::shared_ptr<T>>;
+
+    HandleTable() { store(std::make_shared<const Map>()); }
+
+    std::shared_ptr<T> find(void* handle) const {
+        if (!handle) return nullptr;
+        auto snap = snapshot();
+        auto it = snap->find(handle);
+        return it == snap->end() ? nullptr : it->second;
+    }
+
+    std::shared_ptr<const Map> snapshot() const { return load(); }
+
+    void insert(void* handle, std::shared_ptr<T> value) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        auto next = std::make_shared<Map>(*load());
+        (*next)[handle] = std::move(value);
+        store(std::move(next));
+    }
+
+    std::shared_ptr<T> erase(void* handle) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        auto current = load();
+        auto it = current->find(handle);
+        if (it == current->end()) return nullptr;
+        auto removed = it->second;
+        auto next = std::make_shared<Map>(*current);
+        next->erase(handle);
+        store(std::move(next));
+        return removed;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        store(std::make_shared<const Map>());
+    }
+
+private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::shared_ptr<const Map> load() const { return map_.load(std::memory_order_acquire); }
+    void store(std::shared_ptr<const Map> next) { map_.store(std::move(next), std::memory_order_release); }
+    std::atomic<std::shared_ptr<const Map>> map_{};
+#else
+    std::shared_ptr<const Map> load() const { return std::atomic_load_explicit(&map_, std::memory_order_acquire); }
+    void store(std::shared_ptr<const Map> next) { std::atomic_store_explicit(&map_, std::move(next), std::memory_order_release); }
+    std::shared_ptr<const Map> map_{};
+#endif
+    std::mutex writeMutex_{};
+};
+
+// One njgLoadPuppetAsync job. The loader thread fills `puppet` and then publishes stage Ready;
+// from there on only the polling thread touches the puppet.
+struct LoadJob {
+    void* renderer{nullptr};
+    std::string path{};
+    std::atomic<NjgLoadStage> stage{NjgLoadStage::Queued};
+    std::atomic<bool> cancelled{false};
+    fmt::PuppetLoadOptions options{};
+    // Backend of the target renderer; textures created during the load queue their uploads there.
+    std::shared_ptr<QueueRenderBackend> backend{};
+    std::shared_ptr<Puppet> puppet{};
+    std::string error{};
+    // Set once the job is finalized, cancelled or drained; the loader thread waits for it before
+    // freeing its staging atlas set (see runLoadJob).
+    std::mutex handOffMutex{};
+    std::condition_variable handOff{};
+    bool handedOff{false};
+};
+
+HandleTable<RendererCtx> gRenderers;
+HandleTable<PuppetCtx> gPuppets;
+HandleTable<LoadJob> gLoads;
+std::mutex gLoaderMutex;                 // gActiveLoaders
+std::condition_variable gLoadersIdle{};
+std::size_t gActiveLoaders{0};
+std::mutex gRuntimeMutex;     // runtime init flag, log callback
+std::mutex gRenderStateMutex; // process-wide viewport stack / current backend
+std::mutex gTimeMutex;        // gUnityTimeTicker + inUpdate()
 NjgLogFn gLogCallback{nullptr};
 void* gLogUserData{nullptr};
 bool gRuntimeInitialized{false};
@@ -160,12 +311,6 @@ void unityLog(const std::string& message) {
     }
 }
 
-template <typename T>
-void destroyHandle(std::unordered_map<void*, std::unique_ptr<T>>& map, void* h) {
-    std::lock_guard<std::mutex> lock(gMutex);
-    map.erase(h);
-}
-
 RendererCtx::AnimationState* findAnimationState(RendererCtx& renderer, void* puppet, const std::string& name) {
     auto pit = renderer.animationStates.find(puppet);
     if (pit == renderer.animationStates.end()) return nullptr;
@@ -178,14 +323,180 @@ RendererCtx::AnimationState* ensureAnimationState(RendererCtx& renderer, void* p
     return &renderer.animationStates[puppet][name];
 }
 
+// Returns true if any animation cursor of the puppet moved.
+static bool advanceAnimationCursors(void* puppet, double deltaSeconds) {
+    // Animation cursors live on the renderer; take each renderer lock briefly and release it
+    // before locking the puppet to keep the renderer -> puppet lock order.
+    bool advanced = false;
+    auto renderers = gRenderers.snapshot();
+    for (const auto& rendererPair : *renderers) {
+        auto& renderer = *rendererPair.second;
+        std::lock_guard<std::mutex> rendererLock(renderer.mutex);
+        auto pit = renderer.animationStates.find(puppet);
+        if (pit == renderer.animationStates.end()) continue;
+        for (auto& animPair : pit->second) {
+            auto& state = animPair.second;
+            if (!state.playing || state.paused) continue;
+            state.frame += (std::max)(1, static_cast<int>(deltaSeconds * 60.0));
+            advanced = true;
+        }
+    }
+    return advanced;
+}
+
+static void advanceRuntimeClock(double deltaSeconds) {
+    std::lock_guard<std::mutex> timeLock(gTimeMutex);
+    if (std::isfinite(deltaSeconds) && deltaSeconds > 0.0) {
+        gUnityTimeTicker += deltaSeconds;
+    }
+    inUpdate();
+}
+
+// ctx.mutex must be held.
+static void runPuppetUpdate(PuppetCtx& ctx) {
+    const bool inputs = ctx.inputsDirty;
+    ctx.inputsDirty = false;
+    ctx.puppet->update();
+    ctx.graphPending = true;
+    if (inputs || !ctx.puppet->isSettled()) ++ctx.changeSerial;
+}
+
+static void updatePuppetCtx(PuppetCtx& ctx, bool animating) {
+    std::lock_guard<std::mutex> lock(ctx.mutex);
+    if (animating) ctx.inputsDirty = true;
+    // Idle puppet: nothing arrived from the host and the previous update changed nothing, so this
+    // one would not either. The emit side reuses the last packed frame.
+    if (!ctx.inputsDirty && ctx.puppet->isSettled()) return;
+    NJCX_DBG_LOG("[nicxlive] tick update start\n");
+    runPuppetUpdate(ctx);
+    NJCX_DBG_LOG("[nicxlive] tick update end graphEmpty=%d rootParts=%zu\n", ctx.puppet->isRenderGraphEmpty() ? 1 : 0, ctx.puppet->rootPartCount());
+}
+
+static void markPuppetInputs(PuppetCtx& ctx) {
+    ctx.inputsDirty = true;
+}
+
+static void releaseExternalTexture(RendererCtx& ctx, size_t handle) {
+    if (handle == 0) return;
+    if (ctx.callbacks.releaseTexture) {
+        ctx.callbacks.releaseTexture(handle, ctx.callbacks.userData);
+    }
+    ctx.stats.released++;
+    if (ctx.stats.current > 0) ctx.stats.current--;
+}
+
+static uint64_t renderTargetClassKey(const RendererCtx::HostTarget& target) {
+    return (static_cast<uint64_t>(inRenderTargetSizeClass(target.width)) << 32) |
+           (static_cast<uint64_t>(inRenderTargetSizeClass(target.height)) << 4) |
+           (static_cast<uint64_t>(target.channels & 0x7) << 1) | (target.stencil ? 1u : 0u);
+}
+
+// A host render target of exactly this shape: a free one from the pool if there is one,
+// otherwise a new one. Hosts size their viewport from the texture, so only exact sizes match.
+static size_t acquireHostTarget(RendererCtx& ctx, int width, int height, int channels, bool stencil) {
+    RendererCtx::HostTarget shape{0, width, height, channels, stencil, 0};
+    auto bucket = ctx.freeTargets.find(renderTargetClassKey(shape));
+    if (bucket != ctx.freeTargets.end()) {
+        auto& free = bucket->second;
+        for (auto it = free.rbegin(); it != free.rend(); ++it) {
+            if (it->width != width || it->height != height) continue;
+            shape.handle = it->handle;
+            free.erase(std::next(it).base());
+            if (free.empty()) ctx.freeTargets.erase(bucket);
+            --ctx.freeTargetCount;
+            ctx.hostTargets[shape.handle] = shape;
+            return shape.handle;
+        }
+    }
+    if (!ctx.callbacks.createTexture) return 0;
+    shape.handle = ctx.callbacks.createTexture(width, height, channels, 1, channels, /*renderTarget*/ true, stencil,
+                                               ctx.callbacks.userData);
+    if (shape.handle == 0) return 0;
+    ctx.stats.created++;
+    ctx.stats.current++;
+    ctx.hostTargets[shape.handle] = shape;
+    return shape.handle;
+}
+
+static void evictOldestFreeTarget(RendererCtx& ctx) {
+    auto oldestBucket = ctx.freeTargets.end();
+    for (auto it = ctx.freeTargets.begin(); it != ctx.freeTargets.end(); ++it) {
+        if (oldestBucket == ctx.freeTargets.end() || it->second.front().freedFrame < oldestBucket->second.front().freedFrame) {
+            oldestBucket = it;
+        }
+    }
+    if (oldestBucket == ctx.freeTargets.end()) return;
+    releaseExternalTexture(ctx, oldestBucket->second.front().handle);
+    oldestBucket->second.erase(oldestBucket->second.begin());
+    if (oldestBucket->second.empty()) ctx.freeTargets.erase(oldestBucket);
+    --ctx.freeTargetCount;
+}
+
+// Parks a host render target for reuse; handles that did not come from acquireHostTarget
+// are released right away.
+static void recycleHostTarget(RendererCtx& ctx, size_t handle) {
+    if (handle == 0) return;
+    auto live = ctx.hostTargets.find(handle);
+    if (live == ctx.hostTargets.end()) {
+        releaseExternalTexture(ctx, handle);
+        return;
+    }
+    auto shape = live->second;
+    ctx.hostTargets.erase(live);
+    shape.freedFrame = ctx.frameIndex;
+    auto& free = ctx.freeTargets[renderTargetClassKey(shape)];
+    if (free.size() >= RendererCtx::kMaxFreeTargetsPerClass) {
+        releaseExternalTexture(ctx, free.front().handle);
+        free.erase(free.begin());
+        --ctx.freeTargetCount;
+    }
+    free.push_back(shape);
+    ++ctx.freeTargetCount;
+    while (ctx.freeTargetCount > RendererCtx::kMaxFreeTargets) evictOldestFreeTarget(ctx);
+}
+
+// Releases free targets nobody asked for within kTargetIdleFrames frames.
+static void evictIdleTargets(RendererCtx& ctx) {
+    for (auto bucket = ctx.freeTargets.begin(); bucket != ctx.freeTargets.end();) {
+        auto& free = bucket->second;
+        while (!free.empty() && ctx.frameIndex - free.front().freedFrame > RendererCtx::kTargetIdleFrames) {
+            releaseExternalTexture(ctx, free.front().handle);
+            free.erase(free.begin());
+            --ctx.freeTargetCount;
+        }
+        bucket = free.empty() ? ctx.freeTargets.erase(bucket) : std::next(bucket);
+    }
+}
+
+static void releaseFreeTargets(RendererCtx& ctx) {
+    for (const auto& bucket : ctx.freeTargets) {
+        for (const auto& target : bucket.second) releaseExternalTexture(ctx, target.handle);
+    }
+    ctx.freeTargets.clear();
+    ctx.freeTargetCount = 0;
+}
+
 static void applyTextureCommands(RendererCtx& ctx) {
-    if (!ctx.callbacks.createTexture && !ctx.callbacks.updateTexture && !ctx.callbacks.releaseTexture) return;
-    for (const auto& rc : ctx.backend->resourceQueue) {
+    thread_local std::vector<TextureCommand> pending;
+    ctx.backend->takeResourceQueue(pending);
+    // Commands share the textures' pixel buffers; never keep them past this call.
+    if (!ctx.callbacks.createTexture && !ctx.callbacks.updateTexture && !ctx.callbacks.releaseTexture) {
+        pending.clear();
+        return;
+    }
+    for (const auto& rc : pending) {
         switch (rc.kind) {
         case TextureCommandKind::Create: {
             break;
         }
         case TextureCommandKind::Update: {
+            // A render target resized in place (pooled surface); hosts cannot resize through
+            // updateTexture, so park the handle and let the next pack pick one of the new size.
+            auto it = rc.data ? ctx.backendTextureHandles.end() : ctx.backendTextureHandles.find(rc.id);
+            if (it != ctx.backendTextureHandles.end()) {
+                recycleHostTarget(ctx, it->second);
+                ctx.backendTextureHandles.erase(it);
+            }
             break;
         }
         case TextureCommandKind::Params:
@@ -194,18 +505,14 @@ static void applyTextureCommands(RendererCtx& ctx) {
         case TextureCommandKind::Dispose: {
             auto it = ctx.backendTextureHandles.find(rc.id);
             if (it != ctx.backendTextureHandles.end()) {
-                if (ctx.callbacks.releaseTexture) {
-                    ctx.callbacks.releaseTexture(it->second, ctx.callbacks.userData);
-                }
+                recycleHostTarget(ctx, it->second);
                 ctx.backendTextureHandles.erase(it);
-                ctx.stats.released++;
-                if (ctx.stats.current > 0) ctx.stats.current--;
             }
             break;
         }
         }
     }
-    ctx.backend->resourceQueue.clear();
+    pending.clear();
 }
 
 static uint32_t allocateSyntheticTextureId(RendererCtx& ctx) {
@@ -221,10 +528,29 @@ static uint32_t allocateSyntheticTextureId(RendererCtx& ctx) {
     return 0;
 }
 
+// Hands the texture's pixels to the host without copying them. The host copies them during
+// updateTexture, so with releaseAfterUpload the CPU pixels are dropped as soon as it returns.
+static bool uploadRuntimeTexture(RendererCtx& ctx, uint32_t uuid, Texture& tex) {
+    size_t handle = ctx.callbacks.createTexture(tex.width(), tex.height(), tex.channels(), 1, tex.channels(),
+                                                /*renderTarget*/ false, tex.stencil(), ctx.callbacks.userData);
+    if (handle == 0) return false;
+    ctx.runtimeTextureHandles[uuid] = handle;
+    const auto& data = tex.data();
+    if (!data.empty() && ctx.callbacks.updateTexture) {
+        ctx.callbacks.updateTexture(handle, data.data(), data.size(), tex.width(), tex.height(), tex.channels(), ctx.callbacks.userData);
+    }
+    ctx.stats.created++;
+    ctx.stats.current++;
+    if (ctx.texturePolicy.releaseAfterUpload) tex.discardPixels();
+    return true;
+}
+
 static void ensurePuppetTextures(RendererCtx& ctx, const std::shared_ptr<Puppet>& puppet) {
     if (!puppet || !ctx.callbacks.createTexture) return;
     for (const auto& tex : puppet->textureSlots) {
         if (!tex) continue;
+        // Deferred slots are uploaded by uploadReferencedTextures once a part draws them.
+        if (tex->hasEncodedSource() && !tex->pixelsResident()) continue;
         uint32_t uuid = tex->getRuntimeUUID();
         if (uuid == 0) {
             uuid = allocateSyntheticTextureId(ctx);
@@ -232,16 +558,64 @@ static void ensurePuppetTextures(RendererCtx& ctx, const std::shared_ptr<Puppet>
         }
         if (uuid == 0) continue;
         if (ctx.runtimeTextureHandles.find(uuid) != ctx.runtimeTextureHandles.end()) continue;
-        size_t handle = ctx.callbacks.createTexture(tex->width(), tex->height(), tex->channels(), 1, tex->channels(),
-                                                    /*renderTarget*/ false, tex->stencil(), ctx.callbacks.userData);
-        if (handle != 0) {
-            ctx.runtimeTextureHandles[uuid] = handle;
-            const auto& data = tex->data();
-            if (!data.empty() && ctx.callbacks.updateTexture) {
-                ctx.callbacks.updateTexture(handle, data.data(), data.size(), tex->width(), tex->height(), tex->channels(), ctx.callbacks.userData);
+        uploadRuntimeTexture(ctx, uuid, *tex);
+    }
+}
+
+static void forgetResidentTexture(RendererCtx& ctx, uint32_t uuid) {
+    auto it = ctx.residentIndex.find(uuid);
+    if (it == ctx.residentIndex.end()) return;
+    ctx.residentBytes -= it->second->bytes;
+    ctx.residentTextures.erase(it->second);
+    ctx.residentIndex.erase(it);
+}
+
+// Drops the pixels of the least recently drawn deferred textures until the policy budget holds.
+static void trimResidentTextures(RendererCtx& ctx) {
+    while (ctx.residentBytes > ctx.texturePolicy.residentBudgetBytes && !ctx.residentTextures.empty()) {
+        auto& oldest = ctx.residentTextures.front();
+        if (auto tex = oldest.texture.lock()) tex->releasePixels();
+        ctx.residentBytes -= oldest.bytes;
+        ctx.residentIndex.erase(oldest.uuid);
+        ctx.residentTextures.pop_front();
+    }
+}
+
+// Decodes and uploads the deferred textures drawn by queue[first..]; already uploaded ones are
+// marked as recently used. The drawing puppet's mutex must be held (its textures are touched).
+static void uploadReferencedTextures(RendererCtx& ctx, std::size_t first) {
+    if (!ctx.callbacks.createTexture) return;
+    auto visit = [&](const nodes::PartDrawPacket& packet) {
+        std::shared_ptr<nodes::Part> node;
+        for (std::size_t i = 0; i < 3; ++i) {
+            const uint32_t uuid = packet.textureUUIDs[i];
+            if (uuid == 0) continue;
+            if (ctx.runtimeTextureHandles.find(uuid) != ctx.runtimeTextureHandles.end()) {
+                auto resident = ctx.residentIndex.find(uuid);
+                if (resident != ctx.residentIndex.end()) {
+                    ctx.residentTextures.splice(ctx.residentTextures.end(), ctx.residentTextures, resident->second);
+                }
+                continue;
             }
-            ctx.stats.created++;
-            ctx.stats.current++;
+            if (!node) node = packet.node.lock();
+            if (!node || i >= node->textures.size()) break;
+            const auto& tex = node->textures[i];
+            if (!tex || tex->getRuntimeUUID() != uuid || !tex->hasEncodedSource()) continue;
+            if (!tex->ensureDecoded() || !uploadRuntimeTexture(ctx, uuid, *tex)) continue;
+            if (!tex->pixelsResident()) continue;
+            const auto bytes = tex->data().size();
+            ctx.residentTextures.push_back(RendererCtx::ResidentTexture{uuid, tex, bytes});
+            ctx.residentIndex[uuid] = std::prev(ctx.residentTextures.end());
+            ctx.residentBytes += bytes;
+        }
+    };
+    for (std::size_t i = first; i < ctx.backend->queue.size(); ++i) {
+        const auto& cmd = ctx.backend->queue[i];
+        if (cmd.kind == RenderCommandKind::DrawPart) {
+            visit(cmd.partPacket);
+        } else if (cmd.kind == RenderCommandKind::ApplyMask &&
+                   cmd.maskApplyPacket.kind == nicxlive::core::RenderBackend::MaskDrawableKind::Part) {
+            visit(cmd.maskApplyPacket.partPacket);
         }
     }
 }
@@ -263,6 +637,13 @@ static size_t ensureDynamicTextureHandle(RendererCtx& ctx, const std::shared_ptr
     const int w = tex->width();
     const int h = tex->height();
     const int c = tex->channels();
+    if (tex->renderTarget()) {
+        // GPU-only surface: the host allocates it; there are no CPU pixels to upload.
+        size_t handle = acquireHostTarget(ctx, w, h, c, stencil);
+        if (handle == 0) return backendId;
+        ctx.backendTextureHandles[backendId] = handle;
+        return handle;
+    }
     size_t handle = ctx.callbacks.createTexture(w, h, c, 1, c, renderTarget, stencil, ctx.callbacks.userData);
     if (handle == 0) {
         return backendId;
@@ -272,18 +653,17 @@ static size_t ensureDynamicTextureHandle(RendererCtx& ctx, const std::shared_ptr
     ctx.stats.created++;
     ctx.stats.current++;
 
-    std::vector<uint8_t> upload;
     std::size_t expected = 0;
     if (w > 0 && h > 0 && c > 0) {
         expected = static_cast<std::size_t>(w) * static_cast<std::size_t>(h) * static_cast<std::size_t>(c);
     }
-    if (expected > 0) {
-        upload.resize(expected, 0);
-        const auto& data = tex->data();
-        if (!data.empty()) {
-            auto copyLen = (std::min)(expected, data.size());
-            std::copy_n(data.begin(), copyLen, upload.begin());
-        }
+    const auto& data = tex->data();
+    if (expected > 0 && data.size() >= expected) {
+        // Hand the texture's own buffer over; only short (or missing) pixels need a padded copy.
+        ctx.callbacks.updateTexture(handle, data.data(), expected, w, h, c, ctx.callbacks.userData);
+    } else if (expected > 0) {
+        std::vector<uint8_t> upload(expected, 0);
+        std::copy(data.begin(), data.end(), upload.begin());
         ctx.callbacks.updateTexture(handle, upload.data(), upload.size(), w, h, c, ctx.callbacks.userData);
     } else {
         ctx.callbacks.updateTexture(handle, nullptr, 0, w, h, c, ctx.callbacks.userData);
@@ -293,21 +673,21 @@ static size_t ensureDynamicTextureHandle(RendererCtx& ctx, const std::shared_ptr
 }
 
 
-static void releaseExternalTexture(RendererCtx& ctx, size_t handle) {
-    if (handle == 0) return;
-    if (ctx.callbacks.releaseTexture) {
-        ctx.callbacks.releaseTexture(handle, ctx.callbacks.userData);
-    }
-    ctx.stats.released++;
-    if (ctx.stats.current > 0) ctx.stats.current--;
-}
-
+// Releases the host textures of a puppet that is leaving `ctx`, except those still used by
+// another puppet of the renderer (instances share their template's texture objects).
 static void releasePuppetTextures(RendererCtx& ctx, const std::shared_ptr<Puppet>& puppet) {
     if (!puppet) return;
+    std::unordered_set<const Texture*> inUse;
+    for (void* handle : ctx.puppetHandles) {
+        auto other = gPuppets.find(handle);
+        if (!other || !other->puppet || other->puppet == puppet) continue;
+        for (const auto& tex : other->puppet->textureSlots) inUse.insert(tex.get());
+    }
     for (const auto& tex : puppet->textureSlots) {
-        if (!tex) continue;
+        if (!tex || inUse.count(tex.get())) continue;
         uint32_t uuid = tex->getRuntimeUUID();
         if (uuid == 0) continue;
+        forgetResidentTexture(ctx, uuid);
         auto it = ctx.runtimeTextureHandles.find(uuid);
         if (it != ctx.runtimeTextureHandles.end()) {
             releaseExternalTexture(ctx, it->second);
@@ -439,115 +819,648 @@ static void packPartPacket(RendererCtx& ctx, const nodes::PartDrawPacket& src, N
     dst.textureCount = textureCount;
 }
 
+static NjgRenderCommandKind toNjgCommandKind(RenderCommandKind kind) {
+    switch (kind) {
+    case RenderCommandKind::DrawPart: return NjgRenderCommandKind::DrawPart;
+    case RenderCommandKind::BeginDynamicComposite: return NjgRenderCommandKind::BeginDynamicComposite;
+    case RenderCommandKind::EndDynamicComposite: return NjgRenderCommandKind::EndDynamicComposite;
+    case RenderCommandKind::BeginMask: return NjgRenderCommandKind::BeginMask;
+    case RenderCommandKind::ApplyMask: return NjgRenderCommandKind::ApplyMask;
+    case RenderCommandKind::BeginMaskContent: return NjgRenderCommandKind::BeginMaskContent;
+    case RenderCommandKind::EndMask: return NjgRenderCommandKind::EndMask;
+    default: return NjgRenderCommandKind::DrawPart;
+    }
+}
+
+static ::MaskDrawableKind toNjgMaskKind(nicxlive::core::RenderBackend::MaskDrawableKind kind) {
+    switch (kind) {
+    case nicxlive::core::RenderBackend::MaskDrawableKind::Mask:
+        return ::MaskDrawableKind::Mask;
+    case nicxlive::core::RenderBackend::MaskDrawableKind::Part:
+    case nicxlive::core::RenderBackend::MaskDrawableKind::Drawable:
+    default:
+        return ::MaskDrawableKind::Part;
+    }
+}
+
+static void packMaskDrawPacket(RendererCtx& ctx, const nodes::MaskDrawPacket& mp, NjgMaskDrawPacket& dst) {
+    dst.modelMatrix = mp.modelMatrix;
+    dst.mvp = mp.mvp;
+    dst.origin = mp.origin;
+    dst.vertexOffset = mp.vertexOffset;
+    dst.vertexAtlasStride = mp.vertexAtlasStride;
+    dst.deformOffset = mp.deformOffset;
+    dst.deformAtlasStride = mp.deformAtlasStride;
+    dst.indexHandle = mp.indexBuffer;
+    auto midx = ctx.backend->getDrawableIndices(mp.indexBuffer);
+    if (midx && !midx->empty()) {
+        dst.indexCount = std::min<std::size_t>(mp.indexCount, midx->size());
+        dst.indices = midx->data();
+        dst.vertexCount = mp.vertexCount;
+    } else {
+        dst.indexCount = 0;
+        dst.vertexCount = 0;
+        dst.indices = nullptr;
+    }
+}
+
+static void packDynamicPass(RendererCtx& ctx, const DynamicCompositePass& src, NjgDynamicCompositePass& dst) {
+    // D parity
+    size_t dynTexCount = src.surface
+        ? src.surface->textureCount
+        : src.textures.size();
+    if (dynTexCount > 3) dynTexCount = 3;
+    dst.textureCount = dynTexCount;
+    for (size_t i = 0; i < dynTexCount; ++i) {
+        std::shared_ptr<Texture> tex{};
+        if (src.surface) {
+            tex = src.surface->textures[i];
+        } else if (i < src.textures.size()) {
+            tex = src.textures[i];
+        }
+        dst.textures[i] = ensureDynamicTextureHandle(ctx, tex, /*renderTarget*/ true, /*stencil*/ false);
+    }
+    for (size_t i = dynTexCount; i < 3; ++i) {
+        dst.textures[i] = 0;
+    }
+    auto stencilTex = src.stencil;
+    if (!stencilTex && src.surface) {
+        stencilTex = src.surface->stencil;
+    }
+    dst.stencil = ensureDynamicTextureHandle(ctx, stencilTex, /*renderTarget*/ true, /*stencil*/ true);
+    dst.scale = src.scale;
+    dst.rotationZ = src.rotationZ;
+    dst.autoScaled = src.autoScaled;
+    dst.origBuffer = src.origBuffer;
+    for (int i = 0; i < 4; ++i) dst.origViewport[i] = src.origViewport[i];
+    if (dst.origViewport[2] == 0 || dst.origViewport[3] == 0) {
+        int vw = 0;
+        int vh = 0;
+        inGetViewport(vw, vh);
+        dst.origViewport[0] = 0;
+        dst.origViewport[1] = 0;
+        dst.origViewport[2] = vw;
+        dst.origViewport[3] = vh;
+    }
+    dst.drawBufferCount = src.surface
+        ? static_cast<int>(std::max<std::size_t>(src.surface->textureCount, 1))
+        : 0;
+    dst.hasStencil = (src.surface && src.surface->stencil) || (dst.stencil != 0);
+}
+
 static void packQueuedCommands(RendererCtx& ctx) {
     auto profile = render::profileScope("Unity.packQueuedCommands");
     ctx.queued.clear();
     for (const auto& qc : ctx.backend->queue) {
         NjgQueuedCommand out{};
-        switch (qc.kind) {
-        case RenderCommandKind::DrawPart: out.kind = NjgRenderCommandKind::DrawPart; break;
-        case RenderCommandKind::BeginDynamicComposite: out.kind = NjgRenderCommandKind::BeginDynamicComposite; break;
-        case RenderCommandKind::EndDynamicComposite: out.kind = NjgRenderCommandKind::EndDynamicComposite; break;
-        case RenderCommandKind::BeginMask: out.kind = NjgRenderCommandKind::BeginMask; break;
-        case RenderCommandKind::ApplyMask: out.kind = NjgRenderCommandKind::ApplyMask; break;
-        case RenderCommandKind::BeginMaskContent: out.kind = NjgRenderCommandKind::BeginMaskContent; break;
-        case RenderCommandKind::EndMask: out.kind = NjgRenderCommandKind::EndMask; break;
-        default: out.kind = NjgRenderCommandKind::DrawPart; break;
-        }
+        out.kind = toNjgCommandKind(qc.kind);
         // Part packet
         const auto& pp = qc.partPacket;
         packPartPacket(ctx, pp, out.partPacket, (qc.kind == RenderCommandKind::DrawPart) ? 3 : 0);
         // Mask apply
-        switch (qc.maskApplyPacket.kind) {
-        case nicxlive::core::RenderBackend::MaskDrawableKind::Part:
-            out.maskApplyPacket.kind = ::MaskDrawableKind::Part;
+        out.maskApplyPacket.kind = toNjgMaskKind(qc.maskApplyPacket.kind);
+        out.maskApplyPacket.isDodge = qc.maskApplyPacket.isDodge;
+        // D parity: ApplyMask serializes its own part packet, not the current DrawPart packet.
+        packPartPacket(ctx, qc.maskApplyPacket.partPacket, out.maskApplyPacket.partPacket, 3);
+        packMaskDrawPacket(ctx, qc.maskApplyPacket.maskPacket, out.maskApplyPacket.maskPacket);
+        packDynamicPass(ctx, qc.dynamicPass, out.dynamicPass);
+        out.usesStencil = qc.usesStencil;
+        ctx.queued.push_back(out);
+    }
+}
+
+// Reserves one zero-filled, kNjgCommandAlign aligned record in the compact stream and returns its payload.
+static uint8_t* appendStreamRecord(std::vector<uint8_t>& stream, NjgRenderCommandKind kind, std::size_t payloadBytes) {
+    const std::size_t size = (sizeof(NjgCommandHeader) + payloadBytes + kNjgCommandAlign - 1) & ~(kNjgCommandAlign - 1);
+    const std::size_t at = stream.size();
+    stream.resize(at + size);
+    auto* header = reinterpret_cast<NjgCommandHeader*>(stream.data() + at);
+    header->kind = kind;
+    header->size = static_cast<uint32_t>(size);
+    return stream.data() + at + sizeof(NjgCommandHeader);
+}
+
+static_assert(sizeof(NjgCommandHeader) % kNjgCommandAlign == 0, "payloads start aligned");
+static_assert(alignof(NjgPartDrawPacket) <= kNjgCommandAlign && alignof(NjgMaskDrawPacket) <= kNjgCommandAlign &&
+                  alignof(NjgDynamicCompositePass) <= kNjgCommandAlign && sizeof(NjgMaskApplyHeader) % kNjgCommandAlign == 0,
+              "stream payloads must fit the record alignment");
+
+// Same commands as packQueuedCommands, but each record only carries the payload its kind reads,
+// so nothing is resolved (indices, textures, RT handles) for packets the host would ignore.
+static void packCommandStream(RendererCtx& ctx) {
+    auto profile = render::profileScope("Unity.packCommandStream");
+    ctx.stream.clear();
+    ctx.streamCount = 0;
+    for (const auto& qc : ctx.backend->queue) {
+        const auto kind = toNjgCommandKind(qc.kind);
+        switch (qc.kind) {
+        case RenderCommandKind::DrawPart: {
+            auto* packet = new (appendStreamRecord(ctx.stream, kind, sizeof(NjgPartDrawPacket))) NjgPartDrawPacket{};
+            packPartPacket(ctx, qc.partPacket, *packet, 3);
+            break;
+        }
+        case RenderCommandKind::ApplyMask: {
+            const auto maskKind = toNjgMaskKind(qc.maskApplyPacket.kind);
+            const bool usesMaskPacket = maskKind == ::MaskDrawableKind::Mask;
+            uint8_t* payload = appendStreamRecord(ctx.stream, kind,
+                                                  sizeof(NjgMaskApplyHeader) + (usesMaskPacket ? sizeof(NjgMaskDrawPacket) : sizeof(NjgPartDrawPacket)));
+            auto* apply = new (payload) NjgMaskApplyHeader{maskKind, qc.maskApplyPacket.isDodge ? 1u : 0u};
+            if (usesMaskPacket) {
+                auto* packet = new (payload + sizeof(*apply)) NjgMaskDrawPacket{};
+                packMaskDrawPacket(ctx, qc.maskApplyPacket.maskPacket, *packet);
+            } else {
+                auto* packet = new (payload + sizeof(*apply)) NjgPartDrawPacket{};
+                packPartPacket(ctx, qc.maskApplyPacket.partPacket, *packet, 3);
+            }
             break;
-        case nicxlive::core::RenderBackend::MaskDrawableKind::Mask:
-            out.maskApplyPacket.kind = ::MaskDrawableKind::Mask;
+        }
+        case RenderCommandKind::BeginDynamicComposite:
+        case RenderCommandKind::EndDynamicComposite: {
+            auto* pass = new (appendStreamRecord(ctx.stream, kind, sizeof(NjgDynamicCompositePass))) NjgDynamicCompositePass{};
+            packDynamicPass(ctx, qc.dynamicPass, *pass);
+            break;
+        }
+        case RenderCommandKind::BeginMask:
+            new (appendStreamRecord(ctx.stream, kind, sizeof(NjgBeginMaskPayload))) NjgBeginMaskPayload{qc.usesStencil ? 1u : 0u};
             break;
-        case nicxlive::core::RenderBackend::MaskDrawableKind::Drawable:
         default:
-            out.maskApplyPacket.kind = ::MaskDrawableKind::Part;
+            appendStreamRecord(ctx.stream, kind, 0);
             break;
         }
-        out.maskApplyPacket.isDodge = qc.maskApplyPacket.isDodge;
-        // D parity: ApplyMask serializes its own part packet, not the current DrawPart packet.
-        const auto& applyPart = qc.maskApplyPacket.partPacket;
-        auto& maskPart = out.maskApplyPacket.partPacket;
-        packPartPacket(ctx, applyPart, maskPart, 3);
-        // mask packet from qc.maskApplyPacket.maskPacket
-        const auto& mp = qc.maskApplyPacket.maskPacket;
-        out.maskApplyPacket.maskPacket.modelMatrix = mp.modelMatrix;
-        out.maskApplyPacket.maskPacket.mvp = mp.mvp;
-        out.maskApplyPacket.maskPacket.origin = mp.origin;
-        out.maskApplyPacket.maskPacket.vertexOffset = mp.vertexOffset;
-        out.maskApplyPacket.maskPacket.vertexAtlasStride = mp.vertexAtlasStride;
-        out.maskApplyPacket.maskPacket.deformOffset = mp.deformOffset;
-        out.maskApplyPacket.maskPacket.deformAtlasStride = mp.deformAtlasStride;
-        out.maskApplyPacket.maskPacket.indexHandle = mp.indexBuffer;
-        auto midx = ctx.backend->getDrawableIndices(mp.indexBuffer);
-        if (midx && !midx->empty()) {
-            out.maskApplyPacket.maskPacket.indexCount = std::min<std::size_t>(mp.indexCount, midx->size());
-            out.maskApplyPacket.maskPacket.indices = midx->data();
-            out.maskApplyPacket.maskPacket.vertexCount = mp.vertexCount;
+        ++ctx.streamCount;
+    }
+}
+
+template <typename T>
+static bool sameBytes(const T& a, const T& b) {
+    static_assert(std::is_trivially_copyable_v<T>, "byte-compared fields must be trivially copyable");
+    return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+// Everything a part patch cannot carry; packets that differ here are re-sent whole.
+static bool samePartIdentity(const NjgPartDrawPacket& a, const NjgPartDrawPacket& b) {
+    if (a.isMask != b.isMask || a.renderable != b.renderable || a.maskThreshold != b.maskThreshold ||
+        a.blendingMode != b.blendingMode || a.useMultistageBlend != b.useMultistageBlend ||
+        a.hasEmissionOrBumpmap != b.hasEmissionOrBumpmap || a.textureCount != b.textureCount ||
+        !sameBytes(a.origin, b.origin) || a.indexHandle != b.indexHandle || a.indices != b.indices ||
+        a.indexCount != b.indexCount || a.vertexCount != b.vertexCount) {
+        return false;
+    }
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (a.textureHandles[i] != b.textureHandles[i]) return false;
+    }
+    return true;
+}
+
+static bool sameMaskPacket(const NjgMaskDrawPacket& a, const NjgMaskDrawPacket& b) {
+    return sameBytes(a.modelMatrix, b.modelMatrix) && sameBytes(a.mvp, b.mvp) && sameBytes(a.origin, b.origin) &&
+           a.vertexOffset == b.vertexOffset && a.vertexAtlasStride == b.vertexAtlasStride &&
+           a.deformOffset == b.deformOffset && a.deformAtlasStride == b.deformAtlasStride &&
+           a.indexHandle == b.indexHandle && a.indices == b.indices && a.indexCount == b.indexCount &&
+           a.vertexCount == b.vertexCount;
+}
+
+static bool sameDynamicPass(const NjgDynamicCompositePass& a, const NjgDynamicCompositePass& b) {
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (a.textures[i] != b.textures[i]) return false;
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        if (a.origViewport[i] != b.origViewport[i]) return false;
+    }
+    return a.textureCount == b.textureCount && a.stencil == b.stencil && sameBytes(a.scale, b.scale) &&
+           a.rotationZ == b.rotationZ && a.autoScaled == b.autoScaled && a.origBuffer == b.origBuffer &&
+           a.drawBufferCount == b.drawBufferCount && a.hasStencil == b.hasStencil;
+}
+
+// Field groups of a DrawPart packet that changed; 0 means identical.
+static uint32_t partPatchFields(const NjgPartDrawPacket& a, const NjgPartDrawPacket& b) {
+    uint32_t fields = 0;
+    if (!sameBytes(a.modelMatrix, b.modelMatrix)) fields |= NjgPartPatchModelMatrix;
+    if (!sameBytes(a.renderMatrix, b.renderMatrix) || a.renderRotation != b.renderRotation) fields |= NjgPartPatchRender;
+    if (a.opacity != b.opacity) fields |= NjgPartPatchOpacity;
+    if (!sameBytes(a.clampedTint, b.clampedTint) || !sameBytes(a.clampedScreen, b.clampedScreen) ||
+        a.emissionStrength != b.emissionStrength) {
+        fields |= NjgPartPatchTint;
+    }
+    if (a.vertexOffset != b.vertexOffset || a.vertexAtlasStride != b.vertexAtlasStride || a.uvOffset != b.uvOffset ||
+        a.uvAtlasStride != b.uvAtlasStride || a.deformOffset != b.deformOffset || a.deformAtlasStride != b.deformAtlasStride) {
+        fields |= NjgPartPatchOffsets;
+    }
+    return fields;
+}
+
+// Matching key: the drawable a command draws (index buffers are per drawable), plus its kind.
+static std::pair<NjgRenderCommandKind, std::size_t> deltaKey(const NjgQueuedCommand& cmd) {
+    switch (cmd.kind) {
+    case NjgRenderCommandKind::DrawPart:
+        return {cmd.kind, cmd.partPacket.indexHandle};
+    case NjgRenderCommandKind::ApplyMask:
+        return {cmd.kind, cmd.maskApplyPacket.kind == ::MaskDrawableKind::Mask ? cmd.maskApplyPacket.maskPacket.indexHandle
+                                                                              : cmd.maskApplyPacket.partPacket.indexHandle};
+    default:
+        return {cmd.kind, 0};
+    }
+}
+
+static bool sameCommand(const NjgQueuedCommand& a, const NjgQueuedCommand& b) {
+    if (a.kind != b.kind) return false;
+    switch (a.kind) {
+    case NjgRenderCommandKind::DrawPart:
+        return samePartIdentity(a.partPacket, b.partPacket) && partPatchFields(a.partPacket, b.partPacket) == 0;
+    case NjgRenderCommandKind::ApplyMask:
+        if (a.maskApplyPacket.kind != b.maskApplyPacket.kind || a.maskApplyPacket.isDodge != b.maskApplyPacket.isDodge) return false;
+        if (a.maskApplyPacket.kind == ::MaskDrawableKind::Mask) return sameMaskPacket(a.maskApplyPacket.maskPacket, b.maskApplyPacket.maskPacket);
+        return samePartIdentity(a.maskApplyPacket.partPacket, b.maskApplyPacket.partPacket) &&
+               partPatchFields(a.maskApplyPacket.partPacket, b.maskApplyPacket.partPacket) == 0;
+    case NjgRenderCommandKind::BeginDynamicComposite:
+    case NjgRenderCommandKind::EndDynamicComposite:
+        return sameDynamicPass(a.dynamicPass, b.dynamicPass);
+    case NjgRenderCommandKind::BeginMask:
+        return a.usesStencil == b.usesStencil;
+    default:
+        return true;
+    }
+}
+
+static uint8_t* appendDeltaOp(RendererCtx& ctx, NjgDeltaOp op, std::size_t payloadBytes) {
+    const std::size_t size = (sizeof(NjgDeltaOpHeader) + payloadBytes + kNjgCommandAlign - 1) & ~(kNjgCommandAlign - 1);
+    const std::size_t at = ctx.delta.size();
+    ctx.delta.resize(at + size);
+    auto* header = reinterpret_cast<NjgDeltaOpHeader*>(ctx.delta.data() + at);
+    header->op = op;
+    header->size = static_cast<uint32_t>(size);
+    ++ctx.deltaOps;
+    return ctx.delta.data() + at + sizeof(NjgDeltaOpHeader);
+}
+
+static constexpr std::size_t alignedCommandSize(std::size_t bytes) {
+    return (bytes + kNjgCommandAlign - 1) & ~(kNjgCommandAlign - 1);
+}
+
+static_assert(sizeof(NjgDeltaOpHeader) % kNjgCommandAlign == 0 && sizeof(NjgPartPatchHeader) % kNjgCommandAlign == 0,
+              "delta payloads start aligned");
+
+// Appends a run op, extending the previous op if it is a run of the same kind.
+static void appendDeltaRun(RendererCtx& ctx, NjgDeltaOp op, std::size_t& lastRunAt, std::size_t count) {
+    if (lastRunAt != SIZE_MAX) {
+        auto* header = reinterpret_cast<NjgDeltaOpHeader*>(ctx.delta.data() + lastRunAt);
+        if (header->op == op) {
+            reinterpret_cast<NjgDeltaRun*>(header + 1)->count += static_cast<uint32_t>(count);
+            return;
+        }
+    }
+    lastRunAt = ctx.delta.size();
+    new (appendDeltaOp(ctx, op, sizeof(NjgDeltaRun))) NjgDeltaRun{static_cast<uint32_t>(count), 0};
+}
+
+// Inserts carry the same record as the compact command stream, built from the packed command.
+static void appendDeltaInsert(RendererCtx& ctx, const NjgQueuedCommand& cmd) {
+    std::size_t payload = 0;
+    switch (cmd.kind) {
+    case NjgRenderCommandKind::DrawPart: payload = sizeof(NjgPartDrawPacket); break;
+    case NjgRenderCommandKind::ApplyMask:
+        payload = sizeof(NjgMaskApplyHeader) + (cmd.maskApplyPacket.kind == ::MaskDrawableKind::Mask ? sizeof(NjgMaskDrawPacket) : sizeof(NjgPartDrawPacket));
+        break;
+    case NjgRenderCommandKind::BeginDynamicComposite:
+    case NjgRenderCommandKind::EndDynamicComposite: payload = sizeof(NjgDynamicCompositePass); break;
+    case NjgRenderCommandKind::BeginMask: payload = sizeof(NjgBeginMaskPayload); break;
+    default: break;
+    }
+    uint8_t* out = appendDeltaOp(ctx, NjgDeltaOp::Insert, sizeof(NjgCommandHeader) + payload);
+    auto* header = new (out) NjgCommandHeader{cmd.kind, static_cast<uint32_t>(alignedCommandSize(sizeof(NjgCommandHeader) + payload))};
+    uint8_t* body = out + sizeof(*header);
+    switch (cmd.kind) {
+    case NjgRenderCommandKind::DrawPart: new (body) NjgPartDrawPacket(cmd.partPacket); break;
+    case NjgRenderCommandKind::ApplyMask: {
+        auto* apply = new (body) NjgMaskApplyHeader{cmd.maskApplyPacket.kind, cmd.maskApplyPacket.isDodge ? 1u : 0u};
+        if (apply->kind == ::MaskDrawableKind::Mask) {
+            new (body + sizeof(*apply)) NjgMaskDrawPacket(cmd.maskApplyPacket.maskPacket);
         } else {
-            out.maskApplyPacket.maskPacket.indexCount = 0;
-            out.maskApplyPacket.maskPacket.vertexCount = 0;
-            out.maskApplyPacket.maskPacket.indices = nullptr;
+            new (body + sizeof(*apply)) NjgPartDrawPacket(cmd.maskApplyPacket.partPacket);
         }
+        break;
+    }
+    case NjgRenderCommandKind::BeginDynamicComposite:
+    case NjgRenderCommandKind::EndDynamicComposite: new (body) NjgDynamicCompositePass(cmd.dynamicPass); break;
+    case NjgRenderCommandKind::BeginMask: new (body) NjgBeginMaskPayload{cmd.usesStencil ? 1u : 0u}; break;
+    default: break;
+    }
+}
+
+static void appendDeltaPatch(RendererCtx& ctx, const NjgPartDrawPacket& packet, uint32_t fields) {
+    std::size_t payload = sizeof(NjgPartPatchHeader);
+    if (fields & NjgPartPatchModelMatrix) payload += alignedCommandSize(sizeof(packet.modelMatrix));
+    if (fields & NjgPartPatchRender) payload += alignedCommandSize(sizeof(NjgPartRenderPatch));
+    if (fields & NjgPartPatchOpacity) payload += alignedCommandSize(sizeof(float));
+    if (fields & NjgPartPatchTint) payload += alignedCommandSize(sizeof(NjgPartTintPatch));
+    if (fields & NjgPartPatchOffsets) payload += alignedCommandSize(sizeof(NjgPartOffsetsPatch));
+    uint8_t* out = appendDeltaOp(ctx, NjgDeltaOp::Patch, payload);
+    new (out) NjgPartPatchHeader{fields, 0};
+    out += sizeof(NjgPartPatchHeader);
+    if (fields & NjgPartPatchModelMatrix) {
+        new (out) nicxlive::core::nodes::Mat4(packet.modelMatrix);
+        out += alignedCommandSize(sizeof(packet.modelMatrix));
+    }
+    if (fields & NjgPartPatchRender) {
+        new (out) NjgPartRenderPatch{packet.renderMatrix, packet.renderRotation};
+        out += alignedCommandSize(sizeof(NjgPartRenderPatch));
+    }
+    if (fields & NjgPartPatchOpacity) {
+        new (out) float(packet.opacity);
+        out += alignedCommandSize(sizeof(float));
+    }
+    if (fields & NjgPartPatchTint) {
+        new (out) NjgPartTintPatch{packet.clampedTint, packet.clampedScreen, packet.emissionStrength};
+        out += alignedCommandSize(sizeof(NjgPartTintPatch));
+    }
+    if (fields & NjgPartPatchOffsets) {
+        new (out) NjgPartOffsetsPatch{packet.vertexOffset, packet.vertexAtlasStride, packet.uvOffset,
+                                      packet.uvAtlasStride, packet.deformOffset, packet.deformAtlasStride};
+    }
+}
 
-        // Dynamic pass (D parity)
-        size_t dynTexCount = qc.dynamicPass.surface
-            ? qc.dynamicPass.surface->textureCount
-            : qc.dynamicPass.textures.size();
-        if (dynTexCount > 3) dynTexCount = 3;
-        out.dynamicPass.textureCount = dynTexCount;
-        for (size_t i = 0; i < dynTexCount; ++i) {
-            std::shared_ptr<Texture> tex{};
-            if (qc.dynamicPass.surface) {
-                tex = qc.dynamicPass.surface->textures[i];
-            } else if (i < qc.dynamicPass.textures.size()) {
-                tex = qc.dynamicPass.textures[i];
+// Diffs ctx.queued against ctx.deltaBase into ctx.delta, then makes ctx.queued the new base.
+// Greedy alignment on deltaKey(): a current command matches the next base command with the same
+// key, dropping the base commands skipped on the way; no match means an insert.
+static void packCommandDelta(RendererCtx& ctx) {
+    auto profile = render::profileScope("Unity.packCommandDelta");
+    ctx.delta.clear();
+    ctx.deltaOps = 0;
+    ctx.deltaBaseCount = ctx.deltaBase.size();
+    const auto& base = ctx.deltaBase;
+    const auto& current = ctx.queued;
+    std::map<std::pair<NjgRenderCommandKind, std::size_t>, std::vector<std::size_t>> positions;
+    for (std::size_t i = base.size(); i-- > 0;) positions[deltaKey(base[i])].push_back(i); // ascending via back()
+    std::size_t cursor = 0;
+    std::size_t lastRunAt = SIZE_MAX;
+    for (const auto& cmd : current) {
+        std::size_t match = SIZE_MAX;
+        auto pit = positions.find(deltaKey(cmd));
+        if (pit != positions.end()) {
+            auto& candidates = pit->second;
+            while (!candidates.empty() && candidates.back() < cursor) candidates.pop_back();
+            if (!candidates.empty()) {
+                match = candidates.back();
+                candidates.pop_back();
             }
-            out.dynamicPass.textures[i] = ensureDynamicTextureHandle(ctx, tex, /*renderTarget*/ true, /*stencil*/ false);
         }
-        for (size_t i = dynTexCount; i < 3; ++i) {
-            out.dynamicPass.textures[i] = 0;
+        if (match == SIZE_MAX) {
+            appendDeltaInsert(ctx, cmd);
+            lastRunAt = SIZE_MAX;
+            continue;
         }
-        auto stencilTex = qc.dynamicPass.stencil;
-        if (!stencilTex && qc.dynamicPass.surface) {
-            stencilTex = qc.dynamicPass.surface->stencil;
+        if (match > cursor) appendDeltaRun(ctx, NjgDeltaOp::Remove, lastRunAt, match - cursor);
+        cursor = match + 1;
+        const auto& prev = base[match];
+        if (sameCommand(prev, cmd)) {
+            appendDeltaRun(ctx, NjgDeltaOp::Keep, lastRunAt, 1);
+        } else if (cmd.kind == NjgRenderCommandKind::DrawPart && samePartIdentity(prev.partPacket, cmd.partPacket)) {
+            appendDeltaPatch(ctx, cmd.partPacket, partPatchFields(prev.partPacket, cmd.partPacket));
+            lastRunAt = SIZE_MAX;
+        } else {
+            appendDeltaRun(ctx, NjgDeltaOp::Remove, lastRunAt, 1);
+            appendDeltaInsert(ctx, cmd);
+            lastRunAt = SIZE_MAX;
         }
-        out.dynamicPass.stencil = ensureDynamicTextureHandle(ctx, stencilTex, /*renderTarget*/ true, /*stencil*/ true);
-        out.dynamicPass.scale = qc.dynamicPass.scale;
-        out.dynamicPass.rotationZ = qc.dynamicPass.rotationZ;
-        out.dynamicPass.autoScaled = qc.dynamicPass.autoScaled;
-        out.dynamicPass.origBuffer = qc.dynamicPass.origBuffer;
-        for (int i = 0; i < 4; ++i) out.dynamicPass.origViewport[i] = qc.dynamicPass.origViewport[i];
-        if (out.dynamicPass.origViewport[2] == 0 || out.dynamicPass.origViewport[3] == 0) {
-            int vw = 0;
-            int vh = 0;
-            inGetViewport(vw, vh);
-            out.dynamicPass.origViewport[0] = 0;
-            out.dynamicPass.origViewport[1] = 0;
-            out.dynamicPass.origViewport[2] = vw;
-            out.dynamicPass.origViewport[3] = vh;
+    }
+    ctx.deltaBase = current;
+}
+
+// Draws every puppet of the renderer into its queue backend and applies deferred texture
+// commands; returns the texture command time. ctx.mutex must be held.
+static double drawRendererFrame(RendererCtx& ctx) {
+    ctx.backend->clear();
+    ScopedRenderBackend backendScope(ctx.backend);
+    // draw all puppets into queue
+    NJCX_DBG_LOG("[nicxlive] emit begin puppets=%zu\n", ctx.puppetHandles.size());
+    NJCX_DBG_CODE(unityLog(std::string("[nicxlive] emit begin: puppets=") + std::to_string(ctx.puppetHandles.size())););
+    for (auto h : ctx.puppetHandles) {
+        auto puppetCtx = gPuppets.find(h);
+        if (!puppetCtx) continue;
+        std::lock_guard<std::mutex> puppetLock(puppetCtx->mutex);
+        if (puppetCtx->puppet) {
+            // draw() consumes the render graph; a puppet whose tick was skipped as idle needs a
+            // fresh one (same inputs, so the output matches the last drawn frame).
+            if (!puppetCtx->graphPending) runPuppetUpdate(*puppetCtx);
+            puppetCtx->graphPending = false;
+            const auto queued = ctx.backend->queue.size();
+            puppetCtx->puppet->draw();
+            uploadReferencedTextures(ctx, queued);
+            NJCX_DBG_CODE(unityLog(std::string("[nicxlive] emit draw puppet: handle=") + std::to_string(reinterpret_cast<uintptr_t>(h)) + std::string(" queue=") + std::to_string(ctx.backend->queue.size()) + std::string(" graphEmpty=") + (puppetCtx->puppet->isRenderGraphEmpty() ? "true" : "false") + std::string(" rootParts=") + std::to_string(puppetCtx->puppet->rootPartCount())););
+            NJCX_DBG_LOG("[nicxlive] emit drew puppet queue=%zu\n", ctx.backend->queue.size());
+            NJCX_DBG_LOG("[nicxlive] emit puppet state graphEmpty=%d rootParts=%zu\n", puppetCtx->puppet->isRenderGraphEmpty() ? 1 : 0, puppetCtx->puppet->rootPartCount());
         }
-        out.dynamicPass.drawBufferCount = qc.dynamicPass.surface
-            ? static_cast<int>(std::max<std::size_t>(qc.dynamicPass.surface->textureCount, 1))
-            : 0;
-        out.dynamicPass.hasStencil = (qc.dynamicPass.surface && qc.dynamicPass.surface->stencil) || (out.dynamicPass.stencil != 0);
-        out.usesStencil = qc.usesStencil;
-        ctx.queued.push_back(out);
+    }
+    trimResidentTextures(ctx);
+    // Apply deferred texture create/update/dispose callbacks.
+    auto applyTextureProfile = render::profileScope("Unity.applyTextureCommands");
+    const auto textureStart = std::chrono::steady_clock::now();
+    applyTextureCommands(ctx);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - textureStart).count();
+}
+
+// What a packed command list depends on. ctx.mutex must be held.
+static std::vector<std::size_t> emitSignature(RendererCtx& ctx) {
+    std::vector<std::size_t> signature;
+    signature.reserve(ctx.puppetHandles.size() + 3);
+    int vw = 0;
+    int vh = 0;
+    {
+        std::lock_guard<std::mutex> stateLock(gRenderStateMutex);
+        inGetViewport(vw, vh);
+    }
+    signature.push_back(ctx.layoutSerial);
+    signature.push_back(static_cast<std::size_t>(vw));
+    signature.push_back(static_cast<std::size_t>(vh));
+    for (auto h : ctx.puppetHandles) {
+        auto puppetCtx = gPuppets.find(h);
+        if (!puppetCtx) continue;
+        std::lock_guard<std::mutex> puppetLock(puppetCtx->mutex);
+        signature.push_back(puppetCtx->changeSerial);
+    }
+    return signature;
+}
+
+// True if the cached output can be handed out again: nothing the list depends on moved and no
+// texture commands are waiting for the host. Drops the (empty) per-frame backend state either way.
+static bool reuseCachedEmit(RendererCtx& ctx, RendererCtx::EmitCache& cache, std::vector<std::size_t>& signature) {
+    signature = emitSignature(ctx);
+    const bool unchanged = cache.valid && cache.signature == signature && !ctx.backend->hasPendingResources();
+    ctx.lastEmitUnchanged = unchanged;
+    if (unchanged) {
+        ctx.backend->clear();
+    }
+    return unchanged;
+}
+
+static void storeEmitCache(RendererCtx& ctx, RendererCtx::EmitCache& cache, std::vector<std::size_t> signature) {
+    // The other format was not repacked from this draw; it must not be served as current.
+    ctx.queuedCache.valid = false;
+    ctx.streamCache.valid = false;
+    cache.signature = std::move(signature);
+    cache.valid = true;
+    ++ctx.emitSerial;
+}
+
+// Everything after parsing that does not touch the renderer.
+static void buildLoadedPuppet(Puppet& pup) {
+    if (auto root = pup.actualRoot()) {
+        std::function<void(const std::shared_ptr<nodes::Node>&)> markProjectablesIgnorePuppet;
+        markProjectablesIgnorePuppet = [&](const std::shared_ptr<nodes::Node>& n) {
+            if (!n) return;
+            if (auto proj = std::dynamic_pointer_cast<nodes::Projectable>(n)) {
+                proj->setIgnorePuppet(true);
+            }
+            for (const auto& child : n->childrenList()) {
+                markProjectablesIgnorePuppet(child);
+            }
+        };
+        markProjectablesIgnorePuppet(root);
+        pup.rescanNodes();
+        root->build(true);
+    }
+}
+
+// Registers a built puppet with its renderer (backend, textures) and publishes its handle.
+static void* attachLoadedPuppet(const std::shared_ptr<RendererCtx>& rendererCtx, const std::shared_ptr<Puppet>& pup) {
+    auto ctx = std::make_shared<PuppetCtx>();
+    ctx->puppet = pup;
+    void* handle = ctx.get();
+    if (rendererCtx) {
+        std::lock_guard<std::mutex> rendererLock(rendererCtx->mutex);
+        if (auto staging = pup->sharedBuffers(); staging && staging != rendererCtx->sharedBuffers) {
+            // Only the loader's private set gets here and it is dropped right after; compacting it
+            // after every moved drawable is quadratic and would free its storage on this thread.
+            staging->deform.holdCompaction();
+            staging->vertex.holdCompaction();
+            staging->uv.holdCompaction();
+        }
+        pup->adoptSharedBuffers(rendererCtx->sharedBuffers);
+        pup->setRenderBackend(rendererCtx->backend);
+        rendererCtx->puppetHandles.push_back(handle);
+        ++rendererCtx->layoutSerial;
+        ensurePuppetTextures(*rendererCtx, pup);
+    }
+    gPuppets.insert(handle, std::move(ctx));
+    return handle;
+}
+
+static void addTextureResidency(const Puppet& puppet, NjgTextureResidency& out) {
+    for (const auto& tex : puppet.textureSlots) {
+        if (!tex) continue;
+        if (tex->pixelsResident()) {
+            out.residentBytes += tex->data().size();
+            out.residentCount++;
+        } else if (tex->hasEncodedSource()) {
+            out.deferredCount++;
+        }
+    }
+}
+
+static fmt::PuppetLoadOptions rendererLoadOptions(RendererCtx& ctx) {
+    std::lock_guard<std::mutex> lock(ctx.mutex);
+    fmt::PuppetLoadOptions options;
+    options.deferTextureDecode = ctx.texturePolicy.deferDecode != 0;
+    return options;
+}
+
+// Parses with `parse` (given the renderer's load options) while the renderer's atlas set and backend
+// are bound (drawables register into the set that is current while they are constructed, textures
+// into the backend), then builds and attaches the puppet on this thread.
+template <typename Parse>
+static NjgResult loadPuppetSync(void* renderer, const char* entryPoint, void** outPuppet, Parse&& parse) {
+    try {
+        auto rendererForLoad = gRenderers.find(renderer);
+        ScopedSharedBufferSet sharedBufferScope(rendererForLoad ? rendererForLoad->sharedBuffers
+                                                                : std::make_shared<SharedBufferSet>());
+        std::optional<ScopedRenderBackend> backendScope;
+        if (rendererForLoad) backendScope.emplace(rendererForLoad->backend);
+        auto pup = parse(rendererForLoad ? rendererLoadOptions(*rendererForLoad) : fmt::PuppetLoadOptions{});
+        buildLoadedPuppet(*pup);
+        *outPuppet = attachLoadedPuppet(rendererForLoad, pup);
+        return NjgResult::Ok;
+    } catch (const std::exception& ex) {
+        unityLog(std::string("[nicxlive] ") + entryPoint + " exception: " + ex.what());
+        return NjgResult::Failure;
+    } catch (...) {
+        unityLog(std::string("[nicxlive] ") + entryPoint + " exception: unknown");
+        return NjgResult::Failure;
+    }
+}
+
+static float loadStageFraction(NjgLoadStage stage) {
+    switch (stage) {
+    case NjgLoadStage::Queued: return 0.0f;
+    case NjgLoadStage::Reading: return 0.05f;
+    case NjgLoadStage::Parsing: return 0.15f;
+    case NjgLoadStage::Building: return 0.8f;
+    case NjgLoadStage::Ready: return 0.95f;
+    default: return 1.0f;
     }
 }
 
+static void handOffLoadJob(LoadJob& job) {
+    {
+        std::lock_guard<std::mutex> lock(job.handOffMutex);
+        job.handedOff = true;
+    }
+    job.handOff.notify_all();
+}
+
+// Loader thread body. Drawables register into a private atlas set here; the renderer's set is
+// only touched by the finalize step on the polling thread. A threaded loader keeps the staging
+// set until the hand-off so its storage is freed here, off the polling thread (the allocator
+// makes freeing another thread's blocks expensive).
+static void runLoadJob(const std::shared_ptr<LoadJob>& job, bool holdStaging) {
+    auto staging = std::make_shared<SharedBufferSet>();
+    try {
+        ScopedSharedBufferSet sharedBufferScope(staging);
+        ScopedRenderBackend backendScope(job->backend);
+        job->stage.store(NjgLoadStage::Reading, std::memory_order_release);
+        auto bytes = fmt::inReadPuppetFile(job->path);
+        if (job->cancelled.load(std::memory_order_acquire)) return;
+        job->stage.store(NjgLoadStage::Parsing, std::memory_order_release);
+        auto pup = fmt::inLoadPuppetFromMemory<Puppet>(bytes.data(), bytes.size(), job->options);
+        if (job->cancelled.load(std::memory_order_acquire)) return;
+        job->stage.store(NjgLoadStage::Building, std::memory_order_release);
+        buildLoadedPuppet(*pup);
+        job->puppet = std::move(pup);
+        job->stage.store(NjgLoadStage::Ready, std::memory_order_release);
+    } catch (const std::exception& ex) {
+        job->error = ex.what();
+        job->stage.store(NjgLoadStage::Failed, std::memory_order_release);
+        return;
+    } catch (...) {
+        job->error = "unknown";
+        job->stage.store(NjgLoadStage::Failed, std::memory_order_release);
+        return;
+    }
+    if (!holdStaging) return;
+    std::unique_lock<std::mutex> lock(job->handOffMutex);
+    job->handOff.wait(lock, [&] { return job->handedOff; });
+}
+
+// Cancels outstanding async loads and waits for their threads (runtime teardown).
+static void drainLoadJobs() {
+    auto loads = gLoads.snapshot();
+    for (const auto& entry : *loads) {
+        entry.second->cancelled.store(true, std::memory_order_release);
+        handOffLoadJob(*entry.second);
+    }
+    gLoads.clear();
+    std::unique_lock<std::mutex> lock(gLoaderMutex);
+    gLoadersIdle.wait(lock, [] { return gActiveLoaders == 0; });
+}
+
 extern "C" {
 
 void njgRuntimeInit() {
-    std::lock_guard<std::mutex> lock(gMutex);
+    std::lock_guard<std::mutex> lock(gRuntimeMutex);
     if (gRuntimeInitialized) return;
-    gUnityTimeTicker = 0.0;
+    {
+        std::lock_guard<std::mutex> timeLock(gTimeMutex);
+        gUnityTimeTicker = 0.0;
+    }
     gRuntimeInitialized = true;
     inSetTimingFunc([]() {
         return gUnityTimeTicker;
@@ -555,7 +1468,9 @@ void njgRuntimeInit() {
 }
 
 void njgRuntimeTerm() {
-    std::lock_guard<std::mutex> lock(gMutex);
+    // Loader threads may log (gRuntimeMutex), so wait for them first.
+    drainLoadJobs();
+    std::lock_guard<std::mutex> lock(gRuntimeMutex);
     gRenderers.clear();
     gPuppets.clear();
     gRuntimeInitialized = false;
@@ -564,7 +1479,7 @@ void njgRuntimeTerm() {
 NjgResult njgCreateRenderer(const UnityRendererConfig* config, const UnityResourceCallbacks* callbacks, void** outRenderer) {
     if (!config || !outRenderer) return NjgResult::InvalidArgument;
     njgRuntimeInit();
-    auto ctx = std::make_unique<RendererCtx>();
+    auto ctx = std::make_shared<RendererCtx>();
     ctx->cfg = *config;
     if (callbacks) ctx->callbacks = *callbacks;
     ctx->graph = std::make_unique<RenderGraphBuilder>();
@@ -573,101 +1488,156 @@ NjgResult njgCreateRenderer(const UnityRendererConfig* config, const UnityResour
     ctx->ctx.renderGraph = ctx->graph.get();
     ctx->ctx.renderBackend = ctx->backend.get();
     ctx->ctx.gpuState = RenderGpuState::init();
-    setCurrentRenderBackend(ctx->backend);
-    initRendererCommon();
-    ctx->backend->initializeRenderer();
-    if (config->viewportWidth > 0 && config->viewportHeight > 0) {
-        inSetViewport(config->viewportWidth, config->viewportHeight);
-    }
-    void* handle = ctx.get();
     {
-        std::lock_guard<std::mutex> lock(gMutex);
-        gRenderers[handle] = std::move(ctx);
+        std::lock_guard<std::mutex> stateLock(gRenderStateMutex);
+        setCurrentRenderBackend(ctx->backend);
+        initRendererCommon();
+        ctx->backend->initializeRenderer();
+        if (config->viewportWidth > 0 && config->viewportHeight > 0) {
+            inSetViewport(config->viewportWidth, config->viewportHeight);
+        }
     }
+    void* handle = ctx.get();
+    gRenderers.insert(handle, std::move(ctx));
     *outRenderer = handle;
     return NjgResult::Ok;
 }
 
 void njgDestroyRenderer(void* renderer) {
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it != gRenderers.end()) {
-        // release RTs
-        releaseExternalTexture(*it->second, it->second->renderHandle);
-        releaseExternalTexture(*it->second, it->second->compositeHandle);
-        // release remaining external textures (dedup handles shared across maps)
-        std::unordered_set<size_t> released{};
-        for (const auto& kv : it->second->runtimeTextureHandles) {
-            if (kv.second != 0 && released.insert(kv.second).second) {
-                releaseExternalTexture(*it->second, kv.second);
-            }
+    auto ctxPtr = gRenderers.erase(renderer);
+    if (!ctxPtr) return;
+    auto& ctx = *ctxPtr;
+    std::lock_guard<std::mutex> lock(ctx.mutex);
+    // release RTs
+    releaseExternalTexture(ctx, ctx.renderHandle);
+    releaseExternalTexture(ctx, ctx.compositeHandle);
+    // release remaining external textures (dedup handles shared across maps)
+    std::unordered_set<size_t> released{};
+    for (const auto& kv : ctx.runtimeTextureHandles) {
+        if (kv.second != 0 && released.insert(kv.second).second) {
+            releaseExternalTexture(ctx, kv.second);
         }
-        for (const auto& kv : it->second->backendTextureHandles) {
-            if (kv.second != 0 && released.insert(kv.second).second) {
-                releaseExternalTexture(*it->second, kv.second);
-            }
+    }
+    for (const auto& kv : ctx.backendTextureHandles) {
+        if (kv.second != 0 && released.insert(kv.second).second) {
+            releaseExternalTexture(ctx, kv.second);
         }
-        it->second->runtimeTextureHandles.clear();
-        it->second->backendTextureHandles.clear();
-        it->second->animationStates.clear();
-        gRenderers.erase(it);
     }
+    releaseFreeTargets(ctx);
+    ctx.runtimeTextureHandles.clear();
+    ctx.backendTextureHandles.clear();
+    ctx.hostTargets.clear();
+    ctx.animationStates.clear();
 }
 
 NjgResult njgLoadPuppet(void* renderer, const char* pathUtf8, void** outPuppet) {
     if (!renderer || !pathUtf8 || !outPuppet) return NjgResult::InvalidArgument;
+    return loadPuppetSync(renderer, "njgLoadPuppet", outPuppet, [&](const fmt::PuppetLoadOptions& options) {
+        return fmt::inLoadPuppet<Puppet>(pathUtf8, options);
+    });
+}
+
+NjgResult njgLoadPuppetFromMemory(void* renderer, const uint8_t* data, size_t length, void** outPuppet) {
+    if (!renderer || !data || !length || !outPuppet) return NjgResult::InvalidArgument;
+    return loadPuppetSync(renderer, "njgLoadPuppetFromMemory", outPuppet,
+                          [&](const fmt::PuppetLoadOptions& options) {
+                              return fmt::inLoadPuppetFromMemory<Puppet>(data, length, options);
+                          });
+}
+
+NjgResult njgInstantiatePuppet(void* renderer, void* templatePuppet, void** outPuppet) {
+    if (!renderer || !templatePuppet || !outPuppet) return NjgResult::InvalidArgument;
+    auto templateCtx = gPuppets.find(templatePuppet);
+    if (!templateCtx || !templateCtx->puppet) return NjgResult::InvalidArgument;
+    return loadPuppetSync(renderer, "njgInstantiatePuppet", outPuppet, [&](const fmt::PuppetLoadOptions&) {
+        // The template's meshes may be replaced by its own updates; hold it still while they are shared.
+        std::lock_guard<std::mutex> lock(templateCtx->mutex);
+        return fmt::inInstantiatePuppet(*templateCtx->puppet);
+    });
+}
+
+NjgResult njgLoadPuppetAsync(void* renderer, const char* pathUtf8, void** outLoad) {
+    if (!renderer || !pathUtf8 || !outLoad) return NjgResult::InvalidArgument;
+    auto rendererCtx = gRenderers.find(renderer);
+    if (!rendererCtx) return NjgResult::InvalidArgument;
+    auto job = std::make_shared<LoadJob>();
+    job->renderer = renderer;
+    job->options = rendererLoadOptions(*rendererCtx);
+    job->backend = rendererCtx->backend;
+    job->path = pathUtf8;
+    void* handle = job.get();
+    gLoads.insert(handle, job);
+    {
+        std::lock_guard<std::mutex> lock(gLoaderMutex);
+        ++gActiveLoaders;
+    }
+    auto finish = []() {
+        std::lock_guard<std::mutex> lock(gLoaderMutex);
+        if (--gActiveLoaders == 0) gLoadersIdle.notify_all();
+    };
     try {
-        auto pup = fmt::inLoadPuppet<Puppet>(pathUtf8);
-        if (auto root = pup->actualRoot()) {
-            std::function<void(const std::shared_ptr<nodes::Node>&)> markProjectablesIgnorePuppet;
-            markProjectablesIgnorePuppet = [&](const std::shared_ptr<nodes::Node>& n) {
-                if (!n) return;
-                if (auto proj = std::dynamic_pointer_cast<nodes::Projectable>(n)) {
-                    proj->setIgnorePuppet(true);
-                }
-                for (const auto& child : n->childrenList()) {
-                    markProjectablesIgnorePuppet(child);
-                }
-            };
-            markProjectablesIgnorePuppet(root);
-            pup->rescanNodes();
-            root->build(true);
-        }
-        auto ctx = std::make_unique<PuppetCtx>();
-        ctx->puppet = pup;
-        void* handle = ctx.get();
-        {
-            std::lock_guard<std::mutex> lock(gMutex);
-            gPuppets[handle] = std::move(ctx);
-            auto rit = gRenderers.find(renderer);
-            if (rit != gRenderers.end()) {
-                pup->setRenderBackend(rit->second->backend);
-                rit->second->puppetHandles.push_back(handle);
-                ensurePuppetTextures(*rit->second, pup);
-            }
+        std::thread([job, finish]() {
+            runLoadJob(job, true);
+            finish();
+        }).detach();
+    } catch (const std::system_error&) {
+        // No threads (e.g. single-threaded WASM): load inline; polling still finalizes as usual.
+        runLoadJob(job, false);
+        finish();
+    }
+    *outLoad = handle;
+    return NjgResult::Ok;
+}
+
+NjgResult njgPollLoad(void* load, NjgLoadProgress* outProgress, void** outPuppet) {
+    if (!outProgress || !outPuppet) return NjgResult::InvalidArgument;
+    *outPuppet = nullptr;
+    auto job = gLoads.find(load);
+    if (!job) return NjgResult::InvalidArgument;
+    auto stage = job->stage.load(std::memory_order_acquire);
+    if (stage == NjgLoadStage::Ready) {
+        if (!gLoads.erase(load)) return NjgResult::InvalidArgument; // finalized by a concurrent poll
+        try {
+            auto rendererCtx = gRenderers.find(job->renderer);
+            if (!rendererCtx) throw std::runtime_error("renderer was destroyed");
+            *outPuppet = attachLoadedPuppet(rendererCtx, job->puppet);
+            stage = NjgLoadStage::Done;
+        } catch (const std::exception& ex) {
+            job->error = ex.what();
+            stage = NjgLoadStage::Failed;
         }
-        *outPuppet = handle;
-        return NjgResult::Ok;
-    } catch (const std::exception& ex) {
-        unityLog(std::string("[nicxlive] njgLoadPuppet exception: ") + ex.what());
-        return NjgResult::Failure;
-    } catch (...) {
-        unityLog("[nicxlive] njgLoadPuppet exception: unknown");
+        handOffLoadJob(*job);
+    } else if (stage == NjgLoadStage::Failed) {
+        gLoads.erase(load);
+    }
+    outProgress->stage = stage;
+    outProgress->fraction = loadStageFraction(stage);
+    if (stage == NjgLoadStage::Failed) {
+        unityLog(std::string("[nicxlive] njgLoadPuppetAsync exception: ") + job->error);
         return NjgResult::Failure;
     }
+    return NjgResult::Ok;
+}
+
+NjgResult njgCancelLoad(void* load) {
+    auto job = gLoads.erase(load);
+    if (!job) return NjgResult::InvalidArgument;
+    job->cancelled.store(true, std::memory_order_release);
+    handOffLoadJob(*job);
+    return NjgResult::Ok;
+}
+
+void njgSetTextureDecodeThreadCount(size_t threadCount) {
+    inSetTextureDecodeThreadCount(threadCount);
 }
 
 NjgResult njgGetParameters(void* puppetHandle, NjgParameterInfo* buffer, size_t bufferLength, size_t* outCount) {
     if (!outCount) return NjgResult::InvalidArgument;
     *outCount = 0;
-    std::shared_ptr<Puppet> pup;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
-    const auto& params = pup->parameters;
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    const auto& params = ctx->puppet->parameters;
     *outCount = params.size();
     if (!buffer) return NjgResult::Ok;
     if (bufferLength < params.size()) return NjgResult::InvalidArgument;
@@ -693,19 +1663,19 @@ NjgResult njgGetParameters(void* puppetHandle, NjgParameterInfo* buffer, size_t
 NjgResult njgUpdateParameters(void* puppetHandle, const PuppetParameterUpdate* updates, size_t updateCount) {
     if (!puppetHandle) return NjgResult::InvalidArgument;
     if (!updates || updateCount == 0) return NjgResult::Ok;
-    std::shared_ptr<Puppet> pup;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    auto& pup = ctx->puppet;
     for (std::size_t i = 0; i < updateCount; ++i) {
         const auto& upd = updates[i];
         if (auto param = pup->findParameter(upd.parameterUuid)) {
+            // Hosts often push every parameter every frame; only real changes wake the puppet.
             if (param->isVec2) {
+                if (param->value.x != upd.value.x || param->value.y != upd.value.y) markPuppetInputs(*ctx);
                 param->value = upd.value;
             } else {
+                if (param->value.x != upd.value.x) markPuppetInputs(*ctx);
                 param->value.x = upd.value.x;
             }
         }
@@ -718,13 +1688,10 @@ NjgResult njgGetPuppetExtData(void* puppetHandle, const char* key, const uint8_t
     *outData = nullptr;
     *outLength = 0;
 
-    std::shared_ptr<Puppet> pup;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    auto& pup = ctx->puppet;
 
     auto found = pup->extData.find(key);
     if (found == pup->extData.end() || found->second.empty()) return NjgResult::Failure;
@@ -737,21 +1704,15 @@ NjgResult njgGetPuppetExtData(void* puppetHandle, const char* key, const uint8_t
 
 NjgResult njgPlayAnimation(void* renderer, void* puppetHandle, const char* name, bool loop, bool playLeadOut) {
     if (!renderer || !puppetHandle || !name) return NjgResult::InvalidArgument;
-    std::shared_ptr<Puppet> pup;
-    RendererCtx* rendererCtx = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto rit = gRenderers.find(renderer);
-        if (rit == gRenderers.end()) return NjgResult::InvalidArgument;
-        rendererCtx = rit->second.get();
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
-    if (pup->animations.find(name) == pup->animations.end()) {
+    auto rendererCtx = gRenderers.find(renderer);
+    if (!rendererCtx) return NjgResult::InvalidArgument;
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    if (ctx->puppet->animations.find(name) == ctx->puppet->animations.end()) {
         unityLog(std::string("[nicxlive] njgPlayAnimation failed: animation not found name=") + name);
         return NjgResult::InvalidArgument;
     }
+    std::lock_guard<std::mutex> lock(rendererCtx->mutex);
     auto* state = ensureAnimationState(*rendererCtx, puppetHandle, name);
     if (state->paused) {
         state->paused = false;
@@ -769,21 +1730,15 @@ NjgResult njgPlayAnimation(void* renderer, void* puppetHandle, const char* name,
 
 NjgResult njgPauseAnimation(void* renderer, void* puppetHandle, const char* name) {
     if (!renderer || !puppetHandle || !name) return NjgResult::InvalidArgument;
-    std::shared_ptr<Puppet> pup;
-    RendererCtx* rendererCtx = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto rit = gRenderers.find(renderer);
-        if (rit == gRenderers.end()) return NjgResult::InvalidArgument;
-        rendererCtx = rit->second.get();
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
-    if (pup->animations.find(name) == pup->animations.end()) {
+    auto rendererCtx = gRenderers.find(renderer);
+    if (!rendererCtx) return NjgResult::InvalidArgument;
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    if (ctx->puppet->animations.find(name) == ctx->puppet->animations.end()) {
         unityLog(std::string("[nicxlive] njgPauseAnimation failed: animation not found name=") + name);
         return NjgResult::InvalidArgument;
     }
+    std::lock_guard<std::mutex> lock(rendererCtx->mutex);
     auto* state = ensureAnimationState(*rendererCtx, puppetHandle, name);
     state->paused = true;
     return NjgResult::Ok;
@@ -791,21 +1746,15 @@ NjgResult njgPauseAnimation(void* renderer, void* puppetHandle, const char* name
 
 NjgResult njgStopAnimation(void* renderer, void* puppetHandle, const char* name, bool immediate) {
     if (!renderer || !puppetHandle || !name) return NjgResult::InvalidArgument;
-    std::shared_ptr<Puppet> pup;
-    RendererCtx* rendererCtx = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto rit = gRenderers.find(renderer);
-        if (rit == gRenderers.end()) return NjgResult::InvalidArgument;
-        rendererCtx = rit->second.get();
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
-    if (pup->animations.find(name) == pup->animations.end()) {
+    auto rendererCtx = gRenderers.find(renderer);
+    if (!rendererCtx) return NjgResult::InvalidArgument;
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    if (ctx->puppet->animations.find(name) == ctx->puppet->animations.end()) {
         unityLog(std::string("[nicxlive] njgStopAnimation failed: animation not found name=") + name);
         return NjgResult::InvalidArgument;
     }
+    std::lock_guard<std::mutex> lock(rendererCtx->mutex);
     auto* state = ensureAnimationState(*rendererCtx, puppetHandle, name);
     if (state->stopping) return NjgResult::Ok;
     const bool shouldStopImmediate = immediate || state->frame == 0 || state->paused || !state->playLeadOut;
@@ -823,21 +1772,15 @@ NjgResult njgStopAnimation(void* renderer, void* puppetHandle, const char* name,
 
 NjgResult njgSeekAnimation(void* renderer, void* puppetHandle, const char* name, int frame) {
     if (!renderer || !puppetHandle || !name) return NjgResult::InvalidArgument;
-    std::shared_ptr<Puppet> pup;
-    RendererCtx* rendererCtx = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto rit = gRenderers.find(renderer);
-        if (rit == gRenderers.end()) return NjgResult::InvalidArgument;
-        rendererCtx = rit->second.get();
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
-    if (pup->animations.find(name) == pup->animations.end()) {
+    auto rendererCtx = gRenderers.find(renderer);
+    if (!rendererCtx) return NjgResult::InvalidArgument;
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    if (ctx->puppet->animations.find(name) == ctx->puppet->animations.end()) {
         unityLog(std::string("[nicxlive] njgSeekAnimation failed: animation not found name=") + name);
         return NjgResult::InvalidArgument;
     }
+    std::lock_guard<std::mutex> lock(rendererCtx->mutex);
     auto* state = ensureAnimationState(*rendererCtx, puppetHandle, name);
     state->frame = (std::max)(0, frame);
     state->looped = 0;
@@ -846,15 +1789,13 @@ NjgResult njgSeekAnimation(void* renderer, void* puppetHandle, const char* name,
 
 NjgResult njgSetPuppetScale(void* puppetHandle, float sx, float sy) {
     if (!puppetHandle) return NjgResult::InvalidArgument;
-    std::shared_ptr<Puppet> pup;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    auto& pup = ctx->puppet;
     pup->transform.scale = nodes::Vec2{sx, sy};
     pup->transform.update();
+    markPuppetInputs(*ctx);
     if (auto root = pup->actualRoot()) {
         root->transformChanged();
     }
@@ -863,16 +1804,14 @@ NjgResult njgSetPuppetScale(void* puppetHandle, float sx, float sy) {
 
 NjgResult njgSetPuppetTranslation(void* puppetHandle, float tx, float ty) {
     if (!puppetHandle) return NjgResult::InvalidArgument;
-    std::shared_ptr<Puppet> pup;
-    {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto it = gPuppets.find(puppetHandle);
-        if (it == gPuppets.end() || !it->second || !it->second->puppet) return NjgResult::InvalidArgument;
-        pup = it->second->puppet;
-    }
+    auto ctx = gPuppets.find(puppetHandle);
+    if (!ctx || !ctx->puppet) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    auto& pup = ctx->puppet;
     pup->transform.translation.x = tx;
     pup->transform.translation.y = ty;
     pup->transform.update();
+    markPuppetInputs(*ctx);
     if (auto root = pup->actualRoot()) {
         root->transformChanged();
     }
@@ -880,128 +1819,127 @@ NjgResult njgSetPuppetTranslation(void* puppetHandle, float tx, float ty) {
 }
 
 NjgResult njgUnloadPuppet(void* renderer, void* puppet) {
-    if (renderer) {
-        std::lock_guard<std::mutex> lock(gMutex);
-        auto rit = gRenderers.find(renderer);
-        if (rit != gRenderers.end()) {
-            auto& v = rit->second->puppetHandles;
-            v.erase(std::remove(v.begin(), v.end(), puppet), v.end());
-            auto pit = gPuppets.find(puppet);
-            if (pit != gPuppets.end() && pit->second && pit->second->puppet) {
-                releasePuppetTextures(*rit->second, pit->second->puppet);
-            }
-            rit->second->animationStates.erase(puppet);
+    if (auto rendererCtx = gRenderers.find(renderer)) {
+        std::lock_guard<std::mutex> rendererLock(rendererCtx->mutex);
+        auto& v = rendererCtx->puppetHandles;
+        v.erase(std::remove(v.begin(), v.end(), puppet), v.end());
+        ++rendererCtx->layoutSerial;
+        if (auto ctx = gPuppets.find(puppet); ctx && ctx->puppet) {
+            std::lock_guard<std::mutex> puppetLock(ctx->mutex);
+            releasePuppetTextures(*rendererCtx, ctx->puppet);
         }
+        rendererCtx->animationStates.erase(puppet);
     }
-    destroyHandle(gPuppets, puppet);
+    gPuppets.erase(puppet);
     return NjgResult::Ok;
 }
 
 NjgResult njgBeginFrame(void* renderer, const FrameConfig* cfg) {
     if (!renderer || !cfg) return NjgResult::InvalidArgument;
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it == gRenderers.end()) return NjgResult::InvalidArgument;
-    inSetViewport(cfg->viewportWidth, cfg->viewportHeight);
-    // Clear previous frame commands/resources
-    it->second->backend->clear();
-    it->second->queued.clear();
+    auto ctxPtr = gRenderers.find(renderer);
+    if (!ctxPtr) return NjgResult::InvalidArgument;
+    auto& ctx = *ctxPtr;
+    std::lock_guard<std::mutex> lock(ctx.mutex);
+    {
+        std::lock_guard<std::mutex> stateLock(gRenderStateMutex);
+        inSetViewport(cfg->viewportWidth, cfg->viewportHeight);
+    }
+    // Clear previous frame commands/resources. The packed output (ctx.queued / ctx.stream) is
+    // kept: njgEmitCommands may hand it out again if nothing changed.
+    ctx.backend->clear();
     // Ensure render/composite targets exist
-    if (it->second->callbacks.createTexture && cfg->viewportWidth > 0 && cfg->viewportHeight > 0) {
-        bool needRecreate = (it->second->lastViewportW != cfg->viewportWidth) || (it->second->lastViewportH != cfg->viewportHeight);
-        if (needRecreate && it->second->renderHandle != 0) {
-            releaseExternalTexture(*it->second, it->second->renderHandle);
-            it->second->renderHandle = 0;
+    ++ctx.frameIndex;
+    if (ctx.callbacks.createTexture && cfg->viewportWidth > 0 && cfg->viewportHeight > 0) {
+        bool needRecreate = (ctx.lastViewportW != cfg->viewportWidth) || (ctx.lastViewportH != cfg->viewportHeight);
+        if (needRecreate && ctx.renderHandle != 0) {
+            recycleHostTarget(ctx, ctx.renderHandle);
+            ctx.renderHandle = 0;
         }
-        if (needRecreate && it->second->compositeHandle != 0) {
-            releaseExternalTexture(*it->second, it->second->compositeHandle);
-            it->second->compositeHandle = 0;
+        if (needRecreate && ctx.compositeHandle != 0) {
+            recycleHostTarget(ctx, ctx.compositeHandle);
+            ctx.compositeHandle = 0;
         }
-        if (it->second->renderHandle == 0) {
-            it->second->renderHandle = it->second->callbacks.createTexture(cfg->viewportWidth, cfg->viewportHeight,
-                                                                           4, 1, 4, /*renderTarget*/ true, false,
-                                                                           it->second->callbacks.userData);
-            it->second->stats.created++;
-            it->second->stats.current++;
+        if (ctx.renderHandle == 0) {
+            ctx.renderHandle = acquireHostTarget(ctx, cfg->viewportWidth, cfg->viewportHeight, 4, false);
         }
-        if (it->second->compositeHandle == 0) {
-            it->second->compositeHandle = it->second->callbacks.createTexture(cfg->viewportWidth, cfg->viewportHeight,
-                                                                              4, 1, 4, /*renderTarget*/ true, false,
-                                                                              it->second->callbacks.userData);
-            it->second->stats.created++;
-            it->second->stats.current++;
+        if (ctx.compositeHandle == 0) {
+            ctx.compositeHandle = acquireHostTarget(ctx, cfg->viewportWidth, cfg->viewportHeight, 4, false);
         }
-        it->second->backend->setRenderTargets(it->second->renderHandle, it->second->compositeHandle);
-        it->second->lastViewportW = cfg->viewportWidth;
-        it->second->lastViewportH = cfg->viewportHeight;
+        ctx.backend->setRenderTargets(ctx.renderHandle, ctx.compositeHandle);
+        ctx.lastViewportW = cfg->viewportWidth;
+        ctx.lastViewportH = cfg->viewportHeight;
+    }
+    evictIdleTargets(ctx);
+    {
+        std::lock_guard<std::mutex> stateLock(gRenderStateMutex);
+        setCurrentRenderBackend(ctx.backend);
     }
-    setCurrentRenderBackend(it->second->backend);
     return NjgResult::Ok;
 }
 
 NjgResult njgTickPuppet(void* puppet, double deltaSeconds) {
     auto profile = render::profileScope("Unity.njgTickPuppet");
     const auto start = std::chrono::steady_clock::now();
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gPuppets.find(puppet);
-    if (it == gPuppets.end()) return NjgResult::InvalidArgument;
-    for (auto& rendererPair : gRenderers) {
-        auto* renderer = rendererPair.second.get();
-        auto pit = renderer->animationStates.find(puppet);
-        if (pit == renderer->animationStates.end()) continue;
-        for (auto& animPair : pit->second) {
-            auto& state = animPair.second;
-            if (!state.playing || state.paused) continue;
-            state.frame += (std::max)(1, static_cast<int>(deltaSeconds * 60.0));
-        }
+    auto ctx = gPuppets.find(puppet);
+    if (!ctx) return NjgResult::InvalidArgument;
+    const bool animating = advanceAnimationCursors(puppet, deltaSeconds);
+    if (ctx->puppet) {
+        advanceRuntimeClock(deltaSeconds);
+        updatePuppetCtx(*ctx, animating);
     }
-    if (it->second && it->second->puppet) {
-        if (std::isfinite(deltaSeconds) && deltaSeconds > 0.0) {
-            gUnityTimeTicker += deltaSeconds;
-        }
-        inUpdate();
-        NJCX_DBG_LOG("[nicxlive] tick update start\n");
-        it->second->puppet->update();
-        NJCX_DBG_LOG("[nicxlive] tick update end graphEmpty=%d rootParts=%zu\n", it->second->puppet->isRenderGraphEmpty() ? 1 : 0, it->second->puppet->rootPartCount());
+    unityPerfWindow().addTick(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    return NjgResult::Ok;
+}
+
+NjgResult njgTickPuppets(void* const* puppets, size_t count, double deltaSeconds) {
+    if (!puppets && count != 0) return NjgResult::InvalidArgument;
+    auto profile = render::profileScope("Unity.njgTickPuppets");
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<PuppetCtx>> ctxs;
+    ctxs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto ctx = gPuppets.find(puppets[i]);
+        if (!ctx) return NjgResult::InvalidArgument;
+        ctxs.push_back(std::move(ctx));
+    }
+    std::vector<char> animating(count, 0);
+    for (size_t i = 0; i < count; ++i) animating[i] = advanceAnimationCursors(puppets[i], deltaSeconds) ? 1 : 0;
+    // One clock advance for the whole batch so every puppet sees the same frame time.
+    advanceRuntimeClock(deltaSeconds);
+    try {
+        sharedWorkerPool().parallelFor(ctxs.size(), [&](std::size_t i) {
+            if (ctxs[i]->puppet) updatePuppetCtx(*ctxs[i], animating[i] != 0);
+        });
+    } catch (const std::exception& ex) {
+        unityLog(std::string("[nicxlive] njgTickPuppets failed: ") + ex.what());
+        return NjgResult::Failure;
     }
     unityPerfWindow().addTick(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
     return NjgResult::Ok;
 }
+
+void njgSetWorkerThreadCount(size_t threadCount) {
+    sharedWorkerPool().setThreadCount(threadCount);
+}
+
 NjgResult njgEmitCommands(void* renderer, CommandQueueView* outView) {
     if (!renderer || !outView) return NjgResult::InvalidArgument;
     auto profile = render::profileScope("Unity.njgEmitCommands");
     const auto start = std::chrono::steady_clock::now();
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it == gRenderers.end()) return NjgResult::InvalidArgument;
-    auto& ctx = *it->second;
-    ctx.backend->clear();
-    setCurrentRenderBackend(ctx.backend);
-    // draw all puppets into queue
-    NJCX_DBG_LOG("[nicxlive] emit begin puppets=%zu\n", ctx.puppetHandles.size());
-    NJCX_DBG_CODE(unityLog(std::string("[nicxlive] emit begin: puppets=") + std::to_string(ctx.puppetHandles.size())););
-    for (auto h : ctx.puppetHandles) {
-        auto pit = gPuppets.find(h);
-        if (pit == gPuppets.end()) continue;
-        if (pit->second && pit->second->puppet) {
-            pit->second->puppet->draw();
-            NJCX_DBG_CODE(unityLog(std::string("[nicxlive] emit draw puppet: handle=") + std::to_string(reinterpret_cast<uintptr_t>(h)) + std::string(" queue=") + std::to_string(ctx.backend->queue.size()) + std::string(" graphEmpty=") + (pit->second->puppet->isRenderGraphEmpty() ? "true" : "false") + std::string(" rootParts=") + std::to_string(pit->second->puppet->rootPartCount())););
-            NJCX_DBG_LOG("[nicxlive] emit drew puppet queue=%zu\n", ctx.backend->queue.size());
-        }
-            NJCX_DBG_LOG("[nicxlive] emit puppet state graphEmpty=%d rootParts=%zu\n", pit->second->puppet->isRenderGraphEmpty() ? 1 : 0, pit->second->puppet->rootPartCount());
-    }
-    // Apply deferred texture create/update/dispose callbacks.
+    auto ctxPtr = gRenderers.find(renderer);
+    if (!ctxPtr) return NjgResult::InvalidArgument;
+    auto& ctx = *ctxPtr;
+    std::lock_guard<std::mutex> lock(ctx.mutex);
+    std::vector<std::size_t> signature;
     double textureCmdMs = 0.0;
-    {
-        auto applyTextureProfile = render::profileScope("Unity.applyTextureCommands");
-        const auto textureStart = std::chrono::steady_clock::now();
-        applyTextureCommands(ctx);
-        textureCmdMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - textureStart).count();
+    double packMs = 0.0;
+    if (!reuseCachedEmit(ctx, ctx.queuedCache, signature)) {
+        textureCmdMs = drawRendererFrame(ctx);
+        const auto packStart = std::chrono::steady_clock::now();
+        packQueuedCommands(ctx);
+        packMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - packStart).count();
+        storeEmitCache(ctx, ctx.queuedCache, std::move(signature));
     }
-
-    const auto packStart = std::chrono::steady_clock::now();
-    packQueuedCommands(ctx);
-    const double packMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - packStart).count();
     NJCX_DBG_CODE(unityLog(std::string("[nicxlive] emit packed queue=") + std::to_string(ctx.backend->queue.size())););
     outView->commands = ctx.queued.empty() ? nullptr : ctx.queued.data();
     NJCX_DBG_LOG("[nicxlive] emit packed queue=%zu out=%zu\n", ctx.backend->queue.size(), outView->count);
@@ -1014,61 +1952,154 @@ NjgResult njgEmitCommands(void* renderer, CommandQueueView* outView) {
     return NjgResult::Ok;
 }
 
+NjgResult njgEmitCommandStream(void* renderer, NjgCommandStreamView* outView) {
+    if (!renderer || !outView) return NjgResult::InvalidArgument;
+    auto profile = render::profileScope("Unity.njgEmitCommandStream");
+    const auto start = std::chrono::steady_clock::now();
+    auto ctxPtr = gRenderers.find(renderer);
+    if (!ctxPtr) return NjgResult::InvalidArgument;
+    auto& ctx = *ctxPtr;
+    std::lock_guard<std::mutex> lock(ctx.mutex);
+    std::vector<std::size_t> signature;
+    double textureCmdMs = 0.0;
+    double packMs = 0.0;
+    if (!reuseCachedEmit(ctx, ctx.streamCache, signature)) {
+        textureCmdMs = drawRendererFrame(ctx);
+        const auto packStart = std::chrono::steady_clock::now();
+        packCommandStream(ctx);
+        packMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - packStart).count();
+        storeEmitCache(ctx, ctx.streamCache, std::move(signature));
+    }
+    outView->data = ctx.stream.empty() ? nullptr : ctx.stream.data();
+    outView->size = ctx.stream.size();
+    outView->count = ctx.streamCount;
+    unityPerfWindow().addEmit(
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+        packMs,
+        textureCmdMs);
+    return NjgResult::Ok;
+}
+
+NjgResult njgEmitCommandDelta(void* renderer, NjgCommandDeltaView* outView) {
+    if (!renderer || !outView) return NjgResult::InvalidArgument;
+    auto profile = render::profileScope("Unity.njgEmitCommandDelta");
+    const auto start = std::chrono::steady_clock::now();
+    auto ctxPtr = gRenderers.find(renderer);
+    if (!ctxPtr) return NjgResult::InvalidArgument;
+    auto& ctx = *ctxPtr;
+    std::lock_guard<std::mutex> lock(ctx.mutex);
+    std::vector<std::size_t> signature;
+    double textureCmdMs = 0.0;
+    const auto packStart = std::chrono::steady_clock::now();
+    if (!reuseCachedEmit(ctx, ctx.queuedCache, signature)) {
+        textureCmdMs = drawRendererFrame(ctx);
+        packQueuedCommands(ctx);
+        storeEmitCache(ctx, ctx.queuedCache, std::move(signature));
+    }
+    packCommandDelta(ctx);
+    const double packMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - packStart).count() - textureCmdMs;
+    outView->data = ctx.delta.empty() ? nullptr : ctx.delta.data();
+    outView->size = ctx.delta.size();
+    outView->opCount = ctx.deltaOps;
+    outView->baseCount = ctx.deltaBaseCount;
+    outView->commandCount = ctx.deltaBase.size();
+    unityPerfWindow().addEmit(
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+        packMs,
+        textureCmdMs);
+    return NjgResult::Ok;
+}
+
+NjgResult njgGetEmitState(void* renderer, NjgEmitState* outState) {
+    if (!renderer || !outState) return NjgResult::InvalidArgument;
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    outState->commandsUnchanged = ctx->lastEmitUnchanged ? 1u : 0u;
+    outState->emitSerial = ctx->emitSerial;
+    return NjgResult::Ok;
+}
+
 NjgResult njgGetSharedBuffers(void* renderer, SharedBufferSnapshot* snapshot) {
     if (!renderer || !snapshot) return NjgResult::InvalidArgument;
     auto profile = render::profileScope("Unity.njgGetSharedBuffers");
     const auto start = std::chrono::steady_clock::now();
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it == gRenderers.end()) return NjgResult::InvalidArgument;
-    auto vRaw = ::nicxlive::core::render::sharedVertexBufferData().rawStorage();
-    auto uvRaw = ::nicxlive::core::render::sharedUvBufferData().rawStorage();
-    auto dRaw = ::nicxlive::core::render::sharedDeformBufferData().rawStorage();
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    auto& buffers = *ctx->sharedBuffers;
+    auto vRaw = buffers.vertex.data().rawStorage();
+    auto uvRaw = buffers.uv.data().rawStorage();
+    auto dRaw = buffers.deform.data().rawStorage();
     snapshot->vertices = {vRaw.ptr, vRaw.length};
     snapshot->uvs = {uvRaw.ptr, uvRaw.length};
     snapshot->deform = {dRaw.ptr, dRaw.length};
-    snapshot->vertexCount = ::nicxlive::core::render::sharedVertexBufferData().size();
-    snapshot->uvCount = ::nicxlive::core::render::sharedUvBufferData().size();
-    snapshot->deformCount = ::nicxlive::core::render::sharedDeformBufferData().size();
+    snapshot->vertexCount = buffers.vertex.data().size();
+    snapshot->uvCount = buffers.uv.data().size();
+    snapshot->deformCount = buffers.deform.data().size();
     unityPerfWindow().addShared(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
     return NjgResult::Ok;
 }
 
 NjgResult njgGetSharedBufferState(void* renderer, SharedBufferState* state) {
     if (!renderer || !state) return NjgResult::InvalidArgument;
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it == gRenderers.end()) return NjgResult::InvalidArgument;
-    state->vertexRevision = ::nicxlive::core::render::sharedVertexBufferRevision();
-    state->uvRevision = ::nicxlive::core::render::sharedUvBufferRevision();
-    state->deformRevision = ::nicxlive::core::render::sharedDeformBufferRevision();
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return NjgResult::InvalidArgument;
+    state->vertexRevision = ctx->sharedBuffers->vertex.currentRevision();
+    state->uvRevision = ctx->sharedBuffers->uv.currentRevision();
+    state->deformRevision = ctx->sharedBuffers->deform.currentRevision();
+    return NjgResult::Ok;
+}
+
+NjgResult njgGetSharedBufferDirtyRanges(void* renderer, NjgSharedBufferKind kind, NjgDirtyRange* buffer, size_t bufferLength, size_t* outCount) {
+    if (!outCount) return NjgResult::InvalidArgument;
+    *outCount = 0;
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    const std::vector<SharedVecAtlas::DirtyRange>* ranges = nullptr;
+    switch (kind) {
+    case NjgSharedBufferKind::Vertex: ranges = &ctx->backend->sharedVertexDirtyRanges(); break;
+    case NjgSharedBufferKind::Uv: ranges = &ctx->backend->sharedUvDirtyRanges(); break;
+    case NjgSharedBufferKind::Deform: ranges = &ctx->backend->sharedDeformDirtyRanges(); break;
+    default: return NjgResult::InvalidArgument;
+    }
+    *outCount = ranges->size();
+    if (!buffer) return NjgResult::Ok;
+    if (bufferLength < ranges->size()) return NjgResult::InvalidArgument;
+    for (std::size_t i = 0; i < ranges->size(); ++i) {
+        buffer[i].offset = (*ranges)[i].offset;
+        buffer[i].length = (*ranges)[i].length;
+    }
     return NjgResult::Ok;
 }
 
 NjgRenderTargets njgGetRenderTargets(void* renderer) {
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it == gRenderers.end()) return NjgRenderTargets{0, 0, 0, 0, 0};
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return NjgRenderTargets{0, 0, 0, 0, 0};
+    std::lock_guard<std::mutex> lock(ctx->mutex);
     return NjgRenderTargets{
-        it->second->renderHandle,
-        it->second->compositeHandle,
+        ctx->renderHandle,
+        ctx->compositeHandle,
         0,
-        it->second->lastViewportW,
-        it->second->lastViewportH,
+        ctx->lastViewportW,
+        ctx->lastViewportH,
     };
 }
 
 void njgSetLogCallback(NjgLogFn callback, void* userData) {
-    std::lock_guard<std::mutex> lock(gMutex);
+    std::lock_guard<std::mutex> lock(gRuntimeMutex);
     gLogCallback = callback;
     gLogUserData = userData;
 }
 
 void njgFlushCommandBuffer(void* renderer) {
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it == gRenderers.end()) return;
-    it->second->queued.clear();
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    ctx->queued.clear();
+    ctx->queuedCache.valid = false;
+    ctx->deltaBase.clear();
 }
 
 size_t njgGetGcHeapSize() {
@@ -1077,10 +2108,55 @@ size_t njgGetGcHeapSize() {
 }
 
 TextureStats njgGetTextureStats(void* renderer) {
-    std::lock_guard<std::mutex> lock(gMutex);
-    auto it = gRenderers.find(renderer);
-    if (it == gRenderers.end()) return TextureStats{0, 0, 0};
-    return it->second->stats;
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return TextureStats{0, 0, 0, 0, 0, 0};
+    TextureStats stats{};
+    {
+        std::lock_guard<std::mutex> lock(ctx->mutex);
+        stats = ctx->stats;
+    }
+    const auto cache = inGetTextureCacheStats();
+    stats.cacheHits = cache.hits;
+    stats.cacheMisses = cache.misses;
+    stats.cacheEntries = cache.entries;
+    return stats;
+}
+
+NjgResult njgSetTexturePolicy(void* renderer, const NjgTexturePolicy* policy) {
+    if (!policy) return NjgResult::InvalidArgument;
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return NjgResult::InvalidArgument;
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    ctx->texturePolicy = *policy;
+    trimResidentTextures(*ctx);
+    return NjgResult::Ok;
+}
+
+NjgResult njgGetTextureResidency(void* renderer, NjgTextureResidency* outResidency) {
+    if (!outResidency) return NjgResult::InvalidArgument;
+    auto ctx = gRenderers.find(renderer);
+    if (!ctx) return NjgResult::InvalidArgument;
+    NjgTextureResidency out{0, 0, 0};
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    for (auto h : ctx->puppetHandles) {
+        auto puppetCtx = gPuppets.find(h);
+        if (!puppetCtx) continue;
+        std::lock_guard<std::mutex> puppetLock(puppetCtx->mutex);
+        if (puppetCtx->puppet) addTextureResidency(*puppetCtx->puppet, out);
+    }
+    *outResidency = out;
+    return NjgResult::Ok;
+}
+
+NjgResult njgGetPuppetTextureResidency(void* puppet, NjgTextureResidency* outResidency) {
+    if (!outResidency) return NjgResult::InvalidArgument;
+    auto ctx = gPuppets.find(puppet);
+    if (!ctx) return NjgResult::InvalidArgument;
+    NjgTextureResidency out{0, 0, 0};
+    std::lock_guard<std::mutex> lock(ctx->mutex);
+    if (ctx->puppet) addTextureResidency(*ctx->puppet, out);
+    *outResidency = out;
+    return NjgResult::Ok;
 }
 
 NjgResult njgGetWasmLayout(NjgWasmLayout* outLayout) {
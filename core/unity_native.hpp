@@ -87,6 +87,41 @@ struct SharedBufferState {
     size_t deformRevision;
 };
 
+enum class NjgSharedBufferKind : uint32_t {
+    Vertex,
+    Uv,
+    Deform,
+};
+
+// Element span (offset/length in Vec2 lanes, same units as SharedBufferSnapshot counts).
+struct NjgDirtyRange {
+    size_t offset;
+    size_t length;
+};
+
+// Stages of an njgLoadPuppetAsync job, in order. Reading/Parsing/Building run on a loader thread;
+// Ready means the next njgPollLoad finalizes the puppet on the polling thread.
+enum class NjgLoadStage : uint32_t {
+    Queued,
+    Reading,  // file read + magic check
+    Parsing,  // JSON, node reconstruction, texture decode
+    Building, // root->build(true)
+    Ready,
+    Done,
+    Failed,
+};
+
+struct NjgLoadProgress {
+    NjgLoadStage stage;
+    float fraction; // rough overall progress, 0..1
+};
+
+// Result of the last njgEmitCommands / njgEmitCommandStream on a renderer.
+struct NjgEmitState {
+    uint32_t commandsUnchanged; // 1: the emit returned the previous list again (same buffer, same contents)
+    size_t emitSerial;          // bumped every time an emit produced a new list
+};
+
 struct NjgWasmLayout {
     uint32_t sizeQueued;
     uint32_t offQueuedPart;
@@ -142,6 +177,31 @@ struct TextureStats {
     size_t created;
     size_t released;
     size_t current;
+    // Process-wide content-addressed texture cache (shared by all renderers): texture slots that
+    // reused a live texture loaded from the same bytes, slots that had to be loaded, live entries.
+    size_t cacheHits;
+    size_t cacheMisses;
+    size_t cacheEntries;
+};
+
+// Texture decode/residency for puppets loaded into a renderer (njgSetTexturePolicy).
+struct NjgTexturePolicy {
+    // 1: texture slots keep their encoded payload and are decoded and uploaded (createTexture +
+    // updateTexture) the first frame a part draws them. Applies to loads started afterwards.
+    uint32_t deferDecode;
+    // Decoded pixels of deferred textures kept after upload, least recently drawn dropped first
+    // (they are decoded again if needed). 0 drops them right after the upload; SIZE_MAX keeps all.
+    size_t residentBudgetBytes;
+    // 1: every texture slot drops its CPU pixels once the host's updateTexture returned. Slots that
+    // were not deferred cannot be decoded again (nor saved with their pixels) afterwards.
+    uint32_t releaseAfterUpload;
+};
+
+// Texture slots of all puppets on a renderer, or of one puppet.
+struct NjgTextureResidency {
+    size_t residentBytes; // decoded pixels held on the CPU side
+    size_t residentCount; // slots with decoded pixels
+    size_t deferredCount; // slots holding only their encoded payload
 };
 
 struct NjgRenderTargets {
@@ -227,6 +287,36 @@ struct NjgMaskApplyPacket {
     NjgMaskDrawPacket maskPacket;
 };
 
+// Compact command stream: a byte buffer of records, each an NjgCommandHeader followed by only the
+// payload its kind reads. `size` covers header + payload + padding, so the next record starts at
+// `record + size` (records are kNjgCommandAlign aligned).
+//   DrawPart                  -> NjgPartDrawPacket
+//   ApplyMask                 -> NjgMaskApplyHeader, then NjgPartDrawPacket (kind Part) or NjgMaskDrawPacket (kind Mask)
+//   Begin/EndDynamicComposite -> NjgDynamicCompositePass
+//   BeginMask                 -> NjgBeginMaskPayload
+//   BeginMaskContent/EndMask  -> header only
+constexpr size_t kNjgCommandAlign = 8;
+
+struct NjgCommandHeader {
+    NjgRenderCommandKind kind;
+    uint32_t size;
+};
+
+struct NjgMaskApplyHeader {
+    MaskDrawableKind kind;
+    uint32_t isDodge;
+};
+
+struct NjgBeginMaskPayload {
+    uint32_t usesStencil;
+};
+
+struct NjgCommandStreamView {
+    const uint8_t* data;
+    size_t size;
+    size_t count;
+};
+
 struct NjgQueuedCommand {
     NjgRenderCommandKind kind;
     NjgPartDrawPacket partPacket;
@@ -235,13 +325,97 @@ struct NjgQueuedCommand {
     bool usesStencil;
 };
 
+// Delta command stream: edits that turn the list produced by the previous njgEmitCommandDelta into
+// the current one. Ops are records (NjgDeltaOpHeader, then payload, kNjgCommandAlign aligned) applied
+// in order while walking the previous list with a cursor:
+//   Keep   -> NjgDeltaRun: the next `count` previous commands are unchanged
+//   Remove -> NjgDeltaRun: drop the next `count` previous commands
+//   Insert -> one compact command stream record (NjgCommandHeader + payload), cursor does not move
+//   Patch  -> NjgPartPatchHeader, then the groups named in `fields` in bit order, each padded to
+//             kNjgCommandAlign; applies to the next previous command (always a DrawPart) and keeps it
+// Previous commands left after the last op are dropped. Reordered commands show up as Remove + Insert.
+enum class NjgDeltaOp : uint32_t {
+    Keep,
+    Remove,
+    Insert,
+    Patch,
+};
+
+struct NjgDeltaOpHeader {
+    NjgDeltaOp op;
+    uint32_t size;
+};
+
+struct NjgDeltaRun {
+    uint32_t count;
+    uint32_t reserved;
+};
+
+enum NjgPartPatchField : uint32_t {
+    NjgPartPatchModelMatrix = 1u << 0,  // nodes::Mat4 modelMatrix
+    NjgPartPatchRender = 1u << 1,       // NjgPartRenderPatch
+    NjgPartPatchOpacity = 1u << 2,      // float opacity
+    NjgPartPatchTint = 1u << 3,         // NjgPartTintPatch
+    NjgPartPatchOffsets = 1u << 4,      // NjgPartOffsetsPatch
+};
+
+struct NjgPartPatchHeader {
+    uint32_t fields;
+    uint32_t reserved;
+};
+
+struct NjgPartRenderPatch {
+    nicxlive::core::nodes::Mat4 renderMatrix;
+    float renderRotation;
+};
+
+struct NjgPartTintPatch {
+    nicxlive::core::nodes::Vec3 clampedTint;
+    nicxlive::core::nodes::Vec3 clampedScreen;
+    float emissionStrength;
+};
+
+struct NjgPartOffsetsPatch {
+    size_t vertexOffset;
+    size_t vertexAtlasStride;
+    size_t uvOffset;
+    size_t uvAtlasStride;
+    size_t deformOffset;
+    size_t deformAtlasStride;
+};
+
+struct NjgCommandDeltaView {
+    const uint8_t* data;
+    size_t size;
+    size_t opCount;
+    size_t baseCount;    // length of the list the ops apply to (0 = start from an empty list)
+    size_t commandCount; // length of the list after applying them
+};
+
 // Renderer/Puppet handles
 void njgRuntimeInit();
 void njgRuntimeTerm();
 NjgResult njgCreateRenderer(const UnityRendererConfig* config, const UnityResourceCallbacks* callbacks, void** outRenderer);
 void njgDestroyRenderer(void* renderer);
 NjgResult njgLoadPuppet(void* renderer, const char* pathUtf8, void** outPuppet);
+// Loads from an INP/INX image in caller memory (e.g. a host-side mmap or asset bundle). The bytes are
+// parsed in place and only need to stay valid for the duration of the call.
+NjgResult njgLoadPuppetFromMemory(void* renderer, const uint8_t* data, size_t length, void** outPuppet);
 NjgResult njgUnloadPuppet(void* renderer, void* puppet);
+// Creates another live copy of a loaded puppet without touching its file: the copy has its own
+// parameters, deformation, transform and physics state but shares meshes, keyframes and textures
+// with `templatePuppet`. Either may be unloaded first.
+NjgResult njgInstantiatePuppet(void* renderer, void* templatePuppet, void** outPuppet);
+// Starts loading on a loader thread and returns a load handle at once. Poll it from the thread that
+// drives the renderer: the poll that sees the job Ready registers textures and shared buffers with
+// the renderer there and returns the puppet (stage Done). Done/Failed release the load handle.
+NjgResult njgLoadPuppetAsync(void* renderer, const char* pathUtf8, void** outLoad);
+NjgResult njgPollLoad(void* load, NjgLoadProgress* outProgress, void** outPuppet);
+// Releases the load handle; a puppet still being built is discarded by its loader thread.
+NjgResult njgCancelLoad(void* load);
+// Texture slots of a puppet are decoded in parallel, this many at a time (counting the loading
+// thread). 0 = hardware concurrency, 1 = decode serially.
+void njgSetTextureDecodeThreadCount(size_t threadCount);
 NjgResult njgGetParameters(void* puppet, NjgParameterInfo* buffer, size_t bufferLength, size_t* outCount);
 NjgResult njgUpdateParameters(void* puppet, const PuppetParameterUpdate* updates, size_t updateCount);
 NjgResult njgGetPuppetExtData(void* puppet, const char* key, const uint8_t** outData, size_t* outLength);
@@ -253,14 +427,33 @@ NjgResult njgSetPuppetScale(void* puppet, float sx, float sy);
 NjgResult njgSetPuppetTranslation(void* puppet, float tx, float ty);
 NjgResult njgBeginFrame(void* renderer, const FrameConfig* cfg);
 NjgResult njgTickPuppet(void* puppet, double deltaSeconds);
+// Advances the clock once, then updates every puppet in parallel on the shared worker pool.
+NjgResult njgTickPuppets(void* const* puppets, size_t count, double deltaSeconds);
+// 0 = hardware concurrency, 1 = tick batches serially on the calling thread.
+void njgSetWorkerThreadCount(size_t threadCount);
+// Idle puppets (no input since their last update and nothing moved in it) are not re-updated by
+// the ticks, and the emit hands back the previously packed list untouched.
 NjgResult njgEmitCommands(void* renderer, CommandQueueView* outView);
+// Same frame as njgEmitCommands, packed as the compact command stream instead of NjgQueuedCommand.
+NjgResult njgEmitCommandStream(void* renderer, NjgCommandStreamView* outView);
+// Same frame as njgEmitCommands, as a diff against the previous delta emit on this renderer.
+// njgFlushCommandBuffer drops the base, so the next delta rebuilds the list from scratch.
+NjgResult njgEmitCommandDelta(void* renderer, NjgCommandDeltaView* outView);
+// Hosts can skip re-submitting draw work when commandsUnchanged is set.
+NjgResult njgGetEmitState(void* renderer, NjgEmitState* outState);
 NjgResult njgGetSharedBuffers(void* renderer, SharedBufferSnapshot* snapshot);
 NjgResult njgGetSharedBufferState(void* renderer, SharedBufferState* state);
+// Spans of one shared buffer written by the last njgEmitCommands; a single {0, count} span
+// means re-upload everything (layout changed). Pass buffer = nullptr to query the count.
+NjgResult njgGetSharedBufferDirtyRanges(void* renderer, NjgSharedBufferKind kind, NjgDirtyRange* buffer, size_t bufferLength, size_t* outCount);
 NjgRenderTargets njgGetRenderTargets(void* renderer);
 void njgSetLogCallback(NjgLogFn callback, void* userData);
 void njgFlushCommandBuffer(void* renderer);
 size_t njgGetGcHeapSize();
 TextureStats njgGetTextureStats(void* renderer);
+NjgResult njgSetTexturePolicy(void* renderer, const NjgTexturePolicy* policy);
+NjgResult njgGetTextureResidency(void* renderer, NjgTextureResidency* outResidency);
+NjgResult njgGetPuppetTextureResidency(void* puppet, NjgTextureResidency* outResidency);
 NjgResult njgGetWasmLayout(NjgWasmLayout* outLayout);
 
 } // extern "C"
@@ -0,0 +1,164 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+
+namespace nicxlive::core {
+
+WorkerPool::WorkerPool(std::size_t threadCount) {
+    setThreadCount(threadCount);
+}
+
+WorkerPool::~WorkerPool() {
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    stopWorkers();
+}
+
+void WorkerPool::setThreadCount(std::size_t threadCount) {
+    if (threadCount == 0) threadCount = defaultWorkerThreadCount();
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    if (threadCount == threadCount_ && workers_.size() + 1 == threadCount_) return;
+    stopWorkers();
+    threadCount_ = threadCount;
+    startWorkers(threadCount_ - 1);
+}
+
+std::size_t WorkerPool::threadCount() const {
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    return threadCount_;
+}
+
+void WorkerPool::startWorkers(std::size_t workerCount) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = false;
+    }
+    workers_.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+void WorkerPool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+}
+
+void WorkerPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+    if (count == 0 || !fn) return;
+    std::lock_guard<std::mutex> runLock(runMutex_);
+    const std::size_t participants = (std::min)(workers_.size() + 1, count);
+    if (participants <= 1) {
+        // Deterministic fallback: same order as a plain loop.
+        for (std::size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    Batch batch;
+    batch.fn = &fn;
+    batch.remaining.store(count);
+    batch.queues.reserve(workers_.size() + 1);
+    for (std::size_t p = 0; p < workers_.size() + 1; ++p) {
+        batch.queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (std::size_t p = 0; p < participants; ++p) {
+        const std::size_t begin = count * p / participants;
+        const std::size_t end = count * (p + 1) / participants;
+        for (std::size_t i = begin; i < end; ++i) batch.queues[p]->items.push_back(i);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        batch_ = &batch;
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    // The caller takes the last queue so workers keep their own slots.
+    runParticipant(batch, workers_.size());
+
+    {
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        done_.wait(lock, [&]() { return batch.remaining.load() == 0 && activeWorkers_ == 0; });
+        batch_ = nullptr;
+    }
+    if (batch.error) std::rethrow_exception(batch.error);
+}
+
+void WorkerPool::workerLoop(std::size_t participant) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        Batch* batch = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            wake_.wait(lock, [&]() { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+            batch = batch_;
+            if (!batch) continue;
+            ++activeWorkers_;
+        }
+        runParticipant(*batch, participant);
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            --activeWorkers_;
+        }
+        done_.notify_all();
+    }
+}
+
+void WorkerPool::runParticipant(Batch& batch, std::size_t participant) {
+    const std::size_t queueCount = batch.queues.size();
+    std::size_t index = 0;
+    for (;;) {
+        bool found = popOwn(*batch.queues[participant], index);
+        for (std::size_t k = 1; !found && k < queueCount; ++k) {
+            found = steal(*batch.queues[(participant + k) % queueCount], index);
+        }
+        if (!found) return;
+        try {
+            (*batch.fn)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(batch.errorMutex);
+            if (!batch.error) batch.error = std::current_exception();
+        }
+        if (batch.remaining.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            done_.notify_all();
+        }
+    }
+}
+
+bool WorkerPool::popOwn(WorkQueue& queue, std::size_t& out) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.items.empty()) return false;
+    out = queue.items.front();
+    queue.items.pop_front();
+    return true;
+}
+
+bool WorkerPool::steal(WorkQueue& queue, std::size_t& out) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.items.empty()) return false;
+    out = queue.items.back();
+    queue.items.pop_back();
+    return true;
+}
+
+std::size_t defaultWorkerThreadCount() {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<std::size_t>(hw);
+}
+
+WorkerPool& sharedWorkerPool() {
+    static WorkerPool pool{};
+    return pool;
+}
+
+} // namespace nicxlive::core
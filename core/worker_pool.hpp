@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nicxlive::core {
+
+// Fork/join pool for fanning independent per-puppet work out across cores.
+// Each participant (workers + the calling thread) owns a deque seeded with a contiguous
+// slice of the index range; once it runs dry it steals from the back of the others.
+// threadCount counts the calling thread, so 1 means "run inline, in index order".
+class WorkerPool {
+public:
+    explicit WorkerPool(std::size_t threadCount = 0);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // 0 selects defaultWorkerThreadCount().
+    void setThreadCount(std::size_t threadCount);
+    std::size_t threadCount() const;
+
+    // Runs fn(i) for every i in [0, count) and blocks until all have finished.
+    // The first exception thrown by fn is rethrown on the calling thread.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+private:
+    struct WorkQueue {
+        std::mutex mutex{};
+        std::deque<std::size_t> items{};
+    };
+    struct Batch {
+        const std::function<void(std::size_t)>* fn{nullptr};
+        std::vector<std::unique_ptr<WorkQueue>> queues{};
+        std::atomic<std::size_t> remaining{0};
+        std::mutex errorMutex{};
+        std::exception_ptr error{};
+    };
+
+    void startWorkers(std::size_t workerCount);
+    void stopWorkers();
+    void workerLoop(std::size_t participant);
+    void runParticipant(Batch& batch, std::size_t participant);
+    static bool popOwn(WorkQueue& queue, std::size_t& out);
+    static bool steal(WorkQueue& queue, std::size_t& out);
+
+    mutable std::mutex runMutex_{};
+    std::size_t threadCount_{1};
+
+    std::mutex stateMutex_{};
+    std::condition_variable wake_{};
+    std::condition_variable done_{};
+    std::vector<std::thread> workers_{};
+    Batch* batch_{nullptr};
+    std::uint64_t generation_{0};
+    std::size_t activeWorkers_{0};
+    bool stopping_{false};
+};
+
+std::size_t defaultWorkerThreadCount();
+
+// Process-wide pool used by batched puppet ticking.
+WorkerPool& sharedWorkerPool();
+
+} // namespace nicxlive::core
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -10,10 +12,19 @@ namespace nicxlive::core::fmt {
 inline const std::array<uint8_t, 8> MAGIC_BYTES{0x54, 0x52, 0x4E, 0x53, 0x52, 0x54, 0x53, 0x00}; // "TRNSRTS\0"
 inline const std::array<uint8_t, 8> TEX_SECTION{0x54, 0x45, 0x58, 0x5F, 0x53, 0x45, 0x43, 0x54}; // "TEX_SECT"
 inline const std::array<uint8_t, 8> EXT_SECTION{0x45, 0x58, 0x54, 0x5F, 0x53, 0x45, 0x43, 0x54}; // "EXT_SECT"
+// Precompiled puppet cache (fmt/cache.hpp), not part of the nijilive format.
+inline const std::array<uint8_t, 8> CACHE_MAGIC_BYTES{0x4E, 0x49, 0x43, 0x58, 0x43, 0x41, 0x43, 0x48}; // "NICXCACH"
+
+inline bool inVerifyMagicBytes(const uint8_t* data, std::size_t size) {
+    return size >= MAGIC_BYTES.size() && std::equal(MAGIC_BYTES.begin(), MAGIC_BYTES.end(), data);
+}
 
 inline bool inVerifyMagicBytes(const std::vector<uint8_t>& data) {
-    return data.size() >= MAGIC_BYTES.size() &&
-           std::equal(MAGIC_BYTES.begin(), MAGIC_BYTES.end(), data.begin());
+    return inVerifyMagicBytes(data.data(), data.size());
+}
+
+inline bool inVerifyPuppetCacheMagic(const uint8_t* data, std::size_t size) {
+    return size >= CACHE_MAGIC_BYTES.size() && std::equal(CACHE_MAGIC_BYTES.begin(), CACHE_MAGIC_BYTES.end(), data);
 }
 
 inline bool inVerifySection(const std::vector<uint8_t>& data, const std::array<uint8_t, 8>& section) {
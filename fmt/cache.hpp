@@ -0,0 +1,419 @@
+#pragma once
+
+#include "fmt.hpp"
+#include "../json.hpp"
+#include "../nodes/mesh_group.hpp"
+#include "../nodes/path_deformer.hpp"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nicxlive::core::fmt {
+
+// Precompiled puppet cache (.nicxc). Holds what loading an INP/INX produces before the renderer
+// sees it: the puppet JSON as a flattened node table (keys and scalars in one string blob, so no
+// text is parsed on load), decoded texture pixels (or the original encoded payload), EXT data and
+// the load-time precalculation of MeshGroups (triangle offset matrices, bit mask) and
+// PathDeformers (closest-point caches per target).
+//
+// Sections are 16-byte aligned and stored in host byte order so a mapped file is read in place;
+// a cache written on a host with the other byte order, or by another format version, is rejected
+// and has to be rebuilt from its source.
+inline constexpr uint32_t PUPPET_CACHE_VERSION = 1;
+inline constexpr uint32_t PUPPET_CACHE_BYTE_ORDER = 0x01020304;
+inline constexpr uint32_t PUPPET_CACHE_FROM_INP = 1u << 0;
+
+enum class PuppetCacheSection : uint32_t {
+    JsonNodes,   // serde::JsonFlatNode[]
+    JsonStrings, // char[]
+    Textures,    // PuppetCacheTexture[], one per slot
+    Ext,         // {u32 nameLength, u32 payloadLength, name, payload}...
+    MeshGroups,  // PuppetCacheMeshGroup[]
+    PathTargets, // PuppetCachePathTarget[]
+    Data,        // texture bytes and precalculated arrays, referenced by offset
+    Count,
+};
+
+struct PuppetCacheRange {
+    uint64_t offset{0};
+    uint64_t size{0};
+};
+
+struct PuppetCacheHeader {
+    uint8_t magic[8]{};
+    uint32_t version{0};
+    uint32_t byteOrder{0};
+    uint32_t flags{0};
+    uint32_t reserved{0};
+    // Size and FNV-1a hash of the INP/INX the cache was built from (inPuppetCacheMatches).
+    uint64_t sourceSize{0};
+    uint64_t sourceHash{0};
+    PuppetCacheRange sections[static_cast<std::size_t>(PuppetCacheSection::Count)]{};
+};
+
+enum class PuppetCacheTextureEncoding : uint32_t {
+    Empty,   // the source slot had no usable payload
+    Pixels,  // decoded pixels, width * height * channels bytes
+    Encoded, // the source PNG/TGA payload, decoded on load (or deferred)
+};
+
+struct PuppetCacheTexture {
+    uint32_t width{0};
+    uint32_t height{0};
+    uint32_t channels{0};
+    PuppetCacheTextureEncoding encoding{PuppetCacheTextureEncoding::Empty};
+    PuppetCacheRange data{}; // in the Data section
+};
+
+struct PuppetCacheMeshGroup {
+    uint32_t uuid{0};
+    uint32_t triangleCount{0};
+    uint64_t bitMaskSize{0};
+    float bounds[4]{};
+    uint64_t trianglesOffset{0}; // triangleCount * 9 floats (offset matrices, row major)
+    uint64_t bitMaskOffset{0};   // bitMaskSize * uint16_t
+};
+
+struct PuppetCachePathTarget {
+    uint32_t deformerUuid{0};
+    uint32_t targetUuid{0};
+    uint64_t count{0};
+    uint64_t offset{0}; // count floats
+};
+
+struct PuppetCacheOptions {
+    // Store each texture slot's encoded payload instead of its decoded pixels: a much smaller
+    // cache, but textures are decoded on every load again.
+    bool keepEncodedTextures{false};
+};
+
+inline uint64_t inPuppetCacheSourceHash(const uint8_t* data, std::size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Validated view of a cache in memory. Section contents are read in place when they are aligned
+// (always the case for a mapped file) and copied once otherwise.
+class PuppetCacheView {
+public:
+    PuppetCacheView(const uint8_t* data, std::size_t size) : data_(data) {
+        if (!inVerifyPuppetCacheMagic(data, size) || size < sizeof(PuppetCacheHeader)) {
+            throw std::runtime_error("Invalid puppet cache");
+        }
+        std::memcpy(&header_, data, sizeof(header_));
+        if (header_.byteOrder != PUPPET_CACHE_BYTE_ORDER) throw std::runtime_error("Puppet cache was written with another byte order");
+        if (header_.version != PUPPET_CACHE_VERSION) {
+            throw std::runtime_error("Unsupported puppet cache version " + std::to_string(header_.version));
+        }
+        for (const auto& range : header_.sections) {
+            if (range.offset > size || range.size > size - range.offset) throw std::runtime_error("Invalid puppet cache section");
+        }
+    }
+
+    const PuppetCacheHeader& header() const { return header_; }
+
+    template <typename T>
+    std::pair<const T*, std::size_t> table(PuppetCacheSection section, std::vector<T>& scratch) const {
+        const auto& range = header_.sections[static_cast<std::size_t>(section)];
+        if (range.size % sizeof(T) != 0) throw std::runtime_error("Invalid puppet cache table");
+        const std::size_t count = static_cast<std::size_t>(range.size / sizeof(T));
+        const uint8_t* bytes = data_ + range.offset;
+        if (reinterpret_cast<std::uintptr_t>(bytes) % alignof(T) == 0) {
+            return {reinterpret_cast<const T*>(bytes), count};
+        }
+        scratch.resize(count);
+        if (count) std::memcpy(scratch.data(), bytes, count * sizeof(T));
+        return {scratch.data(), count};
+    }
+
+    std::string_view bytes(PuppetCacheSection section) const {
+        const auto& range = header_.sections[static_cast<std::size_t>(section)];
+        return std::string_view(reinterpret_cast<const char*>(data_ + range.offset), static_cast<std::size_t>(range.size));
+    }
+
+    // `size` bytes at `offset` in the Data section.
+    const uint8_t* data(uint64_t offset, uint64_t size) const {
+        const auto& range = header_.sections[static_cast<std::size_t>(PuppetCacheSection::Data)];
+        if (offset > range.size || size > range.size - offset) throw std::runtime_error("Invalid puppet cache data reference");
+        return data_ + range.offset + offset;
+    }
+
+private:
+    const uint8_t* data_;
+    PuppetCacheHeader header_{};
+};
+
+// True if the cache was built from exactly these INP/INX bytes.
+inline bool inPuppetCacheMatches(const uint8_t* cache, std::size_t cacheSize, const uint8_t* source, std::size_t sourceSize) {
+    if (!inVerifyPuppetCacheMagic(cache, cacheSize) || cacheSize < sizeof(PuppetCacheHeader)) return false;
+    PuppetCacheHeader header;
+    std::memcpy(&header, cache, sizeof(header));
+    return header.version == PUPPET_CACHE_VERSION && header.byteOrder == PUPPET_CACHE_BYTE_ORDER &&
+           header.sourceSize == sourceSize && header.sourceHash == inPuppetCacheSourceHash(source, sourceSize);
+}
+
+// Hands the cached MeshGroup and PathDeformer precalculation to the nodes of a freshly
+// deserialized tree; the first build keeps it instead of computing it again. Entries that no
+// longer fit their node are ignored.
+inline void inAdoptPuppetCachePrecalculation(const PuppetCacheView& cache, const std::shared_ptr<nodes::Node>& root) {
+    if (!root) return;
+    std::vector<PuppetCacheMeshGroup> meshGroupScratch;
+    std::vector<PuppetCachePathTarget> pathScratch;
+    const auto [meshGroups, meshGroupCount] = cache.table(PuppetCacheSection::MeshGroups, meshGroupScratch);
+    const auto [pathTargets, pathTargetCount] = cache.table(PuppetCacheSection::PathTargets, pathScratch);
+    if (meshGroupCount == 0 && pathTargetCount == 0) return;
+
+    std::unordered_map<uint32_t, const PuppetCacheMeshGroup*> meshGroupsByUuid;
+    for (std::size_t i = 0; i < meshGroupCount; ++i) meshGroupsByUuid.emplace(meshGroups[i].uuid, &meshGroups[i]);
+    std::unordered_map<uint32_t, std::vector<const PuppetCachePathTarget*>> pathTargetsByUuid;
+    for (std::size_t i = 0; i < pathTargetCount; ++i) pathTargetsByUuid[pathTargets[i].deformerUuid].push_back(&pathTargets[i]);
+
+    auto adopt = [&](const std::shared_ptr<nodes::Node>& node, const auto& self) -> void {
+        if (!node) return;
+        if (auto group = std::dynamic_pointer_cast<nodes::MeshGroup>(node)) {
+            if (auto it = meshGroupsByUuid.find(node->uuid); it != meshGroupsByUuid.end()) {
+                const auto& entry = *it->second;
+                std::vector<nodes::TriangleMapping> triangles(entry.triangleCount);
+                const auto* matrices = cache.data(entry.trianglesOffset, uint64_t{entry.triangleCount} * 9 * sizeof(float));
+                for (std::size_t t = 0; t < triangles.size(); ++t) {
+                    std::memcpy(triangles[t].offsetMatrices.m, matrices + t * 9 * sizeof(float), 9 * sizeof(float));
+                }
+                auto bitMask = std::make_shared<std::vector<uint16_t>>(static_cast<std::size_t>(entry.bitMaskSize));
+                if (!bitMask->empty()) {
+                    std::memcpy(bitMask->data(), cache.data(entry.bitMaskOffset, entry.bitMaskSize * sizeof(uint16_t)),
+                                bitMask->size() * sizeof(uint16_t));
+                }
+                ::nicxlive::core::math::Vec4 bounds{entry.bounds[0], entry.bounds[1], entry.bounds[2], entry.bounds[3]};
+                group->adoptPrecalculation(bounds, std::move(triangles), std::move(bitMask));
+            }
+        } else if (auto path = std::dynamic_pointer_cast<nodes::PathDeformer>(node)) {
+            if (auto it = pathTargetsByUuid.find(node->uuid); it != pathTargetsByUuid.end()) {
+                for (const auto* entry : it->second) {
+                    auto& points = path->adoptedClosestPoints[entry->targetUuid];
+                    points.resize(static_cast<std::size_t>(entry->count));
+                    if (!points.empty()) {
+                        std::memcpy(points.data(), cache.data(entry->offset, entry->count * sizeof(float)), points.size() * sizeof(float));
+                    }
+                }
+            }
+        }
+        for (const auto& child : node->childrenRef()) self(child, self);
+    };
+    adopt(root, adopt);
+}
+
+template <typename T>
+std::shared_ptr<T> inLoadPuppetCacheFromMemory(const uint8_t* data, std::size_t size, const PuppetLoadOptions& options) {
+    const PuppetCacheView cache(data, size);
+    inpModeFlag() = (cache.header().flags & PUPPET_CACHE_FROM_INP) != 0;
+
+    std::shared_ptr<T> puppet;
+    {
+        std::vector<serde::JsonFlatNode> scratch;
+        const auto [nodes, nodeCount] = cache.table(PuppetCacheSection::JsonNodes, scratch);
+        serde::JsonDocument document(nodes, nodeCount, cache.bytes(PuppetCacheSection::JsonStrings));
+        puppet = inLoadPuppetDocument<T>(document);
+    }
+
+    if constexpr (requires(std::shared_ptr<T> p) { p->textureSlots; }) {
+        std::vector<PuppetCacheTexture> scratch;
+        const auto [textures, textureCount] = cache.table(PuppetCacheSection::Textures, scratch);
+        if (puppet->textureSlots.size() < textureCount) puppet->textureSlots.resize(textureCount);
+        std::vector<::nicxlive::core::EncodedImage> payloads;
+        std::vector<std::size_t> payloadSlots;
+        for (std::size_t i = 0; i < textureCount; ++i) {
+            const auto& entry = textures[i];
+            const auto* bytes = cache.data(entry.data.offset, entry.data.size);
+            if (entry.encoding == PuppetCacheTextureEncoding::Pixels) {
+                const uint64_t expected = uint64_t{entry.width} * entry.height * entry.channels;
+                if (expected == 0 || expected != entry.data.size) throw std::runtime_error("Invalid cached texture");
+                puppet->textureSlots[i] = ::nicxlive::core::inLoadTextureSlot(bytes, static_cast<int>(entry.width),
+                                                                            static_cast<int>(entry.height), static_cast<int>(entry.channels));
+            } else {
+                payloads.push_back({bytes, static_cast<std::size_t>(entry.data.size)});
+                payloadSlots.push_back(i);
+            }
+        }
+        const auto slots = ::nicxlive::core::inLoadTextureSlots(payloads, options.deferTextureDecode);
+        for (std::size_t i = 0; i < slots.size(); ++i) puppet->textureSlots[payloadSlots[i]] = slots[i];
+    }
+
+    if constexpr (requires(std::shared_ptr<T> p) { p->extData; }) {
+        const auto ext = cache.bytes(PuppetCacheSection::Ext);
+        std::size_t offset = 0;
+        auto readU32 = [&]() {
+            if (ext.size() - offset < 4) throw std::runtime_error("Invalid cached ext data");
+            uint32_t v = 0;
+            std::memcpy(&v, ext.data() + offset, 4);
+            offset += 4;
+            return v;
+        };
+        while (offset < ext.size()) {
+            const uint32_t nameLen = readU32();
+            const uint32_t payloadLen = readU32();
+            if (uint64_t{nameLen} + payloadLen > ext.size() - offset) throw std::runtime_error("Invalid cached ext data");
+            std::string name(ext.substr(offset, nameLen));
+            offset += nameLen;
+            const auto* payload = reinterpret_cast<const uint8_t*>(ext.data() + offset);
+            puppet->extData[name].assign(payload, payload + payloadLen);
+            offset += payloadLen;
+        }
+    }
+
+    if constexpr (requires(std::shared_ptr<T> p) { p->actualRoot(); }) {
+        inAdoptPuppetCachePrecalculation(cache, puppet->actualRoot());
+    }
+    return puppet;
+}
+
+// Builds a cache from INP/INX bytes. The puppet is loaded and built once here so the cache can
+// carry the build's precalculation.
+inline std::vector<uint8_t> inWritePuppetCacheMemory(const uint8_t* source, std::size_t size, const PuppetCacheOptions& options = {}) {
+    if (inVerifyPuppetCacheMagic(source, size)) throw std::runtime_error("Source is already a puppet cache");
+    const bool fromINP = inVerifyMagicBytes(source, size);
+    std::string_view json(reinterpret_cast<const char*>(source), size);
+    if (fromINP) {
+        std::size_t offset = MAGIC_BYTES.size();
+        if (size < offset + 4) throw std::runtime_error("Unexpected EOF");
+        const uint32_t puppetLen = (static_cast<uint32_t>(source[offset]) << 24) | (static_cast<uint32_t>(source[offset + 1]) << 16) |
+                                   (static_cast<uint32_t>(source[offset + 2]) << 8) | static_cast<uint32_t>(source[offset + 3]);
+        offset += 4;
+        if (puppetLen > size - offset) throw std::runtime_error("Invalid INP puppet length");
+        json = json.substr(offset, puppetLen);
+    }
+
+    std::vector<serde::JsonFlatNode> jsonNodes;
+    std::string jsonStrings;
+    serde::JsonDocument(json).flatten(jsonNodes, jsonStrings);
+
+    // Load and build the way a host does, keeping the encoded payloads around.
+    PuppetLoadOptions loadOptions;
+    loadOptions.deferTextureDecode = true;
+    auto puppet = inLoadPuppetFromMemory<Puppet>(source, size, loadOptions);
+    if (auto root = puppet->actualRoot()) {
+        puppet->rescanNodes();
+        root->build(true);
+    }
+
+    std::vector<uint8_t> dataSection;
+    auto appendData = [&](const void* bytes, std::size_t length) {
+        dataSection.resize((dataSection.size() + 15) & ~std::size_t{15});
+        const uint64_t offset = dataSection.size();
+        const auto* begin = static_cast<const uint8_t*>(bytes);
+        dataSection.insert(dataSection.end(), begin, begin + length);
+        return offset;
+    };
+
+    std::vector<PuppetCacheTexture> textures;
+    for (const auto& tex : puppet->textureSlots) {
+        PuppetCacheTexture entry;
+        if (tex && options.keepEncodedTextures && tex->hasEncodedSource()) {
+            const auto& encoded = tex->encodedData();
+            entry.encoding = PuppetCacheTextureEncoding::Encoded;
+            entry.data = {appendData(encoded.data(), encoded.size()), encoded.size()};
+        } else if (tex && tex->ensureDecoded()) {
+            const auto& pixels = tex->data();
+            entry.encoding = PuppetCacheTextureEncoding::Pixels;
+            entry.width = static_cast<uint32_t>(tex->width());
+            entry.height = static_cast<uint32_t>(tex->height());
+            entry.channels = static_cast<uint32_t>(tex->channels());
+            entry.data = {appendData(pixels.data(), pixels.size()), pixels.size()};
+        }
+        textures.push_back(entry);
+    }
+
+    std::vector<uint8_t> ext;
+    auto appendU32 = [&](uint32_t v) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&v);
+        ext.insert(ext.end(), bytes, bytes + 4);
+    };
+    for (const auto& [name, payload] : puppet->extData) {
+        appendU32(static_cast<uint32_t>(name.size()));
+        appendU32(static_cast<uint32_t>(payload.size()));
+        ext.insert(ext.end(), name.begin(), name.end());
+        ext.insert(ext.end(), payload.begin(), payload.end());
+    }
+
+    std::vector<PuppetCacheMeshGroup> meshGroups;
+    std::vector<PuppetCachePathTarget> pathTargets;
+    auto collect = [&](const std::shared_ptr<nodes::Node>& node, const auto& self) -> void {
+        if (!node) return;
+        if (auto group = std::dynamic_pointer_cast<nodes::MeshGroup>(node)) {
+            if (group->precalculated && group->bitMask) {
+                PuppetCacheMeshGroup entry;
+                entry.uuid = group->uuid;
+                entry.triangleCount = static_cast<uint32_t>(group->triangles.size());
+                entry.bitMaskSize = group->bitMask->size();
+                entry.bounds[0] = group->bounds.x;
+                entry.bounds[1] = group->bounds.y;
+                entry.bounds[2] = group->bounds.z;
+                entry.bounds[3] = group->bounds.w;
+                std::vector<float> matrices;
+                matrices.reserve(group->triangles.size() * 9);
+                for (const auto& tri : group->triangles) {
+                    matrices.insert(matrices.end(), &tri.offsetMatrices.m[0][0], &tri.offsetMatrices.m[0][0] + 9);
+                }
+                entry.trianglesOffset = appendData(matrices.data(), matrices.size() * sizeof(float));
+                entry.bitMaskOffset = appendData(group->bitMask->data(), group->bitMask->size() * sizeof(uint16_t));
+                meshGroups.push_back(entry);
+            }
+        } else if (auto path = std::dynamic_pointer_cast<nodes::PathDeformer>(node)) {
+            for (const auto& [target, points] : path->meshCaches) {
+                if (!target) continue;
+                PuppetCachePathTarget entry;
+                entry.deformerUuid = path->uuid;
+                entry.targetUuid = target->uuid;
+                entry.count = points.size();
+                entry.offset = appendData(points.data(), points.size() * sizeof(float));
+                pathTargets.push_back(entry);
+            }
+        }
+        for (const auto& child : node->childrenRef()) self(child, self);
+    };
+    collect(puppet->actualRoot(), collect);
+
+    PuppetCacheHeader header;
+    std::copy(CACHE_MAGIC_BYTES.begin(), CACHE_MAGIC_BYTES.end(), header.magic);
+    header.version = PUPPET_CACHE_VERSION;
+    header.byteOrder = PUPPET_CACHE_BYTE_ORDER;
+    header.flags = fromINP ? PUPPET_CACHE_FROM_INP : 0;
+    header.sourceSize = size;
+    header.sourceHash = inPuppetCacheSourceHash(source, size);
+
+    std::vector<uint8_t> out(sizeof(PuppetCacheHeader));
+    auto appendSection = [&](PuppetCacheSection section, const void* bytes, std::size_t length) {
+        out.resize((out.size() + 15) & ~std::size_t{15});
+        header.sections[static_cast<std::size_t>(section)] = {out.size(), length};
+        const auto* begin = static_cast<const uint8_t*>(bytes);
+        out.insert(out.end(), begin, begin + length);
+    };
+    appendSection(PuppetCacheSection::JsonNodes, jsonNodes.data(), jsonNodes.size() * sizeof(serde::JsonFlatNode));
+    appendSection(PuppetCacheSection::JsonStrings, jsonStrings.data(), jsonStrings.size());
+    appendSection(PuppetCacheSection::Textures, textures.data(), textures.size() * sizeof(PuppetCacheTexture));
+    appendSection(PuppetCacheSection::Ext, ext.data(), ext.size());
+    appendSection(PuppetCacheSection::MeshGroups, meshGroups.data(), meshGroups.size() * sizeof(PuppetCacheMeshGroup));
+    appendSection(PuppetCacheSection::PathTargets, pathTargets.data(), pathTargets.size() * sizeof(PuppetCachePathTarget));
+    appendSection(PuppetCacheSection::Data, dataSection.data(), dataSection.size());
+    std::memcpy(out.data(), &header, sizeof(header));
+    return out;
+}
+
+inline void inWritePuppetCache(const std::string& sourceFile, const std::string& cacheFile, const PuppetCacheOptions& options = {}) {
+    const auto source = inReadPuppetFile(sourceFile);
+    const auto data = inWritePuppetCacheMemory(source.data(), source.size(), options);
+    std::ofstream ofs(cacheFile, std::ios::binary);
+    if (!ofs) throw std::runtime_error("Failed to open file: " + cacheFile);
+    ofs.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!ofs) throw std::runtime_error("Failed to write file: " + cacheFile);
+}
+
+} // namespace nicxlive::core::fmt
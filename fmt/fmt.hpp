@@ -13,6 +13,7 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 
@@ -44,8 +45,9 @@ inline std::vector<uint8_t> encodeTga(const std::vector<uint8_t>& data, int widt
     return out;
 }
 
+// Per thread: set for the duration of one load, and loads may run on several threads at once.
 inline bool& inpModeFlag() {
-    static bool flag = false;
+    static thread_local bool flag = false;
     return flag;
 }
 
@@ -53,22 +55,58 @@ inline bool inIsINPMode() {
     return inpModeFlag();
 }
 
+// Members a puppet instance shares with its template instead of reading them: node meshes and
+// binding keyframe values (see inInstantiatePuppet).
+inline bool inIsInstanceSharedMember(const serde::JsonValue& parent, std::string_view key) {
+    if (key == "mesh") return parent.find("type") != parent.not_found();
+    if (key == "values") return parent.find("param_name") != parent.not_found();
+    return false;
+}
+
+// Deserializes a puppet and keeps the rest of its document as the model instances are built from.
+template <typename T>
+std::shared_ptr<T> inLoadPuppetDocument(const serde::JsonDocument& document) {
+    auto puppet = IDeserializable<T>::deserialize(document.root());
+    if constexpr (requires(std::shared_ptr<T> p) { p->instanceModel; }) {
+        auto model = std::make_shared<PuppetInstanceModel>();
+        document.flatten(model->nodes, model->strings, inIsInstanceSharedMember);
+        model->inpMode = inIsINPMode();
+        puppet->instanceModel = std::move(model);
+    }
+    return puppet;
+}
+
+template <typename T>
+std::shared_ptr<T> inLoadPuppetJson(std::string_view text) {
+    serde::JsonDocument document(text);
+    return inLoadPuppetDocument<T>(document);
+}
+
 // JSON-based load/save
 template <typename T>
 std::shared_ptr<T> inLoadJSONPuppet(const std::string& data) {
     inpModeFlag() = false;
-    return inLoadJsonDataFromMemory<T>(data);
+    return inLoadPuppetJson<T>(data);
 }
 
+struct PuppetLoadOptions {
+    // Texture slots keep their encoded payload and decode on first use (Texture::ensureDecoded)
+    // instead of during the load.
+    bool deferTextureDecode{false};
+};
+
+// Loads a precompiled puppet cache; defined in cache.hpp.
 template <typename T>
-std::shared_ptr<T> inLoadPuppetFromMemory(const std::vector<uint8_t>& data) {
-    // Detect INP/INX magic
-    auto startsWith = [&](const std::array<uint8_t, 8>& magic) {
-        return data.size() >= magic.size() &&
-               std::equal(magic.begin(), magic.end(), data.begin());
-    };
+std::shared_ptr<T> inLoadPuppetCacheFromMemory(const uint8_t* data, std::size_t size, const PuppetLoadOptions& options);
+
+// Parses an INP/INX container (or bare JSON) in place: the JSON section is read straight from
+// `data` and textures are decoded from their payload bytes without intermediate copies, so the
+// caller's buffer (often a MappedFile) is the only copy of the file. Puppet caches (.nicxc) are
+// recognised by their magic and loaded by inLoadPuppetCacheFromMemory.
+template <typename T>
+std::shared_ptr<T> inLoadPuppetFromMemory(const uint8_t* data, std::size_t size, const PuppetLoadOptions& options = {}) {
     auto readU32 = [&](std::size_t& offset) -> uint32_t {
-        if (offset + 4 > data.size()) throw std::runtime_error("Unexpected EOF");
+        if (offset + 4 > size) throw std::runtime_error("Unexpected EOF");
         uint32_t v = (static_cast<uint32_t>(data[offset]) << 24) |
                      (static_cast<uint32_t>(data[offset + 1]) << 16) |
                      (static_cast<uint32_t>(data[offset + 2]) << 8) |
@@ -76,61 +114,62 @@ std::shared_ptr<T> inLoadPuppetFromMemory(const std::vector<uint8_t>& data) {
         offset += 4;
         return v;
     };
+    auto atSection = [&](std::size_t offset, const std::array<uint8_t, 8>& section) {
+        return offset + section.size() <= size && std::equal(section.begin(), section.end(), data + offset);
+    };
 
-    if (!startsWith(MAGIC_BYTES)) {
+    if (inVerifyPuppetCacheMagic(data, size)) {
+        return inLoadPuppetCacheFromMemory<T>(data, size, options);
+    }
+    if (!inVerifyMagicBytes(data, size)) {
         // Fallback: treat as JSON string
-        return inLoadJsonDataFromMemory<T>(std::string(data.begin(), data.end()));
+        return inLoadPuppetJson<T>(std::string_view(reinterpret_cast<const char*>(data), size));
     }
 
     inpModeFlag() = true;
     std::size_t offset = MAGIC_BYTES.size();
     uint32_t puppetLen = readU32(offset);
-    if (offset + puppetLen > data.size()) throw std::runtime_error("Invalid INP puppet length");
-    std::string puppetJson(reinterpret_cast<const char*>(data.data() + offset), puppetLen);
+    if (puppetLen > size - offset) throw std::runtime_error("Invalid INP puppet length");
+    auto puppet = inLoadPuppetJson<T>(std::string_view(reinterpret_cast<const char*>(data + offset), puppetLen));
     offset += puppetLen;
 
-    auto puppet = inLoadJsonDataFromMemory<T>(puppetJson);
-
-    // Texture section
-    if (offset + TEX_SECTION.size() <= data.size() &&
-        std::equal(TEX_SECTION.begin(), TEX_SECTION.end(), data.begin() + offset)) {
+    // Texture section: slices first, then the slots no live puppet shares are decoded in one
+    // parallel pass in slot order (or kept encoded as deferred slots).
+    if (atSection(offset, TEX_SECTION)) {
         offset += TEX_SECTION.size();
         uint32_t slotCount = readU32(offset);
+        std::vector<::nicxlive::core::EncodedImage> payloads;
+        payloads.reserve(slotCount);
         for (uint32_t i = 0; i < slotCount; ++i) {
             uint32_t texLen = readU32(offset);
-            if (offset + texLen + 1 > data.size()) throw std::runtime_error("Invalid texture payload");
+            if (offset >= size || texLen > size - offset - 1) throw std::runtime_error("Invalid texture payload");
             uint8_t texType = data[offset++]; // placeholder, currently ignored
             (void)texType;
-            std::vector<uint8_t> payload(data.begin() + offset, data.begin() + offset + texLen);
+            payloads.push_back({data + offset, texLen});
             offset += texLen;
-            if constexpr (requires(std::shared_ptr<T> p) { p->textureSlots; }) {
-                auto shallow = ::nicxlive::core::ShallowTexture(payload);
-                auto tex = std::make_shared<::nicxlive::core::Texture>(shallow);
-                if (puppet->textureSlots.size() <= i) {
-                    puppet->textureSlots.resize(static_cast<std::size_t>(i) + 1);
-                }
-                puppet->textureSlots[static_cast<std::size_t>(i)] = tex;
-            }
+        }
+        if constexpr (requires(std::shared_ptr<T> p) { p->textureSlots; }) {
+            if (puppet->textureSlots.size() < payloads.size()) puppet->textureSlots.resize(payloads.size());
+            auto slots = ::nicxlive::core::inLoadTextureSlots(payloads, options.deferTextureDecode);
+            std::move(slots.begin(), slots.end(), puppet->textureSlots.begin());
         }
     }
 
     // EXT section
-    if (offset + EXT_SECTION.size() <= data.size() &&
-        std::equal(EXT_SECTION.begin(), EXT_SECTION.end(), data.begin() + offset)) {
+    if (atSection(offset, EXT_SECTION)) {
         offset += EXT_SECTION.size();
         uint32_t extCount = readU32(offset);
         for (uint32_t i = 0; i < extCount; ++i) {
             uint32_t nameLen = readU32(offset);
-            if (offset + nameLen > data.size()) throw std::runtime_error("Invalid ext name length");
-            std::string name(reinterpret_cast<const char*>(data.data() + offset), nameLen);
+            if (nameLen > size - offset) throw std::runtime_error("Invalid ext name length");
+            std::string name(reinterpret_cast<const char*>(data + offset), nameLen);
             offset += nameLen;
             uint32_t payloadLen = readU32(offset);
-            if (offset + payloadLen > data.size()) throw std::runtime_error("Invalid ext payload length");
-            std::vector<uint8_t> payload(data.begin() + offset, data.begin() + offset + payloadLen);
-            offset += payloadLen;
+            if (payloadLen > size - offset) throw std::runtime_error("Invalid ext payload length");
             if constexpr (requires(std::shared_ptr<T> p) { p->extData; }) {
-                puppet->extData[name] = payload;
+                puppet->extData[name].assign(data + offset, data + offset + payloadLen);
             }
+            offset += payloadLen;
         }
     }
 
@@ -138,20 +177,34 @@ std::shared_ptr<T> inLoadPuppetFromMemory(const std::vector<uint8_t>& data) {
 }
 
 template <typename T>
-std::shared_ptr<T> inLoadPuppet(const std::string& file) {
-    std::ifstream ifs(file, std::ios::binary);
-    if (!ifs) {
-        throw std::runtime_error("Failed to open puppet file: " + file);
-    }
-    std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+std::shared_ptr<T> inLoadPuppetFromMemory(const std::vector<uint8_t>& data, const PuppetLoadOptions& options = {}) {
+    return inLoadPuppetFromMemory<T>(data.data(), data.size(), options);
+}
+
+// Maps and validates a puppet file; the bytes go to inLoadPuppetFromMemory.
+inline MappedFile inReadPuppetFile(const std::string& file) {
     const auto ext = std::filesystem::path(file).extension().string();
-    if (ext == ".inp" || ext == ".inx") {
-        if (!inVerifyMagicBytes(buffer)) {
-            throw std::runtime_error("Invalid data format for INP/INX puppet");
+    if (ext == ".nicxc") {
+        MappedFile mapped(file);
+        if (!inVerifyPuppetCacheMagic(mapped.data(), mapped.size())) {
+            throw std::runtime_error("Invalid data format for puppet cache");
         }
-        return inLoadPuppetFromMemory<T>(buffer);
+        return mapped;
     }
-    throw std::runtime_error("Invalid file format for puppet: " + ext);
+    if (ext != ".inp" && ext != ".inx") {
+        throw std::runtime_error("Invalid file format for puppet: " + ext);
+    }
+    MappedFile mapped(file);
+    if (!inVerifyMagicBytes(mapped.data(), mapped.size())) {
+        throw std::runtime_error("Invalid data format for INP/INX puppet");
+    }
+    return mapped;
+}
+
+template <typename T>
+std::shared_ptr<T> inLoadPuppet(const std::string& file, const PuppetLoadOptions& options = {}) {
+    const auto mapped = inReadPuppetFile(file);
+    return inLoadPuppetFromMemory<T>(mapped.data(), mapped.size(), options);
 }
 
 inline std::vector<uint8_t> inWriteINPPuppetMemory(const class Puppet& p) {
@@ -178,6 +231,15 @@ inline std::vector<uint8_t> inWriteINPPuppetMemory(const class Puppet& p) {
     uint32_t slotCount = static_cast<uint32_t>(p.textureSlots.size());
     appendU32(slotCount);
     for (auto& tex : p.textureSlots) {
+        // A deferred slot that was never decoded (or dropped its pixels) still has its payload.
+        if (tex && tex->data().empty() && tex->hasEncodedSource()) {
+            const auto& encoded = tex->encodedData();
+            const bool png = encoded.size() >= 4 && encoded[0] == 0x89 && encoded[1] == 'P' && encoded[2] == 'N' && encoded[3] == 'G';
+            appendU32(static_cast<uint32_t>(encoded.size()));
+            app.push_back(png ? 0 : 1); // IN_TEX_PNG / IN_TEX_TGA
+            app.insert(app.end(), encoded.begin(), encoded.end());
+            continue;
+        }
         // length
         if (!tex || tex->data().empty()) {
             appendU32(0);
@@ -215,3 +277,6 @@ inline void inWriteINPPuppet(const class Puppet& p, const std::string& file) {
 }
 
 } // namespace nicxlive::core::fmt
+
+#include "cache.hpp"
+#include "instance.hpp"
@@ -0,0 +1,79 @@
+#pragma once
+
+// Puppet instancing: many live puppets built from one loaded template. An instance is
+// deserialized from the template's PuppetInstanceModel, so it gets its own nodes, parameters,
+// deformation buffers, transforms and physics state, while the immutable model data stays shared:
+//   - node MeshData and binding keyframe grids (copy-on-write, see Drawable::mutableMesh and
+//     KeyframeGrid),
+//   - texture slots (the same Texture objects, so a renderer uploads them once),
+//   - MeshGroup bit masks; triangle offset matrices and PathDeformer closest-point caches are
+//     copied from the template instead of being computed again.
+
+#include "fmt.hpp"
+#include "../nodes/mesh_group.hpp"
+#include "../nodes/path_deformer.hpp"
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace nicxlive::core::fmt {
+
+// Hands the template's MeshGroup and PathDeformer precalculation to the matching nodes (by uuid)
+// of an instance; its first build keeps it. Nodes whose mesh no longer fits are left alone.
+inline void inAdoptInstancePrecalculation(const std::shared_ptr<nodes::Node>& templateRoot,
+                                          const std::shared_ptr<nodes::Node>& root) {
+    if (!templateRoot || !root) return;
+    std::unordered_map<uint32_t, std::shared_ptr<nodes::Node>> templateNodes;
+    auto index = [&](const std::shared_ptr<nodes::Node>& node, const auto& self) -> void {
+        if (!node) return;
+        templateNodes.try_emplace(node->uuid, node);
+        for (const auto& child : node->childrenRef()) self(child, self);
+    };
+    index(templateRoot, index);
+
+    auto adopt = [&](const std::shared_ptr<nodes::Node>& node, const auto& self) -> void {
+        if (!node) return;
+        auto it = templateNodes.find(node->uuid);
+        if (it != templateNodes.end()) {
+            if (auto group = std::dynamic_pointer_cast<nodes::MeshGroup>(node)) {
+                auto source = std::dynamic_pointer_cast<nodes::MeshGroup>(it->second);
+                if (source && source->precalculated && source->bitMask) {
+                    group->adoptPrecalculation(source->bounds, source->triangles, source->bitMask);
+                }
+            } else if (auto path = std::dynamic_pointer_cast<nodes::PathDeformer>(node)) {
+                if (auto source = std::dynamic_pointer_cast<nodes::PathDeformer>(it->second)) {
+                    for (const auto& [target, points] : source->meshCaches) {
+                        if (target) path->adoptedClosestPoints[target->uuid] = points;
+                    }
+                }
+            }
+        }
+        for (const auto& child : node->childrenRef()) self(child, self);
+    };
+    adopt(root, adopt);
+}
+
+// Builds a new puppet from a loaded one without reading or parsing its file again. The template
+// must come from one of the loaders (it needs its instanceModel) and must not be modified while
+// this runs. The result still has to be built like a freshly loaded puppet.
+template <typename T>
+std::shared_ptr<T> inInstantiatePuppet(const T& templ) {
+    if (!templ.instanceModel) throw std::runtime_error("Puppet has no instance model");
+    const auto& model = *templ.instanceModel;
+    inpModeFlag() = model.inpMode;
+
+    std::shared_ptr<T> puppet;
+    {
+        ScopedPuppetInstanceTemplate scope(templ);
+        serde::JsonDocument document(model.nodes.data(), model.nodes.size(), model.strings);
+        puppet = IDeserializable<T>::deserialize(document.root());
+    }
+    puppet->instanceModel = templ.instanceModel;
+    puppet->textureSlots = templ.textureSlots;
+    puppet->extData = templ.extData;
+    inAdoptInstancePrecalculation(templ.root, puppet->root);
+    return puppet;
+}
+
+} // namespace nicxlive::core::fmt
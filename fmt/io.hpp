@@ -3,9 +3,27 @@
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NICXLIVE_FMT_HAS_MMAP 1
+#endif
+
 namespace nicxlive::core::fmt {
 
 // Minimal big-endian file helpers mirroring fmt/io.d
@@ -56,4 +74,108 @@ inline void skip(std::ifstream& file, std::ptrdiff_t length) {
     file.seekg(length, std::ios::cur);
 }
 
+// Read-only view of a whole file. Memory-mapped where the platform has it (pages come straight
+// from the page cache and are never copied into the heap); read into memory otherwise (WASM).
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& file) {
+#if defined(_WIN32)
+        const int wideLen = MultiByteToWideChar(CP_UTF8, 0, file.c_str(), -1, nullptr, 0);
+        std::wstring wide(static_cast<std::size_t>(wideLen > 0 ? wideLen : 1), L'\0');
+        if (wideLen > 0) MultiByteToWideChar(CP_UTF8, 0, file.c_str(), -1, wide.data(), wideLen);
+        HANDLE fileHandle = CreateFileW(wide.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) throw std::runtime_error("Failed to open file: " + file);
+        LARGE_INTEGER length{};
+        if (!GetFileSizeEx(fileHandle, &length)) {
+            CloseHandle(fileHandle);
+            throw std::runtime_error("Failed to stat file: " + file);
+        }
+        size_ = static_cast<std::size_t>(length.QuadPart);
+        if (size_) {
+            mapping_ = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_) view_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0);
+        }
+        CloseHandle(fileHandle);
+        if (size_ && !view_) {
+            release();
+            throw std::runtime_error("Failed to map file: " + file);
+        }
+        data_ = static_cast<const uint8_t*>(view_);
+#elif defined(NICXLIVE_FMT_HAS_MMAP)
+        const int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Failed to open file: " + file);
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat file: " + file);
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_) {
+            void* view = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Failed to map file: " + file);
+            }
+            view_ = view;
+            ::madvise(view_, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+        data_ = static_cast<const uint8_t*>(view_);
+#else
+        std::ifstream ifs(file, std::ios::binary | std::ios::ate);
+        if (!ifs) throw std::runtime_error("Failed to open file: " + file);
+        buffer_.resize(static_cast<std::size_t>(ifs.tellg()));
+        ifs.seekg(0);
+        ifs.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+    MappedFile(MappedFile&& rhs) noexcept { swap(rhs); }
+    MappedFile& operator=(MappedFile&& rhs) noexcept {
+        MappedFile(std::move(rhs)).swap(*this);
+        return *this;
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { release(); }
+
+    const uint8_t* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    void swap(MappedFile& rhs) noexcept {
+        std::swap(data_, rhs.data_);
+        std::swap(size_, rhs.size_);
+        std::swap(view_, rhs.view_);
+#if defined(_WIN32)
+        std::swap(mapping_, rhs.mapping_);
+#endif
+        buffer_.swap(rhs.buffer_);
+    }
+
+    void release() {
+#if defined(_WIN32)
+        if (view_) UnmapViewOfFile(view_);
+        if (mapping_) CloseHandle(mapping_);
+        mapping_ = nullptr;
+#elif defined(NICXLIVE_FMT_HAS_MMAP)
+        if (view_) ::munmap(view_, size_);
+#endif
+        view_ = nullptr;
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const uint8_t* data_{nullptr};
+    std::size_t size_{0};
+    void* view_{nullptr};
+#if defined(_WIN32)
+    HANDLE mapping_{nullptr};
+#endif
+    std::vector<uint8_t> buffer_{};
+};
+
 } // namespace nicxlive::core::fmt
@@ -5,6 +5,7 @@
 #include <boost/property_tree/ptree.hpp>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <type_traits>
 
@@ -43,7 +44,7 @@ struct IDeserializable {
 };
 
 template <typename T>
-inline std::shared_ptr<T> inLoadJsonDataFromMemory(const std::string& data);
+inline std::shared_ptr<T> inLoadJsonDataFromMemory(std::string_view data);
 
 template <typename T>
 inline std::shared_ptr<T> inLoadJsonData(const std::string& file) {
@@ -54,11 +55,9 @@ inline std::shared_ptr<T> inLoadJsonData(const std::string& file) {
 }
 
 template <typename T>
-inline std::shared_ptr<T> inLoadJsonDataFromMemory(const std::string& data) {
-    std::stringstream ss(data);
-    boost::property_tree::ptree pt;
-    boost::property_tree::read_json(ss, pt);
-    return IDeserializable<T>::deserialize(pt);
+inline std::shared_ptr<T> inLoadJsonDataFromMemory(std::string_view data) {
+    serde::JsonDocument document(data);
+    return IDeserializable<T>::deserialize(document.root());
 }
 
 template <typename T>
@@ -0,0 +1,245 @@
+// The checks below drive the parser through assert(); keep them active in Release builds.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "../core/json.hpp"
+#include "../fmt/fmt.hpp"
+#include "puppet_fixture.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using nicxlive::core::serde::JsonDocument;
+using nicxlive::core::serde::JsonError;
+using nicxlive::core::serde::JsonFlatNode;
+using nicxlive::core::serde::JsonValue;
+
+namespace {
+
+// Same shape and the same scalar text as the ptree the deserializers used to read.
+void checkMatchesPtree(const JsonValue& value, const boost::property_tree::ptree& tree) {
+    if (value.isContainer()) {
+        assert(tree.data().empty());
+    } else {
+        assert(value.text() == tree.data());
+    }
+    assert(value.size() == tree.size());
+    auto it = tree.begin();
+    for (const auto& child : value) {
+        assert(child.first == it->first);
+        checkMatchesPtree(child.second, it->second);
+        ++it;
+    }
+}
+
+boost::property_tree::ptree readPtree(const std::string& text) {
+    std::istringstream is(text);
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(is, tree);
+    return tree;
+}
+
+void testMatchesPtree() {
+    const std::string text =
+        "{\"a\":1,\"b\":-2.5e-3,\"s\":\"x\\\"y\\\\z\\n\\u00e9\\ud83d\\ude00\",\"t\":true,\"f\":false,\"n\":null,"
+        "\"arr\":[1,[2,3],{\"k\":\"v\"},[]],\"obj\":{},\"dup\":1,\"dup\":2}";
+    JsonDocument doc(text);
+    checkMatchesPtree(doc.root(), readPtree(text));
+
+    const auto puppet = nicxlive::tests::makePuppetJson(32, 8, 2);
+    JsonDocument puppetDoc(puppet);
+    checkMatchesPtree(puppetDoc.root(), readPtree(puppet));
+}
+
+void testAccessors() {
+    JsonDocument doc(R"({"i":42,"f":1.5,"neg":-1,"b":true,"one":1,"s":"12","nested":{"x":{"y":7}},"list":[0.25,1,2e1]})");
+    const auto& root = doc.root();
+    assert(root.get<int>("i") == 42);
+    assert(root.get<float>("f") == 1.5f);
+    assert(root.get<float>("s") == 12.0f);
+    assert(root.get<bool>("b") && root.get<bool>("one"));
+    assert(root.get<int>("nested.x.y") == 7);
+    assert(root.get_child_optional("nested.x") && !root.get_child_optional("nested.z"));
+    // Integer reads need the whole text; unsigned reads wrap negatives like stream extraction.
+    assert(!root.get_optional<int>("f"));
+    assert(root.get<uint32_t>("neg") == 0xFFFFFFFFu);
+    assert(root.get<int>("missing", 3) == 3);
+    assert(root.get<std::string>("f") == "1.5");
+    assert(root.find("list") != root.not_found() && root.count("i") == 1);
+    std::vector<float> floats;
+    root.get_child("list").readFloats(floats);
+    assert((floats == std::vector<float>{0.25f, 1.0f, 20.0f}));
+
+    bool threw = false;
+    try {
+        root.get<float>("nested");
+    } catch (const JsonError&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+void testRejectsMalformedInput() {
+    const char* broken[] = {"", "{", "[1,]", "{\"a\" 1}", "{\"a\":01x}", "[1 2]", "\"open", "[tru]", "{} {}", "[\"\\q\"]"};
+    for (const char* text : broken) {
+        bool threw = false;
+        try {
+            JsonDocument doc(text);
+        } catch (const JsonError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+}
+
+void checkSameValue(const JsonValue& a, const JsonValue& b) {
+    assert(a.kind() == b.kind() && a.text() == b.text() && a.size() == b.size());
+    auto it = b.begin();
+    for (const auto& child : a) {
+        assert(child.first == it->first);
+        checkSameValue(child.second, it->second);
+        ++it;
+    }
+}
+
+void testFlattenRoundTrip() {
+    const auto puppet = nicxlive::tests::makePuppetJson(32, 8, 2);
+    JsonDocument doc(puppet);
+    std::vector<JsonFlatNode> nodes;
+    std::string strings;
+    doc.flatten(nodes, strings);
+    JsonDocument rebuilt(nodes.data(), nodes.size(), strings);
+    checkSameValue(doc.root(), rebuilt.root());
+    // Repeated keys and short scalars are stored once.
+    assert(strings.size() < puppet.size() / 2);
+
+    // Children that point back at their parent, or past the table, are rejected.
+    for (uint32_t firstChild : {0u, static_cast<uint32_t>(nodes.size())}) {
+        auto broken = nodes;
+        broken[0].firstChild = firstChild;
+        bool threw = false;
+        try {
+            JsonDocument bad(broken.data(), broken.size(), strings);
+        } catch (const JsonError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+}
+
+// A puppet dominated by large numeric arrays: every part carries a dense mesh and a deform binding.
+std::string makeHeavyPuppetJson(std::size_t partCount, std::size_t vertsPerPart) {
+    std::ostringstream os;
+    os << "{\"meta\":{\"preservePixels\":false},\"nodes\":{\"type\":\"Node\",\"uuid\":1,\"name\":\"Root\",\"children\":[";
+    for (std::size_t i = 0; i < partCount; ++i) {
+        if (i) os << ",";
+        os << "{\"type\":\"Part\",\"uuid\":" << (100 + i) << ",\"name\":\"part" << i << "\",\"mesh\":{\"verts\":[";
+        for (std::size_t v = 0; v < vertsPerPart; ++v) {
+            if (v) os << ",";
+            os << (static_cast<float>(v) * 0.37f + static_cast<float>(i)) << "," << (static_cast<float>(v) * -1.13f);
+        }
+        os << "],\"uvs\":[";
+        for (std::size_t v = 0; v < vertsPerPart; ++v) {
+            if (v) os << ",";
+            os << (static_cast<float>(v) / static_cast<float>(vertsPerPart)) << ",0.5";
+        }
+        os << "],\"indices\":[";
+        for (std::size_t t = 0; t + 2 < vertsPerPart; ++t) {
+            if (t) os << ",";
+            os << 0 << "," << (t + 1) << "," << (t + 2);
+        }
+        os << "],\"origin\":[0,0]},\"opacity\":1,\"blend_mode\":\"Normal\"}";
+    }
+    os << "]},\"param\":[{\"uuid\":9000,\"name\":\"Deform\",\"is_vec2\":false,\"min\":[0,0],\"max\":[1,0],"
+       << "\"defaults\":[0,0],\"axis_points\":[[0,1],[0]],\"bindings\":[";
+    for (std::size_t i = 0; i < partCount; ++i) {
+        if (i) os << ",";
+        os << "{\"node\":" << (100 + i) << ",\"param_name\":\"deform\",\"values\":[";
+        for (int key = 0; key < 2; ++key) {
+            if (key) os << ",";
+            os << "[[";
+            for (std::size_t v = 0; v < vertsPerPart; ++v) {
+                if (v) os << ",";
+                os << "[" << (static_cast<float>(key * v) * 0.01f) << "," << (static_cast<float>(key) * 0.5f) << "]";
+            }
+            os << "]]";
+        }
+        os << "],\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+    }
+    os << "]}]}";
+    return os.str();
+}
+
+double sumFloats(const boost::property_tree::ptree& tree) {
+    double sum = 0.0;
+    for (const auto& child : tree) {
+        if (child.second.empty()) {
+            if (auto v = child.second.get_value_optional<float>()) sum += *v;
+        } else {
+            sum += sumFloats(child.second);
+        }
+    }
+    return sum;
+}
+
+double sumFloats(const JsonValue& value) {
+    double sum = 0.0;
+    for (const auto& child : value) {
+        if (child.second.isContainer()) {
+            sum += sumFloats(child.second);
+        } else if (auto v = child.second.get_value_optional<float>()) {
+            sum += *v;
+        }
+    }
+    return sum;
+}
+
+template <typename F>
+double bestOf(int runs, F&& body) {
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+// Parse + read every number, ptree vs JsonDocument, then the whole puppet load on the new path.
+void benchmarkPuppetJson() {
+    const auto text = makeHeavyPuppetJson(200, 512);
+    double ptreeSum = 0.0;
+    double docSum = 0.0;
+    const double ptreeMs = bestOf(1, [&] { ptreeSum = sumFloats(readPtree(text)); });
+    const double docMs = bestOf(3, [&] {
+        JsonDocument doc(text);
+        docSum = sumFloats(doc.root());
+    });
+    assert(ptreeSum == docSum);
+
+    std::shared_ptr<nicxlive::core::Puppet> puppet;
+    const double loadMs = bestOf(3, [&] { puppet = nicxlive::core::fmt::inLoadJSONPuppet<nicxlive::core::Puppet>(text); });
+    assert(puppet);
+    std::printf("[json_test] %.1f MiB puppet JSON: ptree parse+read %.1fms, JsonDocument parse+read %.1fms (%.1fx), "
+                "full load %.1fms\n",
+                static_cast<double>(text.size()) / (1024.0 * 1024.0), ptreeMs, docMs, ptreeMs / docMs, loadMs);
+}
+
+} // namespace
+
+int main() {
+    testMatchesPtree();
+    testAccessors();
+    testRejectsMalformedInput();
+    testFlattenRoundTrip();
+    benchmarkPuppetJson();
+    return 0;
+}
@@ -0,0 +1,313 @@
+// The checks below drive the cache through assert(); keep them active in Release builds.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "../fmt/fmt.hpp"
+#include "puppet_fixture.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using nicxlive::core::Puppet;
+using nicxlive::core::fmt::inLoadPuppet;
+using nicxlive::core::fmt::inInstantiatePuppet;
+using nicxlive::core::fmt::inLoadPuppetFromMemory;
+using nicxlive::core::fmt::inPuppetCacheMatches;
+using nicxlive::core::fmt::inWritePuppetCache;
+using nicxlive::core::fmt::inWritePuppetCacheMemory;
+using nicxlive::core::fmt::PuppetCacheOptions;
+using nicxlive::core::nodes::MeshGroup;
+using nicxlive::core::nodes::Node;
+using nicxlive::core::nodes::Part;
+using nicxlive::core::nodes::PathDeformer;
+
+namespace {
+
+// A cols x rows grid of quads spanning `width` x `height` from (x, y).
+void appendGridMesh(std::ostringstream& os, int cols, int rows, float x, float y, float width, float height) {
+    os << "\"mesh\":{\"verts\":[";
+    for (int r = 0; r <= rows; ++r) {
+        for (int c = 0; c <= cols; ++c) {
+            if (r || c) os << ",";
+            os << (x + width * static_cast<float>(c) / static_cast<float>(cols)) << ","
+               << (y + height * static_cast<float>(r) / static_cast<float>(rows));
+        }
+    }
+    os << "],\"uvs\":[";
+    for (int r = 0; r <= rows; ++r) {
+        for (int c = 0; c <= cols; ++c) {
+            if (r || c) os << ",";
+            os << (static_cast<float>(c) / static_cast<float>(cols)) << "," << (static_cast<float>(r) / static_cast<float>(rows));
+        }
+    }
+    os << "],\"indices\":[";
+    bool first = true;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            const int i = r * (cols + 1) + c;
+            if (!first) os << ",";
+            first = false;
+            os << i << "," << (i + 1) << "," << (i + cols + 1) << "," << (i + 1) << "," << (i + cols + 2) << "," << (i + cols + 1);
+        }
+    }
+    os << "],\"origin\":[0,0]}";
+}
+
+// Root with a dense MeshGroup over `groupParts` parts, a PathDeformer over `pathParts` parts, one
+// parameter, `textureCount` PNG slots of `textureSize` pixels and one EXT entry.
+std::string makeCachePuppetBytes(int groupParts, int pathParts, int textureCount, int textureSize) {
+    std::ostringstream os;
+    os << "{\"meta\":{\"preservePixels\":false},\"nodes\":{\"type\":\"Node\",\"uuid\":1,\"name\":\"Root\",\"children\":["
+       << "{\"type\":\"MeshGroup\",\"uuid\":10,\"name\":\"Group\",";
+    appendGridMesh(os, 40, 40, 0.0f, 0.0f, 800.0f, 800.0f);
+    os << ",\"children\":[";
+    for (int i = 0; i < groupParts; ++i) {
+        if (i) os << ",";
+        os << "{\"type\":\"Part\",\"uuid\":" << (100 + i) << ",\"name\":\"g" << i << "\",\"textures\":[" << (i % textureCount) << "],";
+        appendGridMesh(os, 8, 8, 20.0f * static_cast<float>(i), 10.0f, 300.0f, 300.0f);
+        os << "}";
+    }
+    os << "]},{\"type\":\"PathDeformer\",\"uuid\":20,\"name\":\"Path\",\"vertices\":[0,0,40,200,-40,400,0,600],\"children\":[";
+    for (int i = 0; i < pathParts; ++i) {
+        if (i) os << ",";
+        os << "{\"type\":\"Part\",\"uuid\":" << (300 + i) << ",\"name\":\"p" << i << "\",\"textures\":[" << (i % textureCount) << "],";
+        appendGridMesh(os, 16, 16, -100.0f + 10.0f * static_cast<float>(i), 0.0f, 200.0f, 600.0f);
+        os << "}";
+    }
+    os << "]}]},\"param\":[{\"uuid\":9000,\"name\":\"MoveX\",\"is_vec2\":false,\"min\":[0,0],\"max\":[1,0],\"defaults\":[0,0],"
+       << "\"axis_points\":[[0,1],[0]],\"bindings\":[{\"node\":100,\"param_name\":\"transform.t.x\",\"values\":[[0],[10]],"
+       << "\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}]}]}";
+    const std::string json = os.str();
+
+    std::string bytes("TRNSRTS\0", 8);
+    auto putU32 = [&](uint32_t v) {
+        for (int shift = 24; shift >= 0; shift -= 8) bytes.push_back(static_cast<char>((v >> shift) & 0xFF));
+    };
+    putU32(static_cast<uint32_t>(json.size()));
+    bytes += json;
+    std::vector<std::string> payloads;
+    for (int i = 0; i < textureCount; ++i) payloads.push_back(nicxlive::tests::makePngImage(textureSize, static_cast<std::size_t>(i)));
+    nicxlive::tests::appendTextureSection(bytes, payloads);
+    bytes.append("EXT_SECT", 8);
+    putU32(1);
+    putU32(4);
+    bytes += "info";
+    putU32(3);
+    bytes += "abc";
+    return bytes;
+}
+
+std::string writeFile(const std::string& name, const void* data, std::size_t size) {
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    return path;
+}
+
+std::shared_ptr<Puppet> build(std::shared_ptr<Puppet> puppet) {
+    puppet->rescanNodes();
+    puppet->actualRoot()->build(true);
+    return puppet;
+}
+
+template <typename T>
+std::shared_ptr<T> findNode(const std::shared_ptr<Node>& node, uint32_t uuid) {
+    if (!node) return nullptr;
+    if (node->uuid == uuid) return std::dynamic_pointer_cast<T>(node);
+    for (const auto& child : node->childrenRef()) {
+        if (auto found = findNode<T>(child, uuid)) return found;
+    }
+    return nullptr;
+}
+
+std::size_t countNodes(const std::shared_ptr<Node>& node) {
+    std::size_t n = node ? 1 : 0;
+    if (node) {
+        for (const auto& child : node->childrenRef()) n += countNodes(child);
+    }
+    return n;
+}
+
+void checkSamePuppet(Puppet& expected, Puppet& actual) {
+    assert(countNodes(expected.actualRoot()) == countNodes(actual.actualRoot()));
+    assert(expected.parameters.size() == actual.parameters.size());
+    assert(expected.extData == actual.extData);
+
+    assert(expected.textureSlots.size() == actual.textureSlots.size());
+    for (std::size_t i = 0; i < expected.textureSlots.size(); ++i) {
+        const auto& a = expected.textureSlots[i];
+        const auto& b = actual.textureSlots[i];
+        assert(a && b);
+        assert(a->width() == b->width() && a->height() == b->height() && a->channels() == b->channels());
+        assert(a->data() == b->data());
+    }
+
+    auto groupA = findNode<MeshGroup>(expected.actualRoot(), 10);
+    auto groupB = findNode<MeshGroup>(actual.actualRoot(), 10);
+    assert(groupA && groupB && groupA->precalculated && groupB->precalculated);
+    assert(groupA->bitMask && groupB->bitMask && *groupA->bitMask == *groupB->bitMask);
+    assert(groupA->bounds.x == groupB->bounds.x && groupA->bounds.w == groupB->bounds.w);
+    assert(groupA->triangles.size() == groupB->triangles.size());
+    for (std::size_t t = 0; t < groupA->triangles.size(); ++t) {
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                assert(groupA->triangles[t].offsetMatrices.m[r][c] == groupB->triangles[t].offsetMatrices.m[r][c]);
+            }
+        }
+    }
+
+    auto pathA = findNode<PathDeformer>(expected.actualRoot(), 20);
+    auto pathB = findNode<PathDeformer>(actual.actualRoot(), 20);
+    assert(pathA && pathB);
+    assert(!pathA->meshCaches.empty() && pathA->meshCaches.size() == pathB->meshCaches.size());
+    for (const auto& [target, points] : pathA->meshCaches) {
+        const auto counterpart = findNode<Node>(actual.actualRoot(), target->uuid);
+        assert(counterpart);
+        const auto it = pathB->meshCaches.find(counterpart.get());
+        assert(it != pathB->meshCaches.end() && it->second == points);
+    }
+}
+
+void testRoundTrip() {
+    const auto source = makeCachePuppetBytes(4, 3, 2, 64);
+    const auto* sourceData = reinterpret_cast<const uint8_t*>(source.data());
+    for (bool keepEncoded : {false, true}) {
+        PuppetCacheOptions options;
+        options.keepEncodedTextures = keepEncoded;
+        const auto cache = inWritePuppetCacheMemory(sourceData, source.size(), options);
+        assert(inPuppetCacheMatches(cache.data(), cache.size(), sourceData, source.size()));
+
+        auto expected = build(inLoadPuppetFromMemory<Puppet>(sourceData, source.size()));
+        auto loaded = inLoadPuppetFromMemory<Puppet>(cache.data(), cache.size());
+        // The precalculation comes from the cache, before any build.
+        assert(findNode<MeshGroup>(loaded->actualRoot(), 10)->precalculated);
+        assert(!findNode<PathDeformer>(loaded->actualRoot(), 20)->adoptedClosestPoints.empty());
+        auto actual = build(loaded);
+        assert(findNode<PathDeformer>(actual->actualRoot(), 20)->adoptedClosestPoints.empty());
+        checkSamePuppet(*expected, *actual);
+    }
+
+    // A changed source no longer matches; a damaged cache is rejected instead of read.
+    auto changed = source;
+    changed[changed.size() - 1] = 'x';
+    const auto cache = inWritePuppetCacheMemory(sourceData, source.size());
+    assert(!inPuppetCacheMatches(cache.data(), cache.size(), reinterpret_cast<const uint8_t*>(changed.data()), changed.size()));
+    for (std::size_t cut : {std::size_t{16}, cache.size() / 2}) {
+        bool threw = false;
+        try {
+            inLoadPuppetFromMemory<Puppet>(cache.data(), cut);
+        } catch (const std::exception&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    auto otherVersion = cache;
+    otherVersion[8] ^= 0xFF;
+    bool threw = false;
+    try {
+        inLoadPuppetFromMemory<Puppet>(otherVersion.data(), otherVersion.size());
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+// Instances match their template, share its immutable data and animate on their own.
+void testInstances() {
+    const auto source = makeCachePuppetBytes(4, 3, 2, 64);
+    const auto* sourceData = reinterpret_cast<const uint8_t*>(source.data());
+    const auto cache = inWritePuppetCacheMemory(sourceData, source.size());
+    auto fromSource = build(inLoadPuppetFromMemory<Puppet>(sourceData, source.size()));
+    auto fromCache = build(inLoadPuppetFromMemory<Puppet>(cache.data(), cache.size()));
+    for (auto* templ : {fromSource.get(), fromCache.get()}) {
+        assert(templ->instanceModel);
+        auto a = build(inInstantiatePuppet(*templ));
+        auto b = build(inInstantiatePuppet(*templ));
+        checkSamePuppet(*templ, *a);
+        checkSamePuppet(*templ, *b);
+
+        for (uint32_t uuid : {10u, 100u, 300u}) {
+            const auto mesh = findNode<nicxlive::core::nodes::Drawable>(templ->actualRoot(), uuid)->mesh;
+            assert(findNode<nicxlive::core::nodes::Drawable>(a->actualRoot(), uuid)->mesh == mesh);
+            assert(findNode<nicxlive::core::nodes::Drawable>(b->actualRoot(), uuid)->mesh == mesh);
+        }
+        for (std::size_t i = 0; i < templ->textureSlots.size(); ++i) assert(a->textureSlots[i] == templ->textureSlots[i]);
+        assert(findNode<MeshGroup>(a->actualRoot(), 10)->bitMask == findNode<MeshGroup>(templ->actualRoot(), 10)->bitMask);
+        const auto& binding = templ->parameters[0]->bindingMap.begin()->second;
+        assert(binding->sharesValuesWith(*a->parameters[0]->bindingMap.begin()->second));
+
+        // Parameters and node state belong to each instance.
+        a->parameters[0]->value.x = 1.0f;
+        a->update();
+        b->update();
+        templ->update();
+        const auto moved = findNode<Part>(a->actualRoot(), 100)->offsetTransform.translation.x;
+        assert(moved != findNode<Part>(b->actualRoot(), 100)->offsetTransform.translation.x);
+        assert(findNode<Part>(b->actualRoot(), 100)->offsetTransform.translation.x ==
+               findNode<Part>(templ->actualRoot(), 100)->offsetTransform.translation.x);
+    }
+
+    // Puppets built in code have no model to instance from.
+    bool threw = false;
+    try {
+        inInstantiatePuppet(Puppet{});
+    } catch (const std::exception&) {
+        threw = true;
+    }
+    assert(threw);
+}
+
+template <typename F>
+double bestOf(int runs, F&& body) {
+    double best = 1e30;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+// File to built puppet: INP/INX (parse JSON, decode PNGs, precalculate) against the cache.
+void benchmarkColdLoad() {
+    const auto source = makeCachePuppetBytes(24, 16, 8, 1024);
+    const auto inpPath = writeFile("nicxlive_cache_bench.inp", source.data(), source.size());
+    const auto cachePath = (std::filesystem::temp_directory_path() / "nicxlive_cache_bench.nicxc").string();
+    inWritePuppetCache(inpPath, cachePath);
+
+    const double inpMs = bestOf(3, [&] { build(inLoadPuppet<Puppet>(inpPath)); });
+    const double cacheMs = bestOf(3, [&] { build(inLoadPuppet<Puppet>(cachePath)); });
+    std::printf("[puppet_cache_test] %.1f MiB .inp -> %.1f MiB .nicxc: load+build %.1fms -> %.1fms (%.1fx)\n",
+                static_cast<double>(std::filesystem::file_size(inpPath)) / (1024.0 * 1024.0),
+                static_cast<double>(std::filesystem::file_size(cachePath)) / (1024.0 * 1024.0), inpMs, cacheMs, inpMs / cacheMs);
+    std::filesystem::remove(inpPath);
+    std::filesystem::remove(cachePath);
+}
+
+// A second copy of a loaded puppet: a fresh load from memory against an instance of the first.
+void benchmarkInstances() {
+    const auto source = makeCachePuppetBytes(24, 16, 8, 256);
+    const auto* sourceData = reinterpret_cast<const uint8_t*>(source.data());
+    auto templ = build(inLoadPuppetFromMemory<Puppet>(sourceData, source.size()));
+    const double loadMs = bestOf(3, [&] { build(inLoadPuppetFromMemory<Puppet>(sourceData, source.size())); });
+    const double instanceMs = bestOf(3, [&] { build(inInstantiatePuppet(*templ)); });
+    std::printf("[puppet_cache_test] second copy of a loaded puppet: load+build %.1fms, instance+build %.1fms (%.1fx)\n",
+                loadMs, instanceMs, loadMs / instanceMs);
+}
+
+} // namespace
+
+int main() {
+    testRoundTrip();
+    testInstances();
+    benchmarkColdLoad();
+    benchmarkInstances();
+    return 0;
+}
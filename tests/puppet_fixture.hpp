@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace nicxlive::tests {
+
+// Builds a synthetic puppet payload (INP container without textures): a root node with
+// `partCount` quad Parts and one parameter binding each part's translation. With
+// `deformedParts` > 0 the parameter instead deforms the mesh of the first `deformedParts` parts
+// only, leaving the rest of the puppet static. With `textureSlots` > 0 part i draws texture slot
+// i % textureSlots.
+inline std::string makePuppetJson(std::size_t partCount, std::size_t deformedParts = 0, std::size_t textureSlots = 0) {
+    std::ostringstream os;
+    os << "{\"meta\":{\"preservePixels\":false},"
+       << "\"physics\":{\"pixelsPerMeter\":1000,\"gravity\":9.8},"
+       << "\"nodes\":{\"type\":\"Node\",\"uuid\":1,\"name\":\"Root\",\"children\":[";
+    for (std::size_t i = 0; i < partCount; ++i) {
+        const float base = static_cast<float>(i) * 4.0f;
+        if (i) os << ",";
+        os << "{\"type\":\"Part\",\"uuid\":" << (100 + i) << ",\"name\":\"part" << i << "\","
+           << "\"zsort\":" << (static_cast<float>(i) * 0.01f) << ","
+           << "\"mesh\":{\"verts\":[" << base << ",0," << (base + 2) << ",0," << (base + 2) << ",2," << base << ",2],"
+           << "\"uvs\":[0,0,1,0,1,1,0,1],\"indices\":[0,1,2,2,3,0],\"origin\":[0,0]},"
+           << "\"opacity\":1,\"blend_mode\":\"Normal\",\"tint\":\"1,1,1\"";
+        if (textureSlots) os << ",\"textures\":[" << (i % textureSlots) << "]";
+        os << "}";
+    }
+    os << "]},\"param\":[{\"uuid\":9000,\"name\":\"MoveX\",\"is_vec2\":false,"
+       << "\"min\":[0,0],\"max\":[1,0],\"defaults\":[0,0],\"axis_points\":[[0,1],[0]],"
+       << "\"merge_mode\":\"Passthrough\",\"bindings\":[";
+    if (deformedParts) {
+        for (std::size_t i = 0; i < deformedParts && i < partCount; ++i) {
+            if (i) os << ",";
+            os << "{\"node\":" << (100 + i) << ",\"param_name\":\"deform\","
+               << "\"values\":[[[[0,0],[0,0],[0,0],[0,0]]],[[[0,0],[0,0],[1,1],[1,1]]]],"
+               << "\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+        }
+    } else {
+        for (std::size_t i = 0; i < partCount; ++i) {
+            if (i) os << ",";
+            os << "{\"node\":" << (100 + i) << ",\"param_name\":\"transform.t.x\","
+               << "\"values\":[[0],[10]],\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+        }
+    }
+    os << "]}]}";
+    return os.str();
+}
+
+inline std::string makePuppetBytes(std::size_t partCount, std::size_t deformedParts = 0, std::size_t textureSlots = 0) {
+    const std::string json = makePuppetJson(partCount, deformedParts, textureSlots);
+    std::string bytes("TRNSRTS\0", 8);
+    const auto len = static_cast<uint32_t>(json.size());
+    bytes.push_back(static_cast<char>((len >> 24) & 0xFF));
+    bytes.push_back(static_cast<char>((len >> 16) & 0xFF));
+    bytes.push_back(static_cast<char>((len >> 8) & 0xFF));
+    bytes.push_back(static_cast<char>(len & 0xFF));
+    bytes += json;
+    return bytes;
+}
+
+// Uncompressed `size`x`size` RGBA TGA, filled with a colour derived from `seed`.
+inline std::string makeTgaImage(int size, std::size_t seed) {
+    std::string tga(18, '\0');
+    tga[2] = 2;
+    tga[12] = static_cast<char>(size & 0xFF);
+    tga[13] = static_cast<char>((size >> 8) & 0xFF);
+    tga[14] = static_cast<char>(size & 0xFF);
+    tga[15] = static_cast<char>((size >> 8) & 0xFF);
+    tga[16] = 32;
+    tga[17] = 0x28;
+    for (int p = 0; p < size * size; ++p) {
+        tga.push_back(static_cast<char>(seed * 40));
+        tga.push_back(static_cast<char>(255 - seed * 40));
+        tga.push_back(static_cast<char>(p & 0xFF));
+        tga.push_back(static_cast<char>(255));
+    }
+    return tga;
+}
+
+// `size`x`size` RGBA PNG with a gradient pattern derived from `seed`. The deflate stream is a
+// single fixed-Huffman block of literals: valid, and as costly to inflate per byte as real images.
+inline std::string makePngImage(int size, std::size_t seed) {
+    auto crc32 = [](const std::string& bytes, std::size_t begin) {
+        uint32_t crc = 0xFFFFFFFFu;
+        for (std::size_t i = begin; i < bytes.size(); ++i) {
+            crc ^= static_cast<uint8_t>(bytes[i]);
+            for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+        return crc ^ 0xFFFFFFFFu;
+    };
+    auto putU32 = [](std::string& out, uint32_t v) {
+        for (int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<char>((v >> shift) & 0xFF));
+    };
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+    auto chunk = [&](const char* type, const std::string& body) {
+        putU32(png, static_cast<uint32_t>(body.size()));
+        const std::size_t begin = png.size();
+        png.append(type, 4);
+        png += body;
+        putU32(png, crc32(png, begin));
+    };
+
+    std::string ihdr;
+    putU32(ihdr, static_cast<uint32_t>(size));
+    putU32(ihdr, static_cast<uint32_t>(size));
+    ihdr += std::string("\x08\x06\x00\x00\x00", 5); // 8-bit RGBA
+    chunk("IHDR", ihdr);
+
+    // Scanlines with the Sub filter, so decoding also has to unfilter.
+    const std::size_t stride = static_cast<std::size_t>(size) * 4;
+    std::string raw;
+    raw.reserve((stride + 1) * static_cast<std::size_t>(size));
+    std::string row(stride, '\0');
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            row[x * 4 + 0] = static_cast<char>(x + seed * 31);
+            row[x * 4 + 1] = static_cast<char>(y + seed * 17);
+            row[x * 4 + 2] = static_cast<char>((x ^ y) + seed);
+            row[x * 4 + 3] = static_cast<char>(255);
+        }
+        raw.push_back(1);
+        for (std::size_t i = 0; i < stride; ++i) {
+            const uint8_t left = i >= 4 ? static_cast<uint8_t>(row[i - 4]) : 0;
+            raw.push_back(static_cast<char>(static_cast<uint8_t>(row[i]) - left));
+        }
+    }
+
+    std::string zlib("\x78\x01", 2);
+    uint32_t bits = 0;
+    int bitCount = 0;
+    auto putBit = [&](uint32_t bit) {
+        bits |= bit << bitCount;
+        if (++bitCount == 8) {
+            zlib.push_back(static_cast<char>(bits));
+            bits = 0;
+            bitCount = 0;
+        }
+    };
+    auto putCode = [&](uint32_t code, int length) {
+        for (int k = length - 1; k >= 0; --k) putBit((code >> k) & 1u);
+    };
+    putBit(1); // BFINAL
+    putBit(1); // BTYPE = 01 (fixed Huffman), LSB first
+    putBit(0);
+    uint32_t a = 1, b = 0;
+    for (char c : raw) {
+        const auto v = static_cast<uint8_t>(c);
+        if (v < 144) putCode(0x30u + v, 8);
+        else putCode(0x190u + (v - 144u), 9);
+        a = (a + v) % 65521u;
+        b = (b + a) % 65521u;
+    }
+    putCode(0, 7); // end of block
+    while (bitCount) putBit(0);
+    putU32(zlib, (b << 16) | a);
+    chunk("IDAT", zlib);
+    chunk("IEND", std::string());
+    return png;
+}
+
+// Appends a TEX_SECT holding `payloads` (encoded images) in slot order.
+inline void appendTextureSection(std::string& bytes, const std::vector<std::string>& payloads) {
+    auto putU32 = [&](uint32_t v) {
+        for (int shift = 24; shift >= 0; shift -= 8) bytes.push_back(static_cast<char>((v >> shift) & 0xFF));
+    };
+    bytes.append("TEX_SECT", 8);
+    putU32(static_cast<uint32_t>(payloads.size()));
+    for (const auto& payload : payloads) {
+        putU32(static_cast<uint32_t>(payload.size()));
+        bytes.push_back(0); // texture type (ignored by the loader)
+        bytes += payload;
+    }
+}
+
+inline std::string writePuppetFile(const std::string& name, std::size_t partCount, std::size_t deformedParts = 0) {
+    auto path = std::filesystem::temp_directory_path() / (name + ".inp");
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    const auto bytes = makePuppetBytes(partCount, deformedParts);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return path.string();
+}
+
+} // namespace nicxlive::tests
@@ -0,0 +1,117 @@
+// The checks below drive the loader through assert(); keep them active in Release builds.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "../fmt/fmt.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+using nicxlive::core::Puppet;
+using nicxlive::core::fmt::inLoadJSONPuppet;
+using nicxlive::core::nodes::Node;
+using nicxlive::core::nodes::Part;
+
+namespace {
+
+// Root -> `groups` Node groups -> `partsPerGroup` parts each. Every part but the first of a group is
+// masked by its predecessor, and each group has a parameter binding all of its parts, so the load
+// resolves one node reference per part and one per binding.
+std::string makeLayeredPuppetJson(std::size_t groups, std::size_t partsPerGroup) {
+    auto partUuid = [&](std::size_t g, std::size_t p) { return 100000 + g * partsPerGroup + p; };
+    std::ostringstream os;
+    os << "{\"meta\":{\"preservePixels\":false},\"nodes\":{\"type\":\"Node\",\"uuid\":1,\"name\":\"Root\",\"children\":[";
+    for (std::size_t g = 0; g < groups; ++g) {
+        if (g) os << ",";
+        os << "{\"type\":\"Node\",\"uuid\":" << (10 + g) << ",\"name\":\"group" << g << "\",\"children\":[";
+        for (std::size_t p = 0; p < partsPerGroup; ++p) {
+            const float x = static_cast<float>(p) * 2.0f;
+            if (p) os << ",";
+            os << "{\"type\":\"Part\",\"uuid\":" << partUuid(g, p) << ",\"name\":\"part" << p << "\","
+               << "\"mesh\":{\"verts\":[" << x << ",0," << (x + 2) << ",0," << (x + 2) << ",2," << x << ",2],"
+               << "\"uvs\":[0,0,1,0,1,1,0,1],\"indices\":[0,1,2,2,3,0],\"origin\":[0,0]},"
+               << "\"opacity\":1,\"blend_mode\":\"Normal\"";
+            if (p) os << ",\"masks\":[{\"source\":" << partUuid(g, p - 1) << ",\"mode\":\"Mask\"}]";
+            os << "}";
+        }
+        os << "]}";
+    }
+    os << "]},\"param\":[";
+    for (std::size_t g = 0; g < groups; ++g) {
+        if (g) os << ",";
+        os << "{\"uuid\":" << (900000 + g) << ",\"name\":\"Move" << g << "\",\"is_vec2\":false,\"min\":[0,0],\"max\":[1,0],"
+           << "\"defaults\":[0,0],\"axis_points\":[[0,1],[0]],\"bindings\":[";
+        for (std::size_t p = 0; p < partsPerGroup; ++p) {
+            if (p) os << ",";
+            os << "{\"node\":" << partUuid(g, p) << ",\"param_name\":\"transform.t.x\",\"values\":[[0],[10]],"
+               << "\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+        }
+        os << "]}";
+    }
+    os << "]}";
+    return os.str();
+}
+
+std::shared_ptr<Puppet> loadAndBuild(const std::string& json) {
+    auto puppet = inLoadJSONPuppet<Puppet>(json);
+    puppet->rescanNodes();
+    puppet->actualRoot()->build(true);
+    return puppet;
+}
+
+void testReferencesResolve() {
+    constexpr std::size_t kGroups = 6;
+    constexpr std::size_t kParts = 7;
+    auto puppet = loadAndBuild(makeLayeredPuppetJson(kGroups, kParts));
+    assert(puppet->parameters.size() == kGroups);
+    for (std::size_t g = 0; g < kGroups; ++g) {
+        assert(puppet->findNodeById(static_cast<uint32_t>(10 + g)));
+        assert(puppet->findParameterById(static_cast<uint32_t>(900000 + g)) == puppet->parameters[g]);
+        assert(puppet->parameters[g]->bindingMap.size() == kParts);
+        for (std::size_t p = 0; p < kParts; ++p) {
+            const auto uuid = static_cast<uint32_t>(100000 + g * kParts + p);
+            auto part = std::dynamic_pointer_cast<Part>(puppet->findNodeById(uuid));
+            assert(part && part->uuid == uuid);
+            if (p == 0) continue;
+            assert(part->masks.size() == 1 && part->masks[0].maskSrc && part->masks[0].maskSrc->uuid == uuid - 1);
+        }
+    }
+    assert(!puppet->findNodeById(12345));
+    assert(!puppet->findParameterById(12345));
+
+    // Lookups follow the tree after the load, too.
+    auto group = puppet->findNodeById(10);
+    auto added = Node::inInstantiateNode("Node", group);
+    added->uuid = 4242;
+    assert(puppet->findNodeById(4242) == added);
+}
+
+// Load + build time against node count; a linear load keeps the time per node flat.
+void benchmarkLoadScaling() {
+    double perNodeSmall = 0.0;
+    for (std::size_t groups : {25, 50, 100}) {
+        const std::size_t parts = 99;
+        const std::size_t nodeCount = 1 + groups * (parts + 1);
+        const auto json = makeLayeredPuppetJson(groups, parts);
+        const auto start = std::chrono::steady_clock::now();
+        auto puppet = loadAndBuild(json);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        assert(puppet->parameters.size() == groups);
+        const double perNode = ms * 1000.0 / static_cast<double>(nodeCount);
+        if (perNodeSmall == 0.0) perNodeSmall = perNode;
+        std::printf("[puppet_load_test] %zu nodes, %zu bindings: load+build %.1fms (%.2fus/node, %.2fx the smallest)\n",
+                    nodeCount, groups * parts, ms, perNode, perNode / perNodeSmall);
+    }
+}
+
+} // namespace
+
+int main() {
+    testReferencesResolve();
+    benchmarkLoadScaling();
+    return 0;
+}
@@ -0,0 +1,162 @@
+// The checks below drive the pool through assert(); keep them active in Release builds.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "../core/render/backend_queue.hpp"
+#include "../core/texture.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using nicxlive::core::inAcquireRenderTarget;
+using nicxlive::core::inClearRenderTargetPool;
+using nicxlive::core::inReleaseRenderTarget;
+using nicxlive::core::ScopedRenderBackend;
+using nicxlive::core::Texture;
+using nicxlive::core::render::QueueRenderBackend;
+using nicxlive::core::render::TextureCommand;
+using nicxlive::core::render::TextureCommandKind;
+
+namespace {
+
+struct Counts {
+    std::size_t created{0};
+    std::size_t updated{0};
+    std::size_t disposed{0};
+};
+
+Counts drain(QueueRenderBackend& backend) {
+    std::vector<TextureCommand> commands;
+    backend.takeResourceQueue(commands);
+    Counts counts;
+    for (const auto& cmd : commands) {
+        if (cmd.kind == TextureCommandKind::Create) ++counts.created;
+        if (cmd.kind == TextureCommandKind::Update) ++counts.updated;
+        if (cmd.kind == TextureCommandKind::Dispose) ++counts.disposed;
+        assert(!cmd.data);
+    }
+    return counts;
+}
+
+void testRenderTargetHasNoPixels() {
+    auto backend = std::make_shared<QueueRenderBackend>();
+    ScopedRenderBackend scope(backend);
+    auto target = Texture::createRenderTarget(300, 200);
+    assert(target->renderTarget());
+    assert(target->backendId() != 0);
+    assert(target->width() == 300 && target->height() == 200);
+    assert(!target->pixelsResident());
+    assert(target->data().empty());
+    auto counts = drain(*backend);
+    assert(counts.created == 1);
+    target->dispose();
+}
+
+void testResizeWithinClassReusesSurface() {
+    auto backend = std::make_shared<QueueRenderBackend>();
+    ScopedRenderBackend scope(backend);
+    auto target = inAcquireRenderTarget(300, 200);
+    const auto id = target->backendId();
+    drain(*backend);
+
+    // 300 -> 310 and 200 -> 210 stay in the 320 / 224 classes.
+    inReleaseRenderTarget(target);
+    auto resized = inAcquireRenderTarget(310, 210);
+    assert(resized == target);
+    assert(resized->backendId() == id);
+    assert(resized->width() == 310 && resized->height() == 210);
+    auto counts = drain(*backend);
+    assert(counts.created == 0 && counts.disposed == 0);
+    assert(counts.updated == 1);
+
+    // Doubling the size moves to another class: a new surface.
+    inReleaseRenderTarget(resized);
+    auto bigger = inAcquireRenderTarget(620, 420);
+    assert(bigger != resized);
+    assert(bigger->backendId() != id);
+    counts = drain(*backend);
+    assert(counts.created == 1);
+
+    // Format is part of the key.
+    auto stencil = inAcquireRenderTarget(310, 210, 1, true);
+    assert(stencil != resized);
+    assert(stencil->stencil());
+
+    inReleaseRenderTarget(bigger);
+    inReleaseRenderTarget(stencil);
+    inClearRenderTargetPool();
+}
+
+void testPoolIsBounded() {
+    auto backend = std::make_shared<QueueRenderBackend>();
+    ScopedRenderBackend scope(backend);
+    std::vector<std::shared_ptr<Texture>> targets;
+    for (int i = 0; i < 8; ++i) targets.push_back(inAcquireRenderTarget(128, 128));
+    drain(*backend);
+    for (auto& target : targets) inReleaseRenderTarget(target);
+    // Only two free targets per class survive; the rest are disposed right away.
+    auto counts = drain(*backend);
+    assert(counts.disposed == 6);
+
+    targets.clear();
+    for (int i = 0; i < 40; ++i) targets.push_back(inAcquireRenderTarget(64 + i * 64, 64));
+    drain(*backend);
+    for (auto& target : targets) inReleaseRenderTarget(target);
+    counts = drain(*backend);
+    assert(counts.disposed >= 40 - 16);
+    inClearRenderTargetPool();
+}
+
+void testOrphanedTargetsAreDropped() {
+    {
+        auto backend = std::make_shared<QueueRenderBackend>();
+        ScopedRenderBackend scope(backend);
+        inReleaseRenderTarget(inAcquireRenderTarget(256, 256));
+    }
+    // The first backend is gone; its free target must not be handed to this one.
+    auto backend = std::make_shared<QueueRenderBackend>();
+    ScopedRenderBackend scope(backend);
+    auto target = inAcquireRenderTarget(256, 256);
+    assert(target->renderBackend() == backend);
+    auto counts = drain(*backend);
+    assert(counts.created == 1 && counts.disposed == 0);
+    inReleaseRenderTarget(target);
+    inClearRenderTargetPool();
+}
+
+void benchmarkResizeChurn() {
+    constexpr int kFrames = 2000;
+    auto backend = std::make_shared<QueueRenderBackend>();
+    ScopedRenderBackend scope(backend);
+    // A composite whose bounds wobble by a few pixels every frame.
+    std::shared_ptr<Texture> target;
+    std::size_t created = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        const int w = 1000 + (frame % 7);
+        const int h = 700 + (frame % 5);
+        inReleaseRenderTarget(target);
+        target = inAcquireRenderTarget(w, h);
+        created += drain(*backend).created;
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    assert(created == 1);
+    std::printf("[render_target_pool_test] %d resizes: %.2fms created=%zu\n", kFrames, ms, created);
+    inReleaseRenderTarget(target);
+    inClearRenderTargetPool();
+}
+
+} // namespace
+
+int main() {
+    testRenderTargetHasNoPixels();
+    testResizeWithinClassReusesSurface();
+    testPoolIsBounded();
+    testOrphanedTargetsAreDropped();
+    benchmarkResizeChurn();
+    return 0;
+}
@@ -0,0 +1,257 @@
+// The checks below drive the atlas through assert(); keep them active in Release builds.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "../core/render/shared_deform_buffer.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using nicxlive::core::math::Vec2;
+using nicxlive::core::math::Vec2Array;
+using nicxlive::core::render::SharedVecAtlas;
+
+namespace {
+
+struct Slot {
+    Vec2Array array{};
+    std::size_t offset{0};
+};
+
+void fill(Vec2Array& array, float base) {
+    for (std::size_t i = 0; i < array.size(); ++i) {
+        array.set(i, Vec2{base + static_cast<float>(i), -(base + static_cast<float>(i))});
+    }
+}
+
+bool holds(const Vec2Array& array, float base, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        auto v = array.at(i);
+        if (v.x != base + static_cast<float>(i) || v.y != -(base + static_cast<float>(i))) return false;
+    }
+    return true;
+}
+
+// Each slot must point into the atlas at its reported offset and no two slots may overlap.
+void checkLayout(SharedVecAtlas& atlas, const std::vector<std::unique_ptr<Slot>>& slots) {
+    std::vector<char> owner(atlas.stride(), 0);
+    for (const auto& slot : slots) {
+        if (!slot->array.size()) continue;
+        assert(slot->array.dataX() == atlas.data().dataX() + slot->offset);
+        for (std::size_t i = 0; i < slot->array.size(); ++i) {
+            assert(owner[slot->offset + i] == 0);
+            owner[slot->offset + i] = 1;
+        }
+    }
+}
+
+void testRegisterReusesFreedSpans() {
+    SharedVecAtlas atlas;
+    std::vector<std::unique_ptr<Slot>> slots;
+    for (int i = 0; i < 32; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->array.setLength(8 + static_cast<std::size_t>(i % 4));
+        fill(slot->array, static_cast<float>(i * 100));
+        atlas.registerArray(slot->array, &slot->offset);
+        slots.push_back(std::move(slot));
+    }
+    checkLayout(atlas, slots);
+    for (int i = 0; i < 32; ++i) assert(holds(slots[i]->array, static_cast<float>(i * 100), slots[i]->array.size()));
+
+    const auto stride = atlas.stride();
+    const auto freedOffset = slots[5]->offset;
+    atlas.unregisterArray(slots[5]->array);
+    slots.erase(slots.begin() + 5);
+    auto reuse = std::make_unique<Slot>();
+    reuse->array.setLength(8);
+    atlas.registerArray(reuse->array, &reuse->offset);
+    assert(reuse->offset == freedOffset);
+    assert(atlas.stride() == stride);
+    slots.push_back(std::move(reuse));
+    checkLayout(atlas, slots);
+}
+
+void testResizeKeepsDataAndOthersStayPut() {
+    SharedVecAtlas atlas;
+    std::vector<std::unique_ptr<Slot>> slots;
+    for (int i = 0; i < 4; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->array.setLength(16);
+        fill(slot->array, static_cast<float>(i * 1000));
+        atlas.registerArray(slot->array, &slot->offset);
+        slots.push_back(std::move(slot));
+    }
+    const auto firstOffset = slots[0]->offset;
+    const auto lastOffset = slots[3]->offset;
+
+    // Growing a middle slot relocates only that slot.
+    atlas.resizeArray(slots[1]->array, 40);
+    assert(slots[1]->array.size() == 40);
+    assert(holds(slots[1]->array, 1000.0f, 16));
+    for (std::size_t i = 16; i < 40; ++i) assert(slots[1]->array.at(i).x == 0.0f);
+    assert(slots[0]->offset == firstOffset);
+    assert(slots[3]->offset == lastOffset);
+    assert(holds(slots[0]->array, 0.0f, 16));
+    assert(holds(slots[2]->array, 2000.0f, 16));
+    assert(holds(slots[3]->array, 3000.0f, 16));
+    checkLayout(atlas, slots);
+
+    // Growing the tail slot extends it in place.
+    atlas.resizeArray(slots[1]->array, 48);
+    assert(holds(slots[1]->array, 1000.0f, 16));
+    checkLayout(atlas, slots);
+
+    // Shrinking keeps the offset and the prefix.
+    const auto offset = slots[2]->offset;
+    atlas.resizeArray(slots[2]->array, 4);
+    assert(slots[2]->offset == offset);
+    assert(holds(slots[2]->array, 2000.0f, 4));
+    checkLayout(atlas, slots);
+}
+
+void testDirtyRanges() {
+    SharedVecAtlas atlas;
+    std::vector<std::unique_ptr<Slot>> slots;
+    for (int i = 0; i < 4; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->array.setLength(10);
+        atlas.registerArray(slot->array, &slot->offset);
+        slots.push_back(std::move(slot));
+    }
+    assert(atlas.isDirty());
+    atlas.markUploaded();
+    assert(!atlas.isDirty());
+    assert(atlas.dirtyRanges().empty());
+
+    const auto revision = atlas.currentRevision();
+    atlas.markDirtyRange(slots[2]->offset, 10);
+    atlas.markDirtyRange(slots[1]->offset, 10);
+    assert(atlas.currentRevision() == revision + 1);
+    auto ranges = atlas.dirtyRanges();
+    assert(ranges.size() == 1);
+    assert(ranges[0].offset == slots[1]->offset);
+    assert(ranges[0].length == 20);
+
+    atlas.markDirty();
+    ranges = atlas.dirtyRanges();
+    assert(ranges.size() == 1);
+    assert(ranges[0].offset == 0 && ranges[0].length == atlas.stride());
+    atlas.markUploaded();
+}
+
+void testMarkDirtyIfChangedSkipsIdenticalWrites() {
+    SharedVecAtlas atlas;
+    std::vector<std::unique_ptr<Slot>> slots;
+    for (int i = 0; i < 3; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->array.setLength(6);
+        fill(slot->array, static_cast<float>(i * 10));
+        atlas.registerArray(slot->array, &slot->offset);
+        slots.push_back(std::move(slot));
+    }
+    atlas.markUploaded();
+
+    // Rewriting the same values is not a change.
+    fill(slots[1]->array, 10.0f);
+    assert(!atlas.markDirtyIfChanged(slots[1]->offset, 6));
+    assert(!atlas.isDirty());
+
+    slots[1]->array.set(3, Vec2{-1.0f, -1.0f});
+    assert(atlas.markDirtyIfChanged(slots[1]->offset, 6));
+    auto ranges = atlas.takeDirtyRanges();
+    assert(ranges.size() == 1);
+    assert(ranges[0].offset == slots[1]->offset && ranges[0].length == 6);
+    assert(!atlas.isDirty());
+
+    // The comparison baseline follows the last mark, not the original contents.
+    assert(!atlas.markDirtyIfChanged(slots[1]->offset, 6));
+    fill(slots[1]->array, 10.0f);
+    assert(atlas.markDirtyIfChanged(slots[1]->offset, 6));
+    atlas.markUploaded();
+}
+
+void testCompactionAfterHeavyChurn() {
+    SharedVecAtlas atlas;
+    std::vector<std::unique_ptr<Slot>> slots;
+    for (int i = 0; i < 256; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->array.setLength(32);
+        fill(slot->array, static_cast<float>(i));
+        atlas.registerArray(slot->array, &slot->offset);
+        slots.push_back(std::move(slot));
+    }
+    // Drop every other slot so the free spans cannot coalesce.
+    std::vector<std::unique_ptr<Slot>> kept;
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        if (i % 2) {
+            atlas.unregisterArray(slots[i]->array);
+        } else {
+            kept.push_back(std::move(slots[i]));
+        }
+    }
+    assert(static_cast<float>(atlas.wastedLength()) <= static_cast<float>(atlas.usedLength()) * SharedVecAtlas::kCompactRatio);
+    checkLayout(atlas, kept);
+    for (std::size_t i = 0; i < kept.size(); ++i) assert(holds(kept[i]->array, static_cast<float>(i * 2), 32));
+}
+
+void testHeldCompactionRunsOnceOnRelease() {
+    SharedVecAtlas atlas;
+    std::vector<std::unique_ptr<Slot>> slots;
+    for (int i = 0; i < 64; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->array.setLength(32);
+        fill(slot->array, static_cast<float>(i));
+        atlas.registerArray(slot->array, &slot->offset);
+        slots.push_back(std::move(slot));
+    }
+    const auto stride = atlas.stride();
+    atlas.holdCompaction();
+    std::vector<std::unique_ptr<Slot>> kept;
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        if (i % 4) {
+            atlas.unregisterArray(slots[i]->array);
+        } else {
+            kept.push_back(std::move(slots[i]));
+        }
+    }
+    // Nothing moved while held, even though the waste is far past the ratio.
+    assert(atlas.stride() == stride);
+    for (std::size_t i = 0; i < kept.size(); ++i) assert(kept[i]->offset == i * 4 * 32);
+    atlas.releaseCompaction();
+    assert(atlas.stride() < stride);
+    checkLayout(atlas, kept);
+    for (std::size_t i = 0; i < kept.size(); ++i) assert(holds(kept[i]->array, static_cast<float>(i * 4), 32));
+}
+
+void benchmarkRegistration() {
+    constexpr std::size_t kCount = 20000;
+    std::vector<std::unique_ptr<Slot>> slots;
+    slots.reserve(kCount);
+    SharedVecAtlas atlas;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < kCount; ++i) {
+        auto slot = std::make_unique<Slot>();
+        slot->array.setLength(64);
+        atlas.registerArray(slot->array, &slot->offset);
+        slots.push_back(std::move(slot));
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::printf("[shared_atlas_test] register %zu x 64 verts: %.2fms stride=%zu\n", kCount, ms, atlas.stride());
+}
+
+} // namespace
+
+int main() {
+    testRegisterReusesFreedSpans();
+    testResizeKeepsDataAndOthersStayPut();
+    testDirtyRanges();
+    testMarkDirtyIfChangedSkipsIdenticalWrites();
+    testCompactionAfterHeavyChurn();
+    testHeldCompactionRunsOnceOnRelease();
+    benchmarkRegistration();
+    return 0;
+}
@@ -0,0 +1,723 @@
+// The checks below drive the scheduler through assert(); keep them active in Release builds.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "../fmt/fmt.hpp"
+#include "../core/worker_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using nicxlive::core::Puppet;
+using nicxlive::core::RenderContext;
+using nicxlive::core::TaskAccess;
+using nicxlive::core::TaskAccessProvider;
+using nicxlive::core::TaskKind;
+using nicxlive::core::TaskOrder;
+using nicxlive::core::TaskScheduler;
+using nicxlive::core::WorkerPool;
+using nicxlive::core::fmt::inLoadJSONPuppet;
+using nicxlive::core::nodes::Node;
+using nicxlive::core::nodes::NodeTaskFlag;
+using nicxlive::core::nodes::NotifyReason;
+using nicxlive::core::nodes::Part;
+using nicxlive::core::param::ParamMergeMode;
+using nicxlive::core::param::Vec2u;
+using nicxlive::core::common::Vec2Array;
+
+namespace {
+
+struct FixedAccess : TaskAccessProvider {
+    FixedAccess(std::vector<const void*> r, std::vector<const void*> w, bool k = true)
+        : reads(std::move(r)), writes(std::move(w)), known(k) {}
+
+    std::vector<const void*> reads{};
+    std::vector<const void*> writes{};
+    bool known{true};
+
+    bool describeTaskAccess(TaskOrder, TaskAccess& access) const override {
+        if (!known) return false;
+        access.reads.insert(access.reads.end(), reads.begin(), reads.end());
+        access.writes.insert(access.writes.end(), writes.begin(), writes.end());
+        return known;
+    }
+};
+
+// Conflicting tasks keep submission order, and a task without an access set splits the stage.
+void testWaveOrdering() {
+    int a = 0, b = 0, c = 0;
+    FixedAccess writeA{{}, {&a}};
+    FixedAccess readAWriteB{{&a}, {&b}};
+    FixedAccess writeC{{}, {&c}};
+    FixedAccess readA{{&a}, {}};
+    FixedAccess writeAAgain{{}, {&a}};
+    FixedAccess barrier{{}, {}, false};
+    FixedAccess readB{{&b}, {}};
+
+    WorkerPool pool(4);
+    for (int round = 0; round < 50; ++round) {
+        TaskScheduler scheduler;
+        scheduler.setWorkerPool(&pool);
+        std::atomic<int> clock{0};
+        std::vector<int> stamp(9, -1);
+        auto add = [&](std::size_t index, const TaskAccessProvider* access) {
+            scheduler.addTask(TaskOrder::PreProcess, TaskKind::PreProcess, [&, index](RenderContext&) {
+                std::this_thread::yield();
+                stamp[index] = clock.fetch_add(1);
+            }, access);
+        };
+        add(0, &writeA);
+        add(1, &readAWriteB);
+        add(2, &writeC);
+        add(3, &readA);
+        add(4, &writeAAgain);
+        add(5, nullptr);
+        add(6, &readB);
+        add(7, &barrier);
+        add(8, &writeC);
+        RenderContext ctx{};
+        scheduler.execute(ctx);
+
+        for (int s : stamp) assert(s >= 0);
+        assert(stamp[0] < stamp[1]);
+        assert(stamp[0] < stamp[3]);
+        assert(stamp[1] < stamp[4] && stamp[3] < stamp[4]);
+        for (std::size_t i = 0; i < 5; ++i) assert(stamp[i] < stamp[5]);
+        assert(stamp[5] < stamp[6] && stamp[6] < stamp[7] && stamp[7] < stamp[8]);
+    }
+}
+
+struct RecordingNode : Node {
+    explicit RecordingNode(std::vector<std::string>& log, std::string tag) : log_(log), tag_(std::move(tag)) {}
+
+    void runBeginTask(RenderContext&) override { record("Begin"); }
+    void runPreProcessTask(RenderContext&) override { record("PreProcess"); }
+    void runDynamicTask(RenderContext&) override { record("Dynamic"); }
+    void runPostTaskImpl(std::size_t priority, RenderContext&) override { record("Post" + std::to_string(priority)); }
+    void runFinalTask(RenderContext&) override { record("Final"); }
+    void runRenderBeginTask(RenderContext&) override { record("RenderBegin"); }
+    void runRenderTask(RenderContext&) override { record("Render"); }
+    void runRenderEndTask(RenderContext&) override { record("RenderEnd"); }
+
+private:
+    void record(const std::string& entry) { log_.push_back(tag_ + ":" + entry); }
+
+    std::vector<std::string>& log_;
+    std::string tag_;
+};
+
+// Node tasks reach the entry point of their stage; stages run in sequence (Final before the render
+// stages) and tasks of one stage in submission order, whatever order they were added in.
+void testNodeTaskDispatch() {
+    std::vector<std::string> log;
+    RecordingNode a(log, "a");
+    RecordingNode b(log, "b");
+    TaskScheduler scheduler;
+    const std::pair<TaskOrder, TaskKind> stages[] = {
+        {TaskOrder::RenderEnd, TaskKind::Render}, {TaskOrder::Final, TaskKind::Finalize},
+        {TaskOrder::Render, TaskKind::Render}, {TaskOrder::Post2, TaskKind::PostProcess},
+        {TaskOrder::RenderBegin, TaskKind::Render}, {TaskOrder::Post1, TaskKind::PostProcess},
+        {TaskOrder::Post0, TaskKind::PostProcess}, {TaskOrder::Dynamic, TaskKind::Dynamic},
+        {TaskOrder::PreProcess, TaskKind::PreProcess}, {TaskOrder::Init, TaskKind::Init},
+    };
+    for (const auto& [order, kind] : stages) {
+        scheduler.addNodeTask(order, kind, &a);
+        scheduler.addNodeTask(order, kind, &b);
+    }
+    scheduler.addTask(TaskOrder::Parameters, TaskKind::Parameters, [&](RenderContext&) { log.push_back("params"); });
+    assert(scheduler.totalTaskCount() == 21);
+    assert(scheduler.taskCount(TaskOrder::Post1) == 2);
+
+    RenderContext ctx{};
+    scheduler.execute(ctx);
+    const std::vector<std::string> expected{
+        "a:Begin", "b:Begin", "params", "a:PreProcess", "b:PreProcess", "a:Dynamic", "b:Dynamic",
+        "a:Post0", "b:Post0", "a:Post1", "b:Post1", "a:Post2", "b:Post2", "a:Final", "b:Final",
+        "a:RenderBegin", "b:RenderBegin", "a:Render", "b:Render", "a:RenderEnd", "b:RenderEnd"};
+    assert(log == expected);
+
+    // Tasks added after a run join their stage behind the compiled ones.
+    log.clear();
+    scheduler.addNodeTask(TaskOrder::PreProcess, TaskKind::PreProcess, &a);
+    scheduler.executeRange(ctx, TaskOrder::PreProcess, TaskOrder::PreProcess);
+    assert((log == std::vector<std::string>{"a:PreProcess", "b:PreProcess", "a:PreProcess"}));
+
+    scheduler.clearTasks();
+    assert(scheduler.totalTaskCount() == 0);
+}
+
+// After moves, detaches and inserts, re-registering just the touched parents leaves a task list
+// that runs exactly like a freshly registered one.
+void testSubtreeRebuild() {
+    std::vector<std::string> log;
+    auto make = [&](const std::string& tag, const std::shared_ptr<Node>& parent, float zSort, bool drawn) {
+        auto node = std::make_shared<RecordingNode>(log, tag);
+        node->zSort(zSort);
+        if (drawn) node->taskFlags = NodeTaskFlag::PreProcess | NodeTaskFlag::Render | NodeTaskFlag::RenderEnd;
+        if (parent) node->insertInto(parent, Node::OFFSET_END);
+        return node;
+    };
+    auto root = make("root", nullptr, 0.0f, false);
+    auto a = make("a", root, 2.0f, true);
+    auto b = make("b", root, 1.0f, false);
+    auto c = make("c", root, 0.0f, true);
+    auto a1 = make("a1", a, 0.0f, true);
+    auto a2 = make("a2", a, 1.0f, false);
+    auto a3 = make("a3", a, 2.0f, true);
+    auto b1 = make("b1", b, 0.0f, true);
+    auto b2 = make("b2", b, 1.0f, true);
+    auto c1 = make("c1", c, 0.0f, true);
+
+    TaskScheduler incremental;
+    incremental.addSubtree(root.get());
+    RenderContext ctx{};
+    auto check = [&]() {
+        log.clear();
+        incremental.execute(ctx);
+        const auto got = log;
+        TaskScheduler fresh;
+        fresh.addSubtree(root.get());
+        log.clear();
+        fresh.execute(ctx);
+        assert(got == log);
+        assert(incremental.totalTaskCount() == fresh.totalTaskCount());
+    };
+    check();
+
+    a2->insertInto(b, Node::OFFSET_END); // across subtrees
+    b1->insertInto(nullptr, Node::OFFSET_END);
+    assert(incremental.rebuildSubtrees({a.get(), b.get()}) == 2);
+    check();
+
+    auto n = make("n", a1, 5.0f, true); // into a leaf, listed with its ancestor
+    c->insertInto(b, 0);                 // a drawn subtree moves down a level
+    assert(incremental.rebuildSubtrees({a1.get(), a.get(), root.get(), b.get()}) == 1);
+    check();
+
+    b1->insertInto(c1, Node::OFFSET_END); // a detached node comes back
+    a3->zSort(-1.0f);                     // reorder within a
+    n->insertInto(nullptr, Node::OFFSET_END);
+    assert(incremental.rebuildSubtrees({c1.get(), a.get(), a1.get(), b1.get()}) == 2);
+    check();
+
+    assert(incremental.rebuildSubtrees({n.get()}) == 0); // detached: nothing recorded
+    check();
+}
+
+// Root -> `groups` groups -> `partsPerGroup` parts with `grid`x`grid` meshes. One parameter moves
+// the groups and deforms every part, so each frame refreshes ancestor transforms and rewrites every
+// deformation slot.
+std::string makeGridPuppetJson(std::size_t groups, std::size_t partsPerGroup, std::size_t grid) {
+    auto partUuid = [&](std::size_t g, std::size_t p) { return 1000 + g * partsPerGroup + p; };
+    const std::size_t verts = grid * grid;
+    std::ostringstream mesh;
+    mesh << "\"mesh\":{\"verts\":[";
+    for (std::size_t i = 0; i < verts; ++i) {
+        if (i) mesh << ",";
+        mesh << static_cast<float>(i % grid) << "," << static_cast<float>(i / grid);
+    }
+    mesh << "],\"uvs\":[";
+    for (std::size_t i = 0; i < verts; ++i) {
+        if (i) mesh << ",";
+        mesh << static_cast<float>(i % grid) / static_cast<float>(grid - 1) << ","
+             << static_cast<float>(i / grid) / static_cast<float>(grid - 1);
+    }
+    mesh << "],\"indices\":[";
+    for (std::size_t y = 0; y + 1 < grid; ++y) {
+        for (std::size_t x = 0; x + 1 < grid; ++x) {
+            const std::size_t i = y * grid + x;
+            if (y || x) mesh << ",";
+            mesh << i << "," << (i + 1) << "," << (i + grid) << "," << (i + 1) << "," << (i + grid + 1) << "," << (i + grid);
+        }
+    }
+    mesh << "],\"origin\":[0,0]}";
+
+    std::ostringstream os;
+    os << "{\"meta\":{\"preservePixels\":false},\"nodes\":{\"type\":\"Node\",\"uuid\":1,\"name\":\"Root\",\"children\":[";
+    for (std::size_t g = 0; g < groups; ++g) {
+        if (g) os << ",";
+        os << "{\"type\":\"Node\",\"uuid\":" << (10 + g) << ",\"name\":\"group" << g << "\",\"children\":[";
+        for (std::size_t p = 0; p < partsPerGroup; ++p) {
+            if (p) os << ",";
+            os << "{\"type\":\"Part\",\"uuid\":" << partUuid(g, p) << ",\"name\":\"part" << p << "\","
+               << "\"transform\":{\"trans\":[" << static_cast<float>(p) * 3.0f << ",0,0],\"rot\":[0,0,0.1],\"scale\":[1,1]},"
+               << mesh.str() << ",\"opacity\":1,\"blend_mode\":\"Normal\"}";
+        }
+        os << "]}";
+    }
+    os << "]},\"param\":[{\"uuid\":9000,\"name\":\"Wave\",\"is_vec2\":false,\"min\":[0,0],\"max\":[1,0],"
+       << "\"defaults\":[0,0],\"axis_points\":[[0,1],[0]],\"bindings\":[";
+    for (std::size_t g = 0; g < groups; ++g) {
+        if (g) os << ",";
+        os << "{\"node\":" << (10 + g) << ",\"param_name\":\"transform.t.x\",\"values\":[[0],[" << (g + 1)
+           << "]],\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+    }
+    for (std::size_t g = 0; g < groups; ++g) {
+        for (std::size_t p = 0; p < partsPerGroup; ++p) {
+            os << ",{\"node\":" << partUuid(g, p) << ",\"param_name\":\"deform\",\"values\":[[[";
+            for (std::size_t i = 0; i < verts; ++i) os << (i ? "," : "") << "[0,0]";
+            os << "]],[[";
+            for (std::size_t i = 0; i < verts; ++i) {
+                os << (i ? "," : "") << "[" << static_cast<float>(i % 7) * 0.13f << "," << static_cast<float>(p % 5) * 0.37f << "]";
+            }
+            os << "]]],\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+        }
+    }
+    os << "]}]}";
+    return os.str();
+}
+
+std::shared_ptr<Puppet> loadAndBuild(const std::string& json) {
+    auto puppet = inLoadJSONPuppet<Puppet>(json);
+    puppet->rescanNodes();
+    puppet->actualRoot()->build(true);
+    return puppet;
+}
+
+bool sameBits(const float* a, const float* b, std::size_t count) {
+    return count == 0 || std::memcmp(a, b, count * sizeof(float)) == 0;
+}
+
+void checkSameParts(Puppet& serial, Puppet& parallel) {
+    auto lhs = serial.getAllParts();
+    auto rhs = parallel.getAllParts();
+    assert(lhs.size() == rhs.size());
+    for (std::size_t i = 0; i < lhs.size(); ++i) {
+        const Part& a = *lhs[i];
+        const Part& b = *rhs[i];
+        assert(a.uuid == b.uuid);
+        assert(a.deformation.size() == b.deformation.size());
+        assert(sameBits(a.deformation.dataX(), b.deformation.dataX(), a.deformation.size()));
+        assert(sameBits(a.deformation.dataY(), b.deformation.dataY(), a.deformation.size()));
+        assert(a.bounds.has_value() == b.bounds.has_value());
+        if (a.bounds) assert(sameBits(a.bounds->data(), b.bounds->data(), 4));
+        const auto ma = a.transform().toMat4();
+        const auto mb = b.transform().toMat4();
+        assert(sameBits(&ma.a.a[0][0], &mb.a.a[0][0], 16));
+    }
+}
+
+void checkSameState(Puppet& serial, Puppet& parallel) {
+    checkSameParts(serial, parallel);
+    assert(serial.isSettled() == parallel.isSettled());
+}
+
+// Nodes moved in and out of a loaded puppet gain and lose their tasks on the next update, once each.
+void testPuppetStructureEdits() {
+    auto puppet = loadAndBuild(makeGridPuppetJson(3, 4, 3));
+    puppet->update();
+    std::vector<std::string> log;
+    auto probe = std::make_shared<RecordingNode>(log, "probe");
+    const std::vector<std::string> oneFrame{"probe:Begin", "probe:Final"};
+
+    probe->insertInto(puppet->findNodeById(11), Node::OFFSET_END);
+    puppet->update();
+    assert(log == oneFrame);
+
+    log.clear();
+    probe->insertInto(nullptr, Node::OFFSET_END);
+    puppet->update();
+    assert(log.empty());
+
+    probe->insertInto(puppet->findNodeById(1002), 0); // under a part of another group
+    puppet->findNodeById(1001)->insertInto(puppet->findNodeById(12), Node::OFFSET_END);
+    puppet->update();
+    assert(log == oneFrame);
+}
+
+// Every frame of a pooled puppet matches the serial puppet bit for bit.
+void testMatchesSerial() {
+    const auto json = makeGridPuppetJson(8, 12, 5);
+    auto serial = loadAndBuild(json);
+    auto parallel = loadAndBuild(json);
+    WorkerPool pool(std::max<std::size_t>(4, std::thread::hardware_concurrency()));
+    parallel->setTaskWorkerPool(&pool);
+    for (float value : {0.0f, 0.25f, 0.5f, 0.5f, 1.0f, 0.75f, 0.0f}) {
+        serial->parameters[0]->value.x = value;
+        parallel->parameters[0]->value.x = value;
+        serial->update();
+        parallel->update();
+        checkSameState(*serial, *parallel);
+    }
+}
+
+// `chains` independent deformer chains under the root: a MeshGroup holding a GridDeformer with
+// `parts` parts, plus `parts` parts of its own; parts have `meshSize` x `meshSize` vertices. "Bend"
+// deforms every group and grid; "Lift" only moves the first grid, so frames that change only it
+// leave the other chains' inputs as they were.
+std::string makeDeformerPuppetJson(std::size_t chains, std::size_t parts, std::size_t meshSize) {
+    auto partUuid = [&](std::size_t c, std::size_t p) { return 1000 + c * 2 * parts + p; };
+    // n x n vertices over [x0, x1] x [y0, y1].
+    auto gridMesh = [](float x0, float y0, float x1, float y1, std::size_t n) {
+        std::ostringstream os;
+        const float step = 1.0f / static_cast<float>(n - 1);
+        os << "\"mesh\":{\"verts\":[";
+        for (std::size_t i = 0; i < n * n; ++i) {
+            const float u = static_cast<float>(i % n) * step;
+            const float v = static_cast<float>(i / n) * step;
+            os << (i ? "," : "") << x0 + (x1 - x0) * u << "," << y0 + (y1 - y0) * v;
+        }
+        os << "],\"uvs\":[";
+        for (std::size_t i = 0; i < n * n; ++i) {
+            os << (i ? "," : "") << static_cast<float>(i % n) * step << "," << static_cast<float>(i / n) * step;
+        }
+        os << "],\"indices\":[";
+        for (std::size_t y = 0; y + 1 < n; ++y) {
+            for (std::size_t x = 0; x + 1 < n; ++x) {
+                const std::size_t i = y * n + x;
+                os << (y || x ? "," : "") << i << "," << (i + 1) << "," << (i + n) << "," << (i + 1) << ","
+                   << (i + n + 1) << "," << (i + n);
+            }
+        }
+        os << "],\"origin\":[0,0]}";
+        return os.str();
+    };
+    auto part = [&](std::size_t uuid, std::size_t p) {
+        std::ostringstream os;
+        os << "{\"type\":\"Part\",\"uuid\":" << uuid << ",\"name\":\"part" << p << "\","
+           << "\"transform\":{\"trans\":[" << static_cast<float>(p % 6) * 3.0f << "," << static_cast<float>(p / 6) * 4.0f
+           << ",0],\"rot\":[0,0,0.1],\"scale\":[1,1]}," << gridMesh(0, 0, 3, 3, meshSize) << ",\"opacity\":1,\"blend_mode\":\"Normal\"}";
+        return os.str();
+    };
+    const float extent = 4.0f * static_cast<float>((parts + 5) / 6) + 6.0f;
+    std::ostringstream os;
+    os << "{\"meta\":{\"preservePixels\":false},\"nodes\":{\"type\":\"Node\",\"uuid\":1,\"name\":\"Root\",\"children\":[";
+    for (std::size_t c = 0; c < chains; ++c) {
+        if (c) os << ",";
+        os << "{\"type\":\"MeshGroup\",\"uuid\":" << (100 + c) << ",\"name\":\"group" << c << "\","
+           << gridMesh(-4, -4, 24, extent, 3) << ",\"children\":[";
+        os << "{\"type\":\"GridDeformer\",\"uuid\":" << (200 + c) << ",\"name\":\"grid" << c << "\","
+           << "\"grid_axis_x\":[-2,6,14,22],\"grid_axis_y\":[-3," << extent * 0.5f << "," << extent << "],\"children\":[";
+        for (std::size_t p = 0; p < parts; ++p) os << (p ? "," : "") << part(partUuid(c, p), p);
+        os << "]}";
+        for (std::size_t p = 0; p < parts; ++p) os << "," << part(partUuid(c, parts + p), p);
+        os << "]}";
+    }
+    auto offsets = [](std::size_t count, std::size_t moved, float dx, float dy) {
+        std::ostringstream os;
+        os << "[";
+        for (std::size_t i = 0; i < count; ++i) {
+            os << (i ? "," : "") << "[" << (i == moved ? dx : 0.0f) << "," << (i == moved ? dy : 0.0f) << "]";
+        }
+        os << "]";
+        return os.str();
+    };
+    os << "]},\"param\":[{\"uuid\":9100,\"name\":\"Bend\",\"is_vec2\":false,\"min\":[0,0],\"max\":[1,0],"
+       << "\"defaults\":[0,0],\"axis_points\":[[0,1],[0]],\"bindings\":[";
+    for (std::size_t c = 0; c < chains; ++c) {
+        const float amount = 0.5f + 0.25f * static_cast<float>(c % 4);
+        os << (c ? "," : "") << "{\"node\":" << (100 + c) << ",\"param_name\":\"deform\",\"values\":[["
+           << offsets(9, 4, 0, 0) << "],[" << offsets(9, 4, amount, -amount) << "]],"
+           << "\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+        os << ",{\"node\":" << (200 + c) << ",\"param_name\":\"deform\",\"values\":[["
+           << offsets(12, 5, 0, 0) << "],[" << offsets(12, 5, -amount, 2 * amount) << "]],"
+           << "\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}";
+    }
+    os << "]},{\"uuid\":9101,\"name\":\"Lift\",\"is_vec2\":false,\"min\":[0,0],\"max\":[1,0],"
+       << "\"defaults\":[0,0],\"axis_points\":[[0,1],[0]],\"bindings\":["
+       << "{\"node\":200,\"param_name\":\"transform.t.y\",\"values\":[[0],[2]],"
+       << "\"isSet\":[[true],[true]],\"interpolate_mode\":\"Linear\"}]}]}";
+    return os.str();
+}
+
+// Deformer chains run as a dependency graph of their own (each target after the deformers it reads)
+// and give the parts the vertices the serial tree walk gives, frame by frame. Frames whose deformer
+// inputs did not move replay the last filter results, which match a freshly computed frame.
+void testDeformerChainsMatchSerial() {
+    const auto json = makeDeformerPuppetJson(6, 8, 4);
+    auto serial = loadAndBuild(json);
+    auto parallel = loadAndBuild(json);
+
+    // Deformers and their targets state their access instead of running alone; a target reads the
+    // deformers whose hooks it runs.
+    auto group = parallel->findNodeById(101);
+    auto grid = parallel->findNodeById(201);
+    auto gridPart = parallel->findNodeById(1000 + 16);
+    TaskAccess access;
+    assert(group->describeTaskAccess(TaskOrder::PreProcess, access));
+    assert(grid->describeTaskAccess(TaskOrder::PreProcess, access));
+    access = {};
+    assert(gridPart->describeTaskAccess(TaskOrder::PreProcess, access));
+    for (const void* source : {static_cast<const void*>(group.get()), static_cast<const void*>(grid.get())}) {
+        assert(std::find(access.reads.begin(), access.reads.end(), source) != access.reads.end());
+    }
+    WorkerPool pool(std::max<std::size_t>(4, std::thread::hardware_concurrency()));
+    parallel->setTaskWorkerPool(&pool);
+    float deformed = 0.0f;
+    for (auto [bend, lift] : {std::pair{0.0f, 0.0f}, {0.4f, 0.0f}, {0.4f, 0.0f}, {0.4f, 1.0f}, {1.0f, 1.0f},
+                              {1.0f, 1.0f}, {0.7f, 0.5f}, {0.7f, 0.5f}}) {
+        for (auto* puppet : {serial.get(), parallel.get()}) {
+            puppet->parameters[0]->value.x = bend;
+            puppet->parameters[1]->value.x = lift;
+            puppet->update();
+        }
+        checkSameState(*serial, *parallel);
+        for (const auto& part : serial->getAllParts()) {
+            for (std::size_t i = 0; i < part->deformation.size(); ++i) deformed += std::fabs(part->deformation.xAt(i));
+        }
+    }
+    assert(deformed > 0.0f); // the chains actually deformed their parts
+
+    auto fresh = loadAndBuild(json);
+    fresh->parameters[0]->value.x = 0.7f;
+    fresh->parameters[1]->value.x = 0.5f;
+    fresh->update();
+    checkSameParts(*fresh, *serial);
+    checkSameParts(*fresh, *parallel);
+}
+
+// A deform hook with a source revision runs again only when its source revision, or the target's
+// vertices, deformation or matrix, changed; otherwise the target gets its last result again.
+void testDeformHookReplay() {
+    auto puppet = loadAndBuild(makeGridPuppetJson(1, 2, 3));
+    auto part = std::dynamic_pointer_cast<Part>(puppet->findNodeById(1000));
+    auto group = puppet->findNodeById(10);
+    std::uint64_t revision = 0;
+    int calls = 0;
+    Node::DeformFilterHook hook{};
+    hook.stage = 0;
+    hook.tag = 0x5eed;
+    hook.source = group.get();
+    hook.revision = &revision;
+    hook.func = [&](std::shared_ptr<Node>, const Vec2Array&, Vec2Array& deform, const auto*) {
+        ++calls;
+        for (std::size_t i = 0; i < deform.size(); ++i) deform.xAt(i) += 1.0f + static_cast<float>(revision);
+        Node::DeformFilterResult result;
+        result.changed = true;
+        return result;
+    };
+    part->upsertDeformPreProcessFilter(hook);
+    auto offsetX = [&] { return part->deformation.xAt(0); };
+
+    puppet->update();
+    assert(calls == 1 && offsetX() == 1.0f);
+    puppet->update();
+    assert(calls == 1 && offsetX() == 1.0f);
+
+    ++revision;
+    puppet->update();
+    assert(calls == 2 && offsetX() == 2.0f);
+
+    puppet->parameters[0]->value.x = 1.0f; // new input deformation
+    puppet->update();
+    assert(calls == 3);
+    puppet->update();
+    assert(calls == 3);
+
+    group->localTransform.translation.y += 1.0f; // new target matrix
+    group->transformChanged();
+    puppet->update();
+    assert(calls == 4);
+
+    assert(offsetX() == 2.0f); // the binding leaves the first vertex where it is
+    part->removeDeformPreProcessFilter(0, 0x5eed);
+    puppet->update();
+    assert(calls == 4 && offsetX() == 0.0f);
+}
+
+// Frames whose parameter value and driver inputs repeat re-apply each binding's last interpolation;
+// a keyframe edit or a pushed driver offset recomputes it, and every frame matches a fresh puppet.
+void testIdleParametersReuseBindings() {
+    const auto json = makeGridPuppetJson(2, 3, 4);
+    auto puppet = loadAndBuild(json);
+    auto frame = [](Puppet& p, float value, float drive) {
+        p.parameters[0]->value.x = value;
+        if (drive != 0.0f) p.parameters[0]->pushIOffset({drive, 0.0f}, ParamMergeMode::Additive);
+        p.update();
+    };
+    auto fresh = [&](float value, float drive) {
+        auto p = loadAndBuild(json);
+        frame(*p, value, 0.0f); // the first update of a puppet drops pushed offsets
+        frame(*p, value, drive);
+        return p;
+    };
+    for (int i = 0; i < 3; ++i) {
+        frame(*puppet, 0.4f, 0.0f);
+        checkSameParts(*fresh(0.4f, 0.0f), *puppet);
+    }
+    frame(*puppet, 0.4f, 0.3f); // same value, new driver input
+    checkSameParts(*fresh(0.4f, 0.3f), *puppet);
+    frame(*puppet, 0.4f, 0.0f);
+    checkSameParts(*fresh(0.4f, 0.0f), *puppet);
+
+    // Resetting the far keyframe of the first group's translation, while the value stays put.
+    auto edit = [](Puppet& p) {
+        for (auto& [_, binding] : p.parameters[0]->bindingMap) {
+            if (binding->getNodeUUID() == 10 && binding->getName() == "transform.t.x") binding->reset(Vec2u{1, 0});
+        }
+    };
+    const float before = puppet->findNodeById(1000)->transform().translation.x;
+    edit(*puppet);
+    frame(*puppet, 0.4f, 0.0f);
+    auto edited = fresh(0.4f, 0.0f);
+    edit(*edited);
+    frame(*edited, 0.4f, 0.0f);
+    checkSameParts(*edited, *puppet);
+    assert(puppet->findNodeById(1000)->transform().translation.x != before);
+}
+
+// Per-frame update time of a puppet with hundreds of drawables against the pool's thread count.
+void benchmarkSpeedup() {
+    constexpr std::size_t kGroups = 16;
+    constexpr std::size_t kParts = 32;
+    constexpr int kFrames = 40;
+    auto puppet = loadAndBuild(makeGridPuppetJson(kGroups, kParts, 12));
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> counts{1, 2, 4, hw};
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+
+    double serialMs = 0.0;
+    for (std::size_t threads : counts) {
+        WorkerPool pool(threads);
+        puppet->setTaskWorkerPool(&pool);
+        auto frame = [&](int i) {
+            puppet->parameters[0]->value.x = static_cast<float>(i % 10) / 10.0f;
+            puppet->update();
+        };
+        for (int i = 0; i < 3; ++i) frame(i);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFrames; ++i) frame(i);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kFrames;
+        if (threads == 1) serialMs = ms;
+        std::printf("[task_scheduler_test] %zu drawables, %zu thread(s) of %u cores: %.3fms/frame (%.2fx)\n",
+                    kGroups * kParts, threads, hw, ms, serialMs / ms);
+        puppet->setTaskWorkerPool(nullptr);
+    }
+}
+
+// Per-task cost of running a puppet-sized task list whose tasks do next to nothing.
+void benchmarkSchedulingOverhead() {
+    constexpr std::size_t kNodes = 10000;
+    constexpr int kFrames = 200;
+    auto root = Node::inInstantiateNode("Node");
+    for (std::size_t i = 0; i < kNodes; ++i) Node::inInstantiateNode("Node", root);
+    TaskScheduler scheduler;
+    root->registerRenderTasks(scheduler);
+    RenderContext ctx{};
+    scheduler.execute(ctx);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kFrames; ++i) scheduler.execute(ctx);
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kFrames;
+    std::printf("[task_scheduler_test] %zu node tasks: %.1fus/frame (%.1fns/task)\n", scheduler.totalTaskCount(), us,
+                us * 1000.0 / static_cast<double>(scheduler.totalTaskCount()));
+}
+
+
+// Frame time while one part is hidden and shown every frame, by toggling `enabled` and by taking it
+// out of the tree and putting it back. Re-registering only the touched groups is compared against the full
+// rebuild a StructureChanged notification still forces; both end in the same state.
+void benchmarkVisibilityToggle() {
+    constexpr std::size_t kGroups = 32;
+    constexpr std::size_t kParts = 64;
+    constexpr int kFrames = 200;
+    const auto json = makeGridPuppetJson(kGroups, kParts, 3);
+    enum class Mode { Idle, ToggleEnabled, Reattach, ReattachFullRebuild };
+    auto run = [&](Mode mode, std::shared_ptr<Puppet>& puppet, std::shared_ptr<Part>& part) {
+        puppet = loadAndBuild(json);
+        part = std::dynamic_pointer_cast<Part>(puppet->findNodeById(static_cast<uint32_t>(1000 + 5 * kParts + 17)));
+        auto group = puppet->findNodeById(15);
+        for (int i = 0; i < 3; ++i) puppet->update();
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFrames; ++i) {
+            puppet->parameters[0]->value.x = static_cast<float>(i % 10) / 10.0f;
+            switch (mode) {
+            case Mode::Idle: break;
+            case Mode::ToggleEnabled: part->setEnabled(!part->enabled); break;
+            case Mode::Reattach:
+            case Mode::ReattachFullRebuild:
+                part->insertInto(i % 2 ? nullptr : group, Node::OFFSET_END);
+                if (mode == Mode::ReattachFullRebuild) puppet->recordNodeChange(NotifyReason::StructureChanged);
+                break;
+            }
+            puppet->update();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kFrames;
+    };
+    std::shared_ptr<Puppet> idle, toggled, incremental, full;
+    std::shared_ptr<Part> idlePart, toggledPart, incrementalPart, fullPart;
+    const double idleMs = run(Mode::Idle, idle, idlePart);
+    const double toggleMs = run(Mode::ToggleEnabled, toggled, toggledPart);
+    const double incrementalMs = run(Mode::Reattach, incremental, incrementalPart);
+    const double fullMs = run(Mode::ReattachFullRebuild, full, fullPart);
+    assert(!incrementalPart->parentPtr() && !fullPart->parentPtr());
+    checkSameState(*full, *incremental);
+    std::printf("[task_scheduler_test] %zu parts, one hidden/shown per frame: idle %.3fms, enabled toggle %.3fms, "
+                "reattach %.3fms (full rebuild %.3fms, %.2fx)\n",
+                kGroups * kParts, idleMs, toggleMs, incrementalMs, fullMs, fullMs / incrementalMs);
+}
+
+
+// Frame time of a deformer-heavy puppet while every chain animates, while one chain does, and idle.
+void benchmarkDeformerChains() {
+    constexpr int kFrames = 60;
+    auto puppet = loadAndBuild(makeDeformerPuppetJson(16, 24, 12));
+    auto run = [&](bool bendMoves, bool liftMoves) {
+        auto frame = [&](int i) {
+            const float value = static_cast<float>(i % 10) / 10.0f;
+            if (bendMoves) puppet->parameters[0]->value.x = value;
+            if (liftMoves) puppet->parameters[1]->value.x = value;
+            puppet->update();
+        };
+        for (int i = 0; i < 3; ++i) frame(i);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFrames; ++i) frame(i);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kFrames;
+    };
+    const double allMs = run(true, false);
+    const double oneMs = run(false, true);
+    const double idleMs = run(false, false);
+    std::printf("[task_scheduler_test] 16 deformer chains, %zu parts: all moving %.3fms, one moving %.3fms, idle %.3fms\n",
+                puppet->getAllParts().size(), allMs, oneMs, idleMs);
+}
+
+// Parameter evaluation of an animating puppet against one whose parameters sit still.
+void benchmarkIdleParameters() {
+    constexpr int kFrames = 200;
+    auto puppet = loadAndBuild(makeGridPuppetJson(16, 32, 12));
+    auto root = puppet->actualRoot();
+    auto run = [&](bool moving) {
+        auto frame = [&](int i) {
+            if (moving) puppet->parameters[0]->value.x = static_cast<float>(i % 10) / 10.0f;
+            puppet->updateParametersAndDrivers(root);
+        };
+        for (int i = 0; i < 3; ++i) frame(i);
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kFrames; ++i) frame(i);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / kFrames;
+    };
+    const double movingMs = run(true);
+    const double idleMs = run(false);
+    std::printf("[task_scheduler_test] %zu bindings: parameters moving %.3fms/frame, idle %.3fms/frame (%.2fx)\n",
+                puppet->parameters[0]->bindingMap.size(), movingMs, idleMs, movingMs / idleMs);
+}
+
+} // namespace
+
+int main() {
+    testWaveOrdering();
+    testNodeTaskDispatch();
+    testSubtreeRebuild();
+    testPuppetStructureEdits();
+    testMatchesSerial();
+    testDeformerChainsMatchSerial();
+    testDeformHookReplay();
+    testIdleParametersReuseBindings();
+    benchmarkSpeedup();
+    benchmarkSchedulingOverhead();
+    benchmarkVisibilityToggle();
+    benchmarkDeformerChains();
+    benchmarkIdleParameters();
+    return 0;
+}
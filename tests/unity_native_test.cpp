@@ -0,0 +1,1154 @@
+// The checks below drive the API through assert(); keep them active in Release builds.
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include "../core/unity_native.hpp"
+#include "puppet_fixture.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+using nicxlive::tests::writePuppetFile;
+
+namespace {
+
+constexpr std::size_t kPartsPerPuppet = 16;
+constexpr int kFrames = 60;
+
+struct RendererSlot {
+    void* renderer{nullptr};
+    void* puppet{nullptr};
+    uint32_t paramUuid{0};
+};
+
+RendererSlot makeSlot(const std::string& path) {
+    RendererSlot slot{};
+    UnityRendererConfig cfg{256, 256};
+    assert(njgCreateRenderer(&cfg, nullptr, &slot.renderer) == NjgResult::Ok);
+    assert(njgLoadPuppet(slot.renderer, path.c_str(), &slot.puppet) == NjgResult::Ok);
+    size_t count = 0;
+    assert(njgGetParameters(slot.puppet, nullptr, 0, &count) == NjgResult::Ok);
+    assert(count == 1);
+    NjgParameterInfo info{};
+    assert(njgGetParameters(slot.puppet, &info, 1, &count) == NjgResult::Ok);
+    slot.paramUuid = info.uuid;
+    return slot;
+}
+
+void destroySlot(const RendererSlot& slot) {
+    assert(njgUnloadPuppet(slot.renderer, slot.puppet) == NjgResult::Ok);
+    njgDestroyRenderer(slot.renderer);
+}
+
+// Flattens the per-part model matrices of one emitted frame so runs can be compared exactly.
+std::vector<float> runFrames(const RendererSlot& slot) {
+    std::vector<float> signature;
+    FrameConfig frame{256, 256};
+    for (int i = 0; i < kFrames; ++i) {
+        PuppetParameterUpdate upd{slot.paramUuid, {static_cast<float>(i % 10) / 10.0f, 0.0f}};
+        assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+        assert(njgBeginFrame(slot.renderer, &frame) == NjgResult::Ok);
+        assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+        CommandQueueView view{};
+        assert(njgEmitCommands(slot.renderer, &view) == NjgResult::Ok);
+        assert(view.count == kPartsPerPuppet);
+        if (i == kFrames - 1) {
+            for (size_t c = 0; c < view.count; ++c) {
+                assert(view.commands[c].kind == NjgRenderCommandKind::DrawPart);
+                const auto& m = view.commands[c].partPacket.modelMatrix;
+                for (int r = 0; r < 4; ++r) {
+                    for (int k = 0; k < 4; ++k) signature.push_back(m[r][k]);
+                }
+            }
+        }
+    }
+    return signature;
+}
+
+void testConcurrentRenderersMatchSerial() {
+    const auto threadCount = static_cast<std::size_t>((std::max)(4u, std::thread::hardware_concurrency()));
+    const auto path = writePuppetFile("nicxlive_unity_native_test", kPartsPerPuppet);
+
+    std::vector<RendererSlot> slots;
+    for (std::size_t i = 0; i < threadCount; ++i) slots.push_back(makeSlot(path));
+
+    const auto serialStart = std::chrono::steady_clock::now();
+    std::vector<std::vector<float>> expected;
+    for (const auto& slot : slots) expected.push_back(runFrames(slot));
+    const double serialMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - serialStart).count();
+
+    std::vector<std::vector<float>> actual(slots.size());
+    std::vector<std::thread> workers;
+    const auto parallelStart = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        workers.emplace_back([&, i]() { actual[i] = runFrames(slots[i]); });
+    }
+    for (auto& w : workers) w.join();
+    const double parallelMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - parallelStart).count();
+
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        assert(!expected[i].empty());
+        assert(actual[i].size() == expected[i].size());
+        assert(std::memcmp(actual[i].data(), expected[i].data(), actual[i].size() * sizeof(float)) == 0);
+    }
+    std::printf("[unity_native_test] %zu renderers x %d frames: serial=%.2fms threaded=%.2fms\n",
+                slots.size(), kFrames, serialMs, parallelMs);
+
+    for (const auto& slot : slots) destroySlot(slot);
+}
+
+void testConcurrentAccessToOnePuppet() {
+    const auto path = writePuppetFile("nicxlive_unity_native_test_shared", kPartsPerPuppet);
+    auto slot = makeSlot(path);
+    std::atomic<bool> stop{false};
+    std::thread writer([&]() {
+        float v = 0.0f;
+        while (!stop.load()) {
+            PuppetParameterUpdate upd{slot.paramUuid, {v, 0.0f}};
+            assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+            assert(njgSetPuppetTranslation(slot.puppet, v, 0.0f) == NjgResult::Ok);
+            v = v >= 1.0f ? 0.0f : v + 0.125f;
+        }
+    });
+    for (int i = 0; i < kFrames; ++i) {
+        assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+        CommandQueueView view{};
+        assert(njgEmitCommands(slot.renderer, &view) == NjgResult::Ok);
+        assert(view.count == kPartsPerPuppet);
+    }
+    stop.store(true);
+    writer.join();
+    destroySlot(slot);
+}
+
+// Ticks one puppet per renderer through a single njgTickPuppets call per frame and returns the last frame.
+std::vector<float> runBatchedFrames(const std::string& path, std::size_t puppetCount, std::size_t threadCount) {
+    njgSetWorkerThreadCount(threadCount);
+    std::vector<RendererSlot> slots;
+    std::vector<void*> puppets;
+    for (std::size_t p = 0; p < puppetCount; ++p) {
+        slots.push_back(makeSlot(path));
+        puppets.push_back(slots.back().puppet);
+    }
+
+    std::vector<float> signature;
+    FrameConfig frame{256, 256};
+    for (int i = 0; i < kFrames; ++i) {
+        for (std::size_t p = 0; p < slots.size(); ++p) {
+            PuppetParameterUpdate upd{slots[p].paramUuid, {static_cast<float>((i + p) % 10) / 10.0f, 0.0f}};
+            assert(njgUpdateParameters(slots[p].puppet, &upd, 1) == NjgResult::Ok);
+            assert(njgBeginFrame(slots[p].renderer, &frame) == NjgResult::Ok);
+        }
+        assert(njgTickPuppets(puppets.data(), puppets.size(), 1.0 / 60.0) == NjgResult::Ok);
+        for (const auto& slot : slots) {
+            CommandQueueView view{};
+            assert(njgEmitCommands(slot.renderer, &view) == NjgResult::Ok);
+            assert(view.count == kPartsPerPuppet);
+            if (i != kFrames - 1) continue;
+            for (size_t c = 0; c < view.count; ++c) {
+                const auto& m = view.commands[c].partPacket.modelMatrix;
+                for (int r = 0; r < 4; ++r) {
+                    for (int k = 0; k < 4; ++k) signature.push_back(m[r][k]);
+                }
+            }
+        }
+    }
+    for (const auto& slot : slots) destroySlot(slot);
+    return signature;
+}
+
+void testBatchedTickMatchesSerial() {
+    const auto path = writePuppetFile("nicxlive_unity_native_test_batch", kPartsPerPuppet);
+    constexpr std::size_t kPuppets = 8;
+    const auto serial = runBatchedFrames(path, kPuppets, 1);
+    const auto parallel = runBatchedFrames(path, kPuppets, 4);
+    assert(!serial.empty());
+    assert(serial.size() == parallel.size());
+    assert(std::memcmp(serial.data(), parallel.data(), serial.size() * sizeof(float)) == 0);
+
+    int notAPuppet = 0;
+    void* bogus = &notAPuppet;
+    assert(njgTickPuppets(nullptr, 0, 1.0 / 60.0) == NjgResult::Ok);
+    assert(njgTickPuppets(nullptr, 1, 1.0 / 60.0) == NjgResult::InvalidArgument);
+    assert(njgTickPuppets(&bogus, 1, 1.0 / 60.0) == NjgResult::InvalidArgument);
+    njgSetWorkerThreadCount(0);
+}
+
+void testSharedBuffersArePerRenderer() {
+    const auto path = writePuppetFile("nicxlive_unity_native_test_atlas", kPartsPerPuppet);
+    auto a = makeSlot(path);
+    void* renderer = nullptr;
+    UnityRendererConfig cfg{64, 64};
+    assert(njgCreateRenderer(&cfg, nullptr, &renderer) == NjgResult::Ok);
+
+    SharedBufferSnapshot empty{};
+    SharedBufferState emptyState{};
+    assert(njgGetSharedBuffers(renderer, &empty) == NjgResult::Ok);
+    assert(njgGetSharedBufferState(renderer, &emptyState) == NjgResult::Ok);
+    assert(empty.vertexCount == 0 && empty.uvCount == 0 && empty.deformCount == 0);
+
+    SharedBufferSnapshot loaded{};
+    assert(njgGetSharedBuffers(a.renderer, &loaded) == NjgResult::Ok);
+    assert(loaded.vertexCount >= kPartsPerPuppet * 4);
+    assert(loaded.uvCount >= kPartsPerPuppet * 4);
+
+    // Loading, ticking and unloading a second puppet elsewhere leaves the first renderer's atlas alone.
+    SharedBufferState before{};
+    assert(njgGetSharedBufferState(a.renderer, &before) == NjgResult::Ok);
+    void* other = nullptr;
+    assert(njgLoadPuppet(renderer, path.c_str(), &other) == NjgResult::Ok);
+    assert(njgTickPuppet(other, 1.0 / 60.0) == NjgResult::Ok);
+    SharedBufferSnapshot otherLoaded{};
+    assert(njgGetSharedBuffers(renderer, &otherLoaded) == NjgResult::Ok);
+    assert(otherLoaded.vertexCount >= kPartsPerPuppet * 4);
+    assert(njgUnloadPuppet(renderer, other) == NjgResult::Ok);
+    SharedBufferState after{};
+    assert(njgGetSharedBufferState(a.renderer, &after) == NjgResult::Ok);
+    assert(after.vertexRevision == before.vertexRevision);
+    assert(after.uvRevision == before.uvRevision);
+    assert(after.deformRevision == before.deformRevision);
+    assert(njgGetSharedBuffers(a.renderer, &loaded) == NjgResult::Ok);
+    assert(loaded.vertexCount >= kPartsPerPuppet * 4);
+    assert(njgGetSharedBuffers(renderer, &empty) == NjgResult::Ok);
+    assert(empty.vertexCount == 0);
+
+    njgDestroyRenderer(renderer);
+    destroySlot(a);
+}
+
+std::vector<NjgDirtyRange> dirtyRanges(void* renderer, NjgSharedBufferKind kind) {
+    size_t count = 0;
+    assert(njgGetSharedBufferDirtyRanges(renderer, kind, nullptr, 0, &count) == NjgResult::Ok);
+    std::vector<NjgDirtyRange> ranges(count);
+    if (count) assert(njgGetSharedBufferDirtyRanges(renderer, kind, ranges.data(), ranges.size(), &count) == NjgResult::Ok);
+    return ranges;
+}
+
+std::size_t rangeElements(const std::vector<NjgDirtyRange>& ranges) {
+    std::size_t total = 0;
+    for (const auto& r : ranges) total += r.length;
+    return total;
+}
+
+// One parameter deforms a single part of a large puppet: only that part's slot should be re-uploaded.
+void benchmarkDirtyRangeUploads() {
+    constexpr std::size_t kParts = 2000;
+    const auto path = writePuppetFile("nicxlive_unity_native_test_dirty", kParts, 1);
+    auto slot = makeSlot(path);
+    FrameConfig frame{256, 256};
+    auto emitFrame = [&](float value) {
+        PuppetParameterUpdate upd{slot.paramUuid, {value, 0.0f}};
+        assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+        assert(njgBeginFrame(slot.renderer, &frame) == NjgResult::Ok);
+        assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+        CommandQueueView view{};
+        assert(njgEmitCommands(slot.renderer, &view) == NjgResult::Ok);
+    };
+
+    // The first frame uploads everything.
+    emitFrame(0.0f);
+    SharedBufferSnapshot snapshot{};
+    assert(njgGetSharedBuffers(slot.renderer, &snapshot) == NjgResult::Ok);
+    const auto firstDeform = dirtyRanges(slot.renderer, NjgSharedBufferKind::Deform);
+    assert(firstDeform.size() == 1 && firstDeform[0].offset == 0 && firstDeform[0].length == snapshot.deformCount);
+
+    // An unchanged frame uploads nothing.
+    emitFrame(0.0f);
+    assert(dirtyRanges(slot.renderer, NjgSharedBufferKind::Vertex).empty());
+    assert(dirtyRanges(slot.renderer, NjgSharedBufferKind::Uv).empty());
+    assert(dirtyRanges(slot.renderer, NjgSharedBufferKind::Deform).empty());
+
+    std::size_t fullBytes = 0;
+    std::size_t rangeBytes = 0;
+    for (int i = 1; i <= kFrames; ++i) {
+        emitFrame(static_cast<float>(i % 10 + 1) / 10.0f);
+        assert(njgGetSharedBuffers(slot.renderer, &snapshot) == NjgResult::Ok);
+        const auto deform = dirtyRanges(slot.renderer, NjgSharedBufferKind::Deform);
+        assert(deform.size() == 1 && deform[0].length == 4);
+        assert(dirtyRanges(slot.renderer, NjgSharedBufferKind::Vertex).empty());
+        assert(dirtyRanges(slot.renderer, NjgSharedBufferKind::Uv).empty());
+        // Before: hosts re-uploaded the whole deform atlas (x and y lanes) whenever the revision moved.
+        fullBytes += snapshot.deformCount * 2 * sizeof(float);
+        rangeBytes += rangeElements(deform) * 2 * sizeof(float);
+    }
+    std::printf("[unity_native_test] deform upload bytes/frame (%zu parts, 1 deformed): full=%zu ranges=%zu\n",
+                kParts, fullBytes / kFrames, rangeBytes / kFrames);
+    assert(rangeBytes * 100 < fullBytes);
+
+    size_t count = 0;
+    assert(njgGetSharedBufferDirtyRanges(slot.renderer, static_cast<NjgSharedBufferKind>(7), nullptr, 0, &count) == NjgResult::InvalidArgument);
+    assert(njgGetSharedBufferDirtyRanges(slot.renderer, NjgSharedBufferKind::Deform, nullptr, 0, nullptr) == NjgResult::InvalidArgument);
+    destroySlot(slot);
+}
+
+// The compact stream carries the same commands as the NjgQueuedCommand view in far fewer bytes.
+void benchmarkCommandStream() {
+    constexpr std::size_t kParts = 2000;
+    const auto path = writePuppetFile("nicxlive_unity_native_test_stream", kParts);
+    auto slot = makeSlot(path);
+    FrameConfig frame{256, 256};
+    assert(njgBeginFrame(slot.renderer, &frame) == NjgResult::Ok);
+    assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+
+    CommandQueueView view{};
+    assert(njgEmitCommands(slot.renderer, &view) == NjgResult::Ok);
+    assert(view.count == kParts);
+    std::vector<NjgQueuedCommand> legacy(view.commands, view.commands + view.count);
+
+    // Each emit consumes the render graph built by the tick before it.
+    NjgCommandStreamView stream{};
+    assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+    assert(njgEmitCommandStream(slot.renderer, &stream) == NjgResult::Ok);
+    assert(stream.count == legacy.size());
+    const uint8_t* cursor = stream.data;
+    for (std::size_t i = 0; i < stream.count; ++i) {
+        assert(cursor + sizeof(NjgCommandHeader) <= stream.data + stream.size);
+        const auto* header = reinterpret_cast<const NjgCommandHeader*>(cursor);
+        assert(header->size % kNjgCommandAlign == 0);
+        assert(header->kind == legacy[i].kind);
+        assert(header->kind == NjgRenderCommandKind::DrawPart);
+        const auto* packet = reinterpret_cast<const NjgPartDrawPacket*>(cursor + sizeof(NjgCommandHeader));
+        const auto& expected = legacy[i].partPacket;
+        assert(std::memcmp(&packet->modelMatrix, &expected.modelMatrix, sizeof(expected.modelMatrix)) == 0);
+        assert(packet->opacity == expected.opacity);
+        assert(packet->vertexOffset == expected.vertexOffset && packet->deformOffset == expected.deformOffset);
+        assert(packet->indices == expected.indices && packet->indexCount == expected.indexCount);
+        assert(packet->textureCount == expected.textureCount);
+        cursor += header->size;
+    }
+    assert(cursor == stream.data + stream.size);
+
+    constexpr int kRuns = 20;
+    auto time = [&](auto&& emit) {
+        double ms = 0.0;
+        for (int i = 0; i < kRuns; ++i) {
+            // Move the parameter so every emit packs a fresh frame instead of reusing the cache.
+            PuppetParameterUpdate upd{slot.paramUuid, {static_cast<float>(i % 10) / 10.0f, 0.0f}};
+            assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+            assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+            const auto start = std::chrono::steady_clock::now();
+            emit();
+            ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        return ms / kRuns;
+    };
+    const double legacyMs = time([&]() { assert(njgEmitCommands(slot.renderer, &view) == NjgResult::Ok); });
+    const double streamMs = time([&]() { assert(njgEmitCommandStream(slot.renderer, &stream) == NjgResult::Ok); });
+    const std::size_t legacyBytes = view.count * sizeof(NjgQueuedCommand);
+    std::printf("[unity_native_test] %zu draw commands: queued=%zuB (%.2fms/emit) stream=%zuB (%.2fms/emit)\n",
+                kParts, legacyBytes, legacyMs, stream.size, streamMs);
+    assert(stream.size * 2 < legacyBytes);
+
+    assert(njgEmitCommandStream(slot.renderer, nullptr) == NjgResult::InvalidArgument);
+    destroySlot(slot);
+}
+
+NjgEmitState emitState(void* renderer) {
+    NjgEmitState state{};
+    assert(njgGetEmitState(renderer, &state) == NjgResult::Ok);
+    return state;
+}
+
+// An idle puppet is neither re-updated nor re-packed; the first real change produces a new list.
+void benchmarkIdleFrames() {
+    constexpr std::size_t kParts = 2000;
+    const auto path = writePuppetFile("nicxlive_unity_native_test_idle", kParts, 1);
+    auto slot = makeSlot(path);
+    FrameConfig frame{256, 256};
+    auto runFrame = [&](double& tickMs, double& emitMs) {
+        assert(njgBeginFrame(slot.renderer, &frame) == NjgResult::Ok);
+        auto start = std::chrono::steady_clock::now();
+        assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+        tickMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        CommandQueueView view{};
+        start = std::chrono::steady_clock::now();
+        assert(njgEmitCommands(slot.renderer, &view) == NjgResult::Ok);
+        emitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        assert(view.count == kParts);
+        return view;
+    };
+
+    double busyTick = 0.0;
+    double busyEmit = 0.0;
+    CommandQueueView first{};
+    for (int i = 0; i < kFrames; ++i) {
+        PuppetParameterUpdate upd{slot.paramUuid, {static_cast<float>(i % 10) / 10.0f, 0.0f}};
+        assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+        first = runFrame(busyTick, busyEmit);
+        assert(!emitState(slot.renderer).commandsUnchanged);
+    }
+    std::vector<NjgQueuedCommand> settledFrame(first.commands, first.commands + first.count);
+
+    // The frame after the last change may still settle; from then on nothing is redone.
+    double idleTick = 0.0;
+    double idleEmit = 0.0;
+    runFrame(idleTick, idleEmit);
+    idleTick = idleEmit = 0.0;
+    const auto serial = emitState(slot.renderer).emitSerial;
+    for (int i = 0; i < kFrames; ++i) {
+        // Re-sending the current value is not a change.
+        PuppetParameterUpdate upd{slot.paramUuid, {static_cast<float>((kFrames - 1) % 10) / 10.0f, 0.0f}};
+        assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+        auto view = runFrame(idleTick, idleEmit);
+        const auto state = emitState(slot.renderer);
+        assert(state.commandsUnchanged && state.emitSerial == serial);
+        assert(view.commands == first.commands);
+        assert(std::memcmp(view.commands, settledFrame.data(), settledFrame.size() * sizeof(NjgQueuedCommand)) == 0);
+        assert(dirtyRanges(slot.renderer, NjgSharedBufferKind::Deform).empty());
+    }
+    std::printf("[unity_native_test] %zu parts per frame: busy tick=%.3fms emit=%.3fms, idle tick=%.3fms emit=%.3fms\n",
+                kParts, busyTick / kFrames, busyEmit / kFrames, idleTick / kFrames, idleEmit / kFrames);
+    assert(idleTick + idleEmit < (busyTick + busyEmit) / 10.0);
+
+    // A parameter change wakes the puppet and produces a new list.
+    PuppetParameterUpdate upd{slot.paramUuid, {0.95f, 0.0f}};
+    assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+    runFrame(busyTick, busyEmit);
+    auto state = emitState(slot.renderer);
+    assert(!state.commandsUnchanged && state.emitSerial == serial + 1);
+    assert(rangeElements(dirtyRanges(slot.renderer, NjgSharedBufferKind::Deform)) == 4);
+
+    // So does a transform change, and switching formats repacks once.
+    assert(njgSetPuppetTranslation(slot.puppet, 4.0f, 0.0f) == NjgResult::Ok);
+    runFrame(busyTick, busyEmit);
+    assert(!emitState(slot.renderer).commandsUnchanged);
+    NjgCommandStreamView stream{};
+    assert(njgEmitCommandStream(slot.renderer, &stream) == NjgResult::Ok);
+    assert(stream.count == kParts && !emitState(slot.renderer).commandsUnchanged);
+    assert(njgEmitCommandStream(slot.renderer, &stream) == NjgResult::Ok);
+    assert(stream.count == kParts && emitState(slot.renderer).commandsUnchanged);
+
+    assert(njgGetEmitState(slot.renderer, nullptr) == NjgResult::InvalidArgument);
+    destroySlot(slot);
+}
+
+// Host side of the delta protocol: rebuilds the retained list (DrawPart packets only; the fixture
+// emits nothing else) from the previous one and one delta.
+std::vector<NjgPartDrawPacket> applyDelta(const std::vector<NjgPartDrawPacket>& previous, const NjgCommandDeltaView& delta) {
+    assert(delta.baseCount == previous.size());
+    std::vector<NjgPartDrawPacket> next;
+    std::size_t cursor = 0;
+    const uint8_t* op = delta.data;
+    for (std::size_t i = 0; i < delta.opCount; ++i) {
+        const auto* header = reinterpret_cast<const NjgDeltaOpHeader*>(op);
+        const uint8_t* payload = op + sizeof(NjgDeltaOpHeader);
+        switch (header->op) {
+        case NjgDeltaOp::Keep: {
+            const auto count = reinterpret_cast<const NjgDeltaRun*>(payload)->count;
+            next.insert(next.end(), previous.begin() + cursor, previous.begin() + cursor + count);
+            cursor += count;
+            break;
+        }
+        case NjgDeltaOp::Remove:
+            cursor += reinterpret_cast<const NjgDeltaRun*>(payload)->count;
+            break;
+        case NjgDeltaOp::Insert: {
+            const auto* record = reinterpret_cast<const NjgCommandHeader*>(payload);
+            assert(record->kind == NjgRenderCommandKind::DrawPart);
+            next.push_back(*reinterpret_cast<const NjgPartDrawPacket*>(payload + sizeof(NjgCommandHeader)));
+            break;
+        }
+        case NjgDeltaOp::Patch: {
+            auto packet = previous[cursor++];
+            const auto* patch = reinterpret_cast<const NjgPartPatchHeader*>(payload);
+            const uint8_t* field = payload + sizeof(NjgPartPatchHeader);
+            auto take = [&](auto& dst) {
+                std::memcpy(&dst, field, sizeof(dst));
+                field += (sizeof(dst) + kNjgCommandAlign - 1) & ~(kNjgCommandAlign - 1);
+            };
+            if (patch->fields & NjgPartPatchModelMatrix) take(packet.modelMatrix);
+            if (patch->fields & NjgPartPatchRender) {
+                NjgPartRenderPatch render{};
+                take(render);
+                packet.renderMatrix = render.renderMatrix;
+                packet.renderRotation = render.renderRotation;
+            }
+            if (patch->fields & NjgPartPatchOpacity) take(packet.opacity);
+            if (patch->fields & NjgPartPatchTint) {
+                NjgPartTintPatch tint{};
+                take(tint);
+                packet.clampedTint = tint.clampedTint;
+                packet.clampedScreen = tint.clampedScreen;
+                packet.emissionStrength = tint.emissionStrength;
+            }
+            if (patch->fields & NjgPartPatchOffsets) {
+                NjgPartOffsetsPatch offsets{};
+                take(offsets);
+                packet.vertexOffset = offsets.vertexOffset;
+                packet.deformOffset = offsets.deformOffset;
+                packet.uvOffset = offsets.uvOffset;
+            }
+            next.push_back(packet);
+            break;
+        }
+        }
+        op += header->size;
+    }
+    assert(op == delta.data + delta.size);
+    assert(next.size() == delta.commandCount);
+    return next;
+}
+
+void checkMatchesFullEmit(void* renderer, const std::vector<NjgPartDrawPacket>& host) {
+    CommandQueueView view{};
+    assert(njgEmitCommands(renderer, &view) == NjgResult::Ok);
+    assert(view.count == host.size());
+    for (std::size_t i = 0; i < host.size(); ++i) {
+        const auto& expected = view.commands[i].partPacket;
+        assert(std::memcmp(&host[i].modelMatrix, &expected.modelMatrix, sizeof(expected.modelMatrix)) == 0);
+        assert(std::memcmp(&host[i].renderMatrix, &expected.renderMatrix, sizeof(expected.renderMatrix)) == 0);
+        assert(host[i].opacity == expected.opacity && host[i].indexHandle == expected.indexHandle);
+        assert(host[i].vertexOffset == expected.vertexOffset && host[i].deformOffset == expected.deformOffset);
+    }
+}
+
+// Replaying deltas on the host reproduces the full list; a frame where only some packets moved
+// costs a fraction of the full list.
+void benchmarkCommandDelta() {
+    constexpr std::size_t kParts = 2000;
+    const auto path = writePuppetFile("nicxlive_unity_native_test_delta", kParts);
+    auto slot = makeSlot(path);
+    FrameConfig frame{256, 256};
+    std::vector<NjgPartDrawPacket> host;
+    auto emitFrame = [&](float value) {
+        PuppetParameterUpdate upd{slot.paramUuid, {value, 0.0f}};
+        assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+        assert(njgBeginFrame(slot.renderer, &frame) == NjgResult::Ok);
+        assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+        NjgCommandDeltaView delta{};
+        assert(njgEmitCommandDelta(slot.renderer, &delta) == NjgResult::Ok);
+        host = applyDelta(host, delta);
+        checkMatchesFullEmit(slot.renderer, host);
+        return delta;
+    };
+
+    // The first delta inserts everything.
+    auto delta = emitFrame(0.0f);
+    assert(delta.baseCount == 0 && delta.opCount == kParts);
+    const std::size_t fullBytes = delta.size;
+
+    // Every part moves: one model matrix patch per part.
+    delta = emitFrame(0.5f);
+    assert(delta.opCount == kParts && delta.size * 4 <= fullBytes);
+
+    // Nothing moves: a single keep.
+    delta = emitFrame(0.5f);
+    assert(delta.opCount == 1 && delta.size == sizeof(NjgDeltaOpHeader) + sizeof(NjgDeltaRun));
+
+    // A flush drops the base; the next delta starts from an empty list again.
+    njgFlushCommandBuffer(slot.renderer);
+    host.clear();
+    delta = emitFrame(0.25f);
+    assert(delta.baseCount == 0 && delta.size == fullBytes);
+    destroySlot(slot);
+
+    // Most parts static: only the deformed ones change, and their packets stay the same, so the
+    // host keeps its list and only refreshes the atlas ranges.
+    const auto mostlyStatic = writePuppetFile("nicxlive_unity_native_test_delta_static", kParts, 1);
+    slot = makeSlot(mostlyStatic);
+    host.clear();
+    emitFrame(0.0f);
+    std::size_t deltaBytes = 0;
+    double ms = 0.0;
+    for (int i = 1; i <= kFrames; ++i) {
+        PuppetParameterUpdate upd{slot.paramUuid, {static_cast<float>(i % 10 + 1) / 10.0f, 0.0f}};
+        assert(njgUpdateParameters(slot.puppet, &upd, 1) == NjgResult::Ok);
+        assert(njgBeginFrame(slot.renderer, &frame) == NjgResult::Ok);
+        assert(njgTickPuppet(slot.puppet, 1.0 / 60.0) == NjgResult::Ok);
+        const auto start = std::chrono::steady_clock::now();
+        assert(njgEmitCommandDelta(slot.renderer, &delta) == NjgResult::Ok);
+        ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        host = applyDelta(host, delta);
+        deltaBytes += delta.size;
+    }
+    std::printf("[unity_native_test] %zu parts, 1 deformed: full list=%zuB, delta=%zuB/frame (%.2fms/emit)\n",
+                kParts, fullBytes, deltaBytes / kFrames, ms / kFrames);
+    assert(deltaBytes / kFrames * 100 < fullBytes);
+
+    assert(njgEmitCommandDelta(slot.renderer, nullptr) == NjgResult::InvalidArgument);
+    destroySlot(slot);
+}
+
+struct EmittedPart {
+    NjgPartDrawPacket packet{};
+    std::vector<float> vertices{};
+};
+
+// One frame of a freshly loaded puppet, with each part's vertices read back from the atlas.
+std::vector<EmittedPart> emitLoadedFrame(void* renderer, void* puppet) {
+    FrameConfig frame{256, 256};
+    assert(njgBeginFrame(renderer, &frame) == NjgResult::Ok);
+    assert(njgTickPuppet(puppet, 1.0 / 60.0) == NjgResult::Ok);
+    CommandQueueView view{};
+    assert(njgEmitCommands(renderer, &view) == NjgResult::Ok);
+    SharedBufferSnapshot snapshot{};
+    assert(njgGetSharedBuffers(renderer, &snapshot) == NjgResult::Ok);
+    std::vector<EmittedPart> parts;
+    for (std::size_t i = 0; i < view.count; ++i) {
+        EmittedPart part{view.commands[i].partPacket, {}};
+        for (std::size_t v = 0; v < part.packet.vertexCount; ++v) {
+            part.vertices.push_back(snapshot.vertices.data[part.packet.vertexOffset + v]);
+            part.vertices.push_back(snapshot.vertices.data[snapshot.vertexCount + part.packet.vertexOffset + v]);
+        }
+        parts.push_back(std::move(part));
+    }
+    return parts;
+}
+
+// The async path yields the same puppet as njgLoadPuppet while keeping the polling thread free.
+void benchmarkAsyncLoad() {
+    constexpr std::size_t kParts = 4000;
+    const auto path = writePuppetFile("nicxlive_unity_native_test_async", kParts);
+    UnityRendererConfig cfg{256, 256};
+
+    void* syncRenderer = nullptr;
+    void* syncPuppet = nullptr;
+    assert(njgCreateRenderer(&cfg, nullptr, &syncRenderer) == NjgResult::Ok);
+    auto start = std::chrono::steady_clock::now();
+    assert(njgLoadPuppet(syncRenderer, path.c_str(), &syncPuppet) == NjgResult::Ok);
+    const double syncMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const auto expected = emitLoadedFrame(syncRenderer, syncPuppet);
+
+    void* renderer = nullptr;
+    assert(njgCreateRenderer(&cfg, nullptr, &renderer) == NjgResult::Ok);
+    void* load = nullptr;
+    double stallMs = 0.0;
+    double worstMs = 0.0;
+    auto timed = [&](auto&& call) {
+        const auto t0 = std::chrono::steady_clock::now();
+        call();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        stallMs += ms;
+        worstMs = (std::max)(worstMs, ms);
+    };
+    timed([&]() { assert(njgLoadPuppetAsync(renderer, path.c_str(), &load) == NjgResult::Ok); });
+    void* puppet = nullptr;
+    NjgLoadProgress progress{};
+    NjgLoadStage lastStage = NjgLoadStage::Queued;
+    std::size_t polls = 0;
+    while (!puppet) {
+        timed([&]() { assert(njgPollLoad(load, &progress, &puppet) == NjgResult::Ok); });
+        assert(progress.stage >= lastStage);
+        lastStage = progress.stage;
+        ++polls;
+        if (!puppet) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(progress.stage == NjgLoadStage::Done && progress.fraction == 1.0f);
+    void* again = nullptr;
+    assert(njgPollLoad(load, &progress, &again) == NjgResult::InvalidArgument);
+    std::printf("[unity_native_test] load %zu parts: sync=%.2fms, async caller time=%.2fms (worst call %.2fms, %zu polls)\n",
+                kParts, syncMs, stallMs, worstMs, polls);
+    assert(worstMs < syncMs);
+
+    const auto loaded = emitLoadedFrame(renderer, puppet);
+    assert(loaded.size() == expected.size());
+    for (std::size_t i = 0; i < loaded.size(); ++i) {
+        assert(std::memcmp(&loaded[i].packet.modelMatrix, &expected[i].packet.modelMatrix, sizeof(expected[i].packet.modelMatrix)) == 0);
+        assert(loaded[i].packet.indexCount == expected[i].packet.indexCount);
+        assert(loaded[i].vertices == expected[i].vertices);
+    }
+    assert(njgUnloadPuppet(renderer, puppet) == NjgResult::Ok);
+    assert(njgUnloadPuppet(syncRenderer, syncPuppet) == NjgResult::Ok);
+    njgDestroyRenderer(syncRenderer);
+
+    // Cancelling releases the handle right away; the loader thread drops its work on its own.
+    assert(njgLoadPuppetAsync(renderer, path.c_str(), &load) == NjgResult::Ok);
+    assert(njgCancelLoad(load) == NjgResult::Ok);
+    assert(njgPollLoad(load, &progress, &puppet) == NjgResult::InvalidArgument);
+    assert(njgCancelLoad(load) == NjgResult::InvalidArgument);
+
+    // Errors surface through the poll.
+    const std::string missing = path + ".missing.inp";
+    assert(njgLoadPuppetAsync(renderer, missing.c_str(), &load) == NjgResult::Ok);
+    NjgResult result = NjgResult::Ok;
+    do {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        result = njgPollLoad(load, &progress, &puppet);
+    } while (result == NjgResult::Ok && progress.stage != NjgLoadStage::Done);
+    assert(result == NjgResult::Failure && progress.stage == NjgLoadStage::Failed && !puppet);
+    njgDestroyRenderer(renderer);
+}
+
+// Records the pixels the renderer uploads through the host texture callbacks.
+struct TextureUploads {
+    std::size_t next{0};
+    std::vector<std::vector<uint8_t>> pixels{};
+
+    UnityResourceCallbacks callbacks() {
+        UnityResourceCallbacks cb{};
+        cb.userData = this;
+        cb.createTexture = [](int, int, int, int, int, bool, bool, void* user) -> size_t {
+            return ++static_cast<TextureUploads*>(user)->next;
+        };
+        cb.updateTexture = [](size_t, const uint8_t* data, size_t length, int, int, int, void* user) {
+            static_cast<TextureUploads*>(user)->pixels.emplace_back(data, data + length);
+        };
+        cb.releaseTexture = [](size_t, void*) {};
+        return cb;
+    }
+};
+
+// Loading from caller memory parses in place and gives the same puppet as loading the file.
+void testLoadFromMemory() {
+    auto bytes = nicxlive::tests::makePuppetBytes(64);
+    nicxlive::tests::appendTextureSection(bytes, {nicxlive::tests::makeTgaImage(32, 0), nicxlive::tests::makeTgaImage(32, 1)});
+    const auto path = (std::filesystem::temp_directory_path() / "nicxlive_unity_native_test_memory.inp").string();
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    UnityRendererConfig cfg{256, 256};
+    TextureUploads fileUploads;
+    TextureUploads uploads;
+    const auto fileCallbacks = fileUploads.callbacks();
+    const auto callbacks = uploads.callbacks();
+    void* fileRenderer = nullptr;
+    void* filePuppet = nullptr;
+    assert(njgCreateRenderer(&cfg, &fileCallbacks, &fileRenderer) == NjgResult::Ok);
+    assert(njgLoadPuppet(fileRenderer, path.c_str(), &filePuppet) == NjgResult::Ok);
+    const auto expected = emitLoadedFrame(fileRenderer, filePuppet);
+
+    void* renderer = nullptr;
+    void* puppet = nullptr;
+    assert(njgCreateRenderer(&cfg, &callbacks, &renderer) == NjgResult::Ok);
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    assert(njgLoadPuppetFromMemory(renderer, data, bytes.size(), &puppet) == NjgResult::Ok);
+    const auto loaded = emitLoadedFrame(renderer, puppet);
+    assert(loaded.size() == expected.size() && loaded.size() == 64);
+    for (std::size_t i = 0; i < loaded.size(); ++i) {
+        assert(std::memcmp(&loaded[i].packet.modelMatrix, &expected[i].packet.modelMatrix, sizeof(expected[i].packet.modelMatrix)) == 0);
+        assert(loaded[i].vertices == expected[i].vertices);
+    }
+    assert(uploads.pixels.size() == 2 && uploads.pixels == fileUploads.pixels);
+    for (std::size_t i = 0; i < uploads.pixels.size(); ++i) {
+        assert(uploads.pixels[i].size() == 32 * 32 * 4);
+        assert(uploads.pixels[i][1] == 255 - i * 40 && uploads.pixels[i][2] == i * 40 && uploads.pixels[i][3] == 255);
+    }
+
+    // Truncated images and missing arguments are rejected without touching the renderer.
+    void* broken = nullptr;
+    assert(njgLoadPuppetFromMemory(renderer, data, bytes.size() / 2, &broken) == NjgResult::Failure && !broken);
+    assert(njgLoadPuppetFromMemory(renderer, nullptr, bytes.size(), &broken) == NjgResult::InvalidArgument);
+    assert(njgLoadPuppetFromMemory(renderer, data, 0, &broken) == NjgResult::InvalidArgument);
+
+    assert(njgUnloadPuppet(renderer, puppet) == NjgResult::Ok);
+    assert(njgUnloadPuppet(fileRenderer, filePuppet) == NjgResult::Ok);
+    njgDestroyRenderer(renderer);
+    njgDestroyRenderer(fileRenderer);
+}
+
+// Instances draw like their template, reuse its uploaded textures and outlive it.
+void testInstantiatePuppet() {
+    auto bytes = nicxlive::tests::makePuppetBytes(64, 16, 2);
+    nicxlive::tests::appendTextureSection(bytes, {nicxlive::tests::makeTgaImage(32, 0), nicxlive::tests::makeTgaImage(32, 1)});
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    UnityRendererConfig cfg{256, 256};
+    TextureUploads uploads;
+    TextureUploads otherUploads;
+    const auto callbacks = uploads.callbacks();
+    const auto otherCallbacks = otherUploads.callbacks();
+    void* renderer = nullptr;
+    void* otherRenderer = nullptr;
+    void* templ = nullptr;
+    assert(njgCreateRenderer(&cfg, &callbacks, &renderer) == NjgResult::Ok);
+    assert(njgCreateRenderer(&cfg, &otherCallbacks, &otherRenderer) == NjgResult::Ok);
+    assert(njgLoadPuppetFromMemory(renderer, data, bytes.size(), &templ) == NjgResult::Ok);
+    const auto expected = emitLoadedFrame(renderer, templ);
+    assert(expected.size() == 64 && uploads.pixels.size() == 2);
+
+    // Into another renderer: the same frame, uploaded there once.
+    void* other = nullptr;
+    assert(njgInstantiatePuppet(otherRenderer, templ, &other) == NjgResult::Ok);
+    const auto instanced = emitLoadedFrame(otherRenderer, other);
+    assert(instanced.size() == expected.size() && otherUploads.pixels == uploads.pixels);
+    for (std::size_t i = 0; i < instanced.size(); ++i) assert(instanced[i].vertices == expected[i].vertices);
+
+    // Into the template's renderer: nothing new to upload, and it keeps drawing once the template is gone.
+    void* instance = nullptr;
+    assert(njgInstantiatePuppet(renderer, templ, &instance) == NjgResult::Ok);
+    assert(uploads.pixels.size() == 2);
+    assert(njgUnloadPuppet(renderer, templ) == NjgResult::Ok);
+    const auto survivor = emitLoadedFrame(renderer, instance);
+    assert(survivor.size() == expected.size());
+    for (std::size_t i = 0; i < survivor.size(); ++i) assert(survivor[i].vertices == expected[i].vertices);
+
+    void* rejected = nullptr;
+    assert(njgInstantiatePuppet(renderer, templ, &rejected) == NjgResult::InvalidArgument && !rejected);
+    assert(njgInstantiatePuppet(renderer, instance, nullptr) == NjgResult::InvalidArgument);
+    assert(njgInstantiatePuppet(nullptr, instance, &rejected) == NjgResult::InvalidArgument);
+
+    assert(njgUnloadPuppet(renderer, instance) == NjgResult::Ok);
+    assert(njgUnloadPuppet(otherRenderer, other) == NjgResult::Ok);
+    njgDestroyRenderer(otherRenderer);
+    njgDestroyRenderer(renderer);
+}
+
+// Puppets shipping the same texture payloads share one decoded texture and, per renderer, one host
+// texture; it is released once the last puppet using it leaves.
+void testSharedTextureCache() {
+    const std::vector<std::string> images{nicxlive::tests::makeTgaImage(32, 5), nicxlive::tests::makeTgaImage(32, 6)};
+    auto bytesA = nicxlive::tests::makePuppetBytes(16, 0, 2);
+    auto bytesB = nicxlive::tests::makePuppetBytes(24, 0, 2);
+    nicxlive::tests::appendTextureSection(bytesA, images);
+    nicxlive::tests::appendTextureSection(bytesB, images);
+    const auto* dataA = reinterpret_cast<const uint8_t*>(bytesA.data());
+    const auto* dataB = reinterpret_cast<const uint8_t*>(bytesB.data());
+    UnityRendererConfig cfg{256, 256};
+    TextureUploads uploads;
+    TextureUploads otherUploads;
+    const auto callbacks = uploads.callbacks();
+    const auto otherCallbacks = otherUploads.callbacks();
+    void* renderer = nullptr;
+    void* otherRenderer = nullptr;
+    assert(njgCreateRenderer(&cfg, &callbacks, &renderer) == NjgResult::Ok);
+    assert(njgCreateRenderer(&cfg, &otherCallbacks, &otherRenderer) == NjgResult::Ok);
+
+    const auto before = njgGetTextureStats(renderer);
+    void* a = nullptr;
+    void* b = nullptr;
+    void* otherB = nullptr;
+    assert(njgLoadPuppetFromMemory(renderer, dataA, bytesA.size(), &a) == NjgResult::Ok);
+    const auto afterA = njgGetTextureStats(renderer);
+    assert(afterA.cacheMisses == before.cacheMisses + 2 && afterA.cacheHits == before.cacheHits);
+    assert(njgLoadPuppetFromMemory(renderer, dataB, bytesB.size(), &b) == NjgResult::Ok);
+    assert(njgLoadPuppetFromMemory(otherRenderer, dataB, bytesB.size(), &otherB) == NjgResult::Ok);
+    const auto afterB = njgGetTextureStats(renderer);
+    assert(afterB.cacheHits == afterA.cacheHits + 4 && afterB.cacheMisses == afterA.cacheMisses);
+    assert(afterB.cacheEntries == before.cacheEntries + 2);
+    // One host texture per renderer.
+    assert(uploads.pixels.size() == 2 && afterB.current == afterA.current && otherUploads.pixels == uploads.pixels);
+
+    // B keeps the shared textures alive and drawn after A leaves.
+    assert(njgUnloadPuppet(renderer, a) == NjgResult::Ok);
+    assert(njgGetTextureStats(renderer).released == afterB.released);
+    assert(emitLoadedFrame(renderer, b).size() == 24);
+    assert(njgUnloadPuppet(renderer, b) == NjgResult::Ok);
+    assert(njgGetTextureStats(renderer).released == afterB.released + 2);
+
+    // Once no puppet uses them they are gone; the next load decodes again.
+    assert(njgUnloadPuppet(otherRenderer, otherB) == NjgResult::Ok);
+    assert(njgGetTextureStats(renderer).cacheEntries == before.cacheEntries);
+    assert(njgLoadPuppetFromMemory(renderer, dataA, bytesA.size(), &a) == NjgResult::Ok);
+    assert(njgGetTextureStats(renderer).cacheMisses == afterB.cacheMisses + 2);
+    assert(njgUnloadPuppet(renderer, a) == NjgResult::Ok);
+    njgDestroyRenderer(otherRenderer);
+    njgDestroyRenderer(renderer);
+}
+
+// Slot decoding fans out over the texture decode pool; the uploaded pixels stay identical and in
+// slot order at every thread count.
+void benchmarkTextureDecode() {
+    constexpr std::size_t kSlots = 12;
+    constexpr int kSize = 1024;
+    auto bytes = nicxlive::tests::makePuppetBytes(16);
+    std::vector<std::string> images;
+    for (std::size_t i = 0; i < kSlots; ++i) images.push_back(nicxlive::tests::makePngImage(kSize, i));
+    nicxlive::tests::appendTextureSection(bytes, images);
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+
+    const std::size_t hw = (std::max)(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> threadCounts{1, 2, 4};
+    if (hw > 4) threadCounts.push_back(hw);
+    UnityRendererConfig cfg{256, 256};
+    std::vector<std::vector<uint8_t>> reference;
+    std::vector<double> times;
+    for (std::size_t threads : threadCounts) {
+        njgSetTextureDecodeThreadCount(threads);
+        TextureUploads uploads;
+        const auto callbacks = uploads.callbacks();
+        void* renderer = nullptr;
+        void* puppet = nullptr;
+        assert(njgCreateRenderer(&cfg, &callbacks, &renderer) == NjgResult::Ok);
+        const auto start = std::chrono::steady_clock::now();
+        assert(njgLoadPuppetFromMemory(renderer, data, bytes.size(), &puppet) == NjgResult::Ok);
+        times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        assert(uploads.pixels.size() == kSlots);
+        for (std::size_t i = 0; i < kSlots; ++i) {
+            const auto& px = uploads.pixels[i];
+            assert(px.size() == static_cast<std::size_t>(kSize) * kSize * 4);
+            // Pixel (x=5, y=3) of slot i, as written by makePngImage.
+            const std::size_t at = (3 * static_cast<std::size_t>(kSize) + 5) * 4;
+            assert(px[at] == static_cast<uint8_t>(5 + i * 31) && px[at + 1] == static_cast<uint8_t>(3 + i * 17));
+        }
+        if (reference.empty()) reference = uploads.pixels;
+        assert(uploads.pixels == reference);
+        assert(njgUnloadPuppet(renderer, puppet) == NjgResult::Ok);
+        njgDestroyRenderer(renderer);
+    }
+    njgSetTextureDecodeThreadCount(0);
+
+    std::printf("[unity_native_test] decode %zu x %dx%d PNG slots:", kSlots, kSize, kSize);
+    for (std::size_t i = 0; i < threadCounts.size(); ++i) std::printf(" %zu thread(s)=%.2fms", threadCounts[i], times[i]);
+    std::printf(" (%zu cores)\n", hw);
+    if (hw >= 4) assert(times.back() < times.front());
+}
+
+// Deferred slots decode only when a part first draws them, so a puppet drawing few of its slots
+// reaches its first frame sooner and holds less; the budget then drops pixels the host already has.
+void benchmarkDeferredTextureDecode() {
+    constexpr std::size_t kSlots = 16;
+    constexpr std::size_t kDrawnSlots = 4;
+    constexpr int kSize = 512;
+    constexpr std::size_t kTextureBytes = static_cast<std::size_t>(kSize) * kSize * 4;
+    auto bytes = nicxlive::tests::makePuppetBytes(16, 0, kDrawnSlots);
+    std::vector<std::string> images;
+    for (std::size_t i = 0; i < kSlots; ++i) images.push_back(nicxlive::tests::makePngImage(kSize, i));
+    nicxlive::tests::appendTextureSection(bytes, images);
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    UnityRendererConfig cfg{256, 256};
+
+    auto firstFrame = [&](const NjgTexturePolicy& policy, TextureUploads& uploads, void*& renderer, void*& puppet) {
+        const auto callbacks = uploads.callbacks();
+        assert(njgCreateRenderer(&cfg, &callbacks, &renderer) == NjgResult::Ok);
+        assert(njgSetTexturePolicy(renderer, &policy) == NjgResult::Ok);
+        const auto start = std::chrono::steady_clock::now();
+        assert(njgLoadPuppetFromMemory(renderer, data, bytes.size(), &puppet) == NjgResult::Ok);
+        emitLoadedFrame(renderer, puppet);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    TextureUploads eagerUploads;
+    void* eagerRenderer = nullptr;
+    void* eagerPuppet = nullptr;
+    const double eagerMs = firstFrame(NjgTexturePolicy{0, SIZE_MAX}, eagerUploads, eagerRenderer, eagerPuppet);
+    NjgTextureResidency eager{};
+    assert(njgGetTextureResidency(eagerRenderer, &eager) == NjgResult::Ok);
+    assert(eager.residentCount == kSlots && eager.residentBytes == kSlots * kTextureBytes && eager.deferredCount == 0);
+    assert(eagerUploads.pixels.size() == kSlots);
+
+    TextureUploads uploads;
+    void* renderer = nullptr;
+    void* puppet = nullptr;
+    const double deferredMs = firstFrame(NjgTexturePolicy{1, SIZE_MAX}, uploads, renderer, puppet);
+    NjgTextureResidency deferred{};
+    assert(njgGetTextureResidency(renderer, &deferred) == NjgResult::Ok);
+    assert(deferred.residentCount == kDrawnSlots && deferred.deferredCount == kSlots - kDrawnSlots);
+    assert(deferred.residentBytes == kDrawnSlots * kTextureBytes);
+    // Only the drawn slots reach the host, with the pixels an eager load uploads for them.
+    assert(uploads.pixels.size() == kDrawnSlots);
+    auto drawn = uploads.pixels;
+    std::vector<std::vector<uint8_t>> expected(eagerUploads.pixels.begin(), eagerUploads.pixels.begin() + kDrawnSlots);
+    std::sort(drawn.begin(), drawn.end());
+    std::sort(expected.begin(), expected.end());
+    assert(drawn == expected);
+
+    // Shrinking the budget drops the least recently drawn pixels; nothing is uploaded again.
+    NjgTexturePolicy policy{1, 2 * kTextureBytes};
+    assert(njgSetTexturePolicy(renderer, &policy) == NjgResult::Ok);
+    assert(njgGetTextureResidency(renderer, &deferred) == NjgResult::Ok);
+    assert(deferred.residentCount == 2 && deferred.residentBytes == 2 * kTextureBytes);
+    policy.residentBudgetBytes = 0;
+    assert(njgSetTexturePolicy(renderer, &policy) == NjgResult::Ok);
+    NjgParameterInfo info{};
+    size_t count = 0;
+    assert(njgGetParameters(puppet, &info, 1, &count) == NjgResult::Ok && count == 1);
+    PuppetParameterUpdate upd{info.uuid, {0.5f, 0.0f}};
+    assert(njgUpdateParameters(puppet, &upd, 1) == NjgResult::Ok);
+    emitLoadedFrame(renderer, puppet);
+    assert(njgGetTextureResidency(renderer, &deferred) == NjgResult::Ok);
+    assert(deferred.residentBytes == 0 && deferred.residentCount == 0 && deferred.deferredCount == kSlots);
+    assert(uploads.pixels.size() == kDrawnSlots);
+    const auto stats = njgGetTextureStats(renderer);
+    assert(njgUnloadPuppet(renderer, puppet) == NjgResult::Ok);
+    assert(njgGetTextureStats(renderer).released == stats.released + kDrawnSlots);
+
+    std::printf("[unity_native_test] load + first frame, %zu of %zu %dx%d slots drawn: eager=%.2fms (%zu KiB resident), "
+                "deferred=%.2fms (%zu KiB resident)\n",
+                kDrawnSlots, kSlots, kSize, kSize, eagerMs, eager.residentBytes / 1024, deferredMs,
+                kDrawnSlots * kTextureBytes / 1024);
+    assert(deferredMs < eagerMs);
+    assert(njgUnloadPuppet(eagerRenderer, eagerPuppet) == NjgResult::Ok);
+    njgDestroyRenderer(eagerRenderer);
+    njgDestroyRenderer(renderer);
+}
+
+// Bytes the process heap holds right now (0 where the allocator cannot tell).
+std::size_t heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    const auto info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// A host that copies each upload straight into its own (here: discarded) storage. Counts uploads of
+// `width`-wide textures only (render targets are uploaded too).
+struct CountingUploads {
+    int width{0};
+    std::size_t next{0};
+    std::size_t textures{0};
+    std::size_t bytes{0};
+    std::size_t checksum{0};
+
+    UnityResourceCallbacks callbacks() {
+        UnityResourceCallbacks cb{};
+        cb.userData = this;
+        cb.createTexture = [](int, int, int, int, int, bool, bool, void* user) -> size_t {
+            return ++static_cast<CountingUploads*>(user)->next;
+        };
+        cb.updateTexture = [](size_t, const uint8_t* data, size_t length, int w, int, int, void* user) {
+            auto* self = static_cast<CountingUploads*>(user);
+            if (w != self->width) return;
+            self->textures++;
+            self->bytes += length;
+            for (std::size_t i = 0; i < length; i += 4096) self->checksum += data[i];
+        };
+        cb.releaseTexture = [](size_t, void*) {};
+        return cb;
+    }
+};
+
+// A decoded slot is one buffer shared by the Texture and its backend commands; with
+// releaseAfterUpload the host's copy is the only one left once the frame drained the commands.
+void benchmarkTextureHandoff() {
+    constexpr std::size_t kSlots = 16;
+    constexpr int kSize = 1024;
+    constexpr std::size_t kPixelBytes = kSlots * kSize * kSize * 4;
+    auto bytes = nicxlive::tests::makePuppetBytes(64, 0, kSlots);
+    std::vector<std::string> images;
+    for (std::size_t i = 0; i < kSlots; ++i) images.push_back(nicxlive::tests::makePngImage(kSize, i));
+    nicxlive::tests::appendTextureSection(bytes, images);
+    const auto* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    UnityRendererConfig cfg{256, 256};
+
+    struct Run {
+        NjgTextureResidency residency{};
+        std::size_t heapBytes{0};
+        CountingUploads uploads{};
+    };
+    auto run = [&](uint32_t releaseAfterUpload) {
+        Run result;
+        result.uploads.width = kSize;
+        const auto callbacks = result.uploads.callbacks();
+        void* renderer = nullptr;
+        void* puppet = nullptr;
+        assert(njgCreateRenderer(&cfg, &callbacks, &renderer) == NjgResult::Ok);
+        const NjgTexturePolicy policy{0, SIZE_MAX, releaseAfterUpload};
+        assert(njgSetTexturePolicy(renderer, &policy) == NjgResult::Ok);
+        const auto heapBefore = heapInUse();
+        assert(njgLoadPuppetFromMemory(renderer, data, bytes.size(), &puppet) == NjgResult::Ok);
+        emitLoadedFrame(renderer, puppet);
+        const auto heapAfter = heapInUse();
+        result.heapBytes = heapAfter > heapBefore ? heapAfter - heapBefore : 0;
+        assert(njgGetPuppetTextureResidency(puppet, &result.residency) == NjgResult::Ok);
+        assert(njgUnloadPuppet(renderer, puppet) == NjgResult::Ok);
+        njgDestroyRenderer(renderer);
+        return result;
+    };
+
+    const auto kept = run(0);
+    const auto released = run(1);
+    assert(kept.uploads.textures == kSlots && kept.uploads.bytes == kPixelBytes);
+    assert(released.uploads.bytes == kept.uploads.bytes && released.uploads.checksum == kept.uploads.checksum);
+    assert(kept.residency.residentCount == kSlots && kept.residency.residentBytes == kPixelBytes);
+    assert(released.residency.residentCount == 0 && released.residency.residentBytes == 0);
+    std::printf("[unity_native_test] %zu x %dx%d slots (%zu KiB decoded): heap after first frame kept=%zu KiB, "
+                "releaseAfterUpload=%zu KiB\n",
+                kSlots, kSize, kSize, kPixelBytes / 1024, kept.heapBytes / 1024, released.heapBytes / 1024);
+    if (heapInUse() != 0) {
+        // One copy of the pixels at most (previously the queue backend kept two more).
+        assert(kept.heapBytes < kPixelBytes + kPixelBytes / 4);
+        assert(released.heapBytes < kPixelBytes / 4);
+    }
+}
+
+// Host render targets created/released by the renderer.
+struct TargetCallbacks {
+    std::size_t created{0};
+    std::size_t released{0};
+
+    UnityResourceCallbacks callbacks() {
+        UnityResourceCallbacks cb{};
+        cb.userData = this;
+        cb.createTexture = [](int, int, int, int, int, bool, bool, void* user) -> size_t {
+            return ++static_cast<TargetCallbacks*>(user)->created;
+        };
+        cb.updateTexture = [](size_t, const uint8_t*, size_t, int, int, int, void*) {};
+        cb.releaseTexture = [](size_t, void* user) { ++static_cast<TargetCallbacks*>(user)->released; };
+        return cb;
+    }
+};
+
+// A window dragged back and forth between two sizes reuses the parked viewport targets instead of
+// recreating both on every change; targets left unused are released after the idle window.
+void benchmarkViewportResize() {
+    constexpr int kResizes = 400;
+    constexpr int kIdleFrames = 121;
+    TargetCallbacks targets;
+    const auto callbacks = targets.callbacks();
+    UnityRendererConfig cfg{800, 600};
+    void* renderer = nullptr;
+    assert(njgCreateRenderer(&cfg, &callbacks, &renderer) == NjgResult::Ok);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kResizes; ++i) {
+        FrameConfig frame{(i % 2) ? 820 : 800, 600};
+        assert(njgBeginFrame(renderer, &frame) == NjgResult::Ok);
+    }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    // Render + composite target for each of the two sizes.
+    assert(targets.created == 4);
+    assert(targets.released == 0);
+
+    // Settle on a third size; the two parked pairs go once they have sat idle long enough.
+    FrameConfig settled{1024, 768};
+    for (int i = 0; i < kIdleFrames; ++i) assert(njgBeginFrame(renderer, &settled) == NjgResult::Ok);
+    assert(targets.created == 6);
+    assert(targets.released == 2);
+    assert(njgBeginFrame(renderer, &settled) == NjgResult::Ok);
+    assert(targets.released == 4);
+    std::printf("[unity_native_test] %d viewport resizes: %.2fms created=4 (unpooled: %d)\n", kResizes, ms, kResizes * 2);
+    njgDestroyRenderer(renderer);
+    assert(targets.released == targets.created);
+}
+
+void testStaleHandlesAreRejected() {
+    const auto path = writePuppetFile("nicxlive_unity_native_test_stale", 1);
+    RendererSlot slot{};
+    UnityRendererConfig cfg{64, 64};
+    assert(njgCreateRenderer(&cfg, nullptr, &slot.renderer) == NjgResult::Ok);
+    assert(njgLoadPuppet(slot.renderer, path.c_str(), &slot.puppet) == NjgResult::Ok);
+    assert(njgUnloadPuppet(slot.renderer, slot.puppet) == NjgResult::Ok);
+    assert(njgTickPuppet(slot.puppet, 0.0) == NjgResult::InvalidArgument);
+    njgDestroyRenderer(slot.renderer);
+    CommandQueueView view{};
+    assert(njgEmitCommands(slot.renderer, &view) == NjgResult::InvalidArgument);
+}
+
+} // namespace
+
+int main() {
+    njgRuntimeInit();
+    testConcurrentRenderersMatchSerial();
+    testConcurrentAccessToOnePuppet();
+    testBatchedTickMatchesSerial();
+    testSharedBuffersArePerRenderer();
+    benchmarkDirtyRangeUploads();
+    benchmarkCommandStream();
+    benchmarkIdleFrames();
+    benchmarkCommandDelta();
+    benchmarkAsyncLoad();
+    testLoadFromMemory();
+    testInstantiatePuppet();
+    testSharedTextureCache();
+    benchmarkTextureDecode();
+    benchmarkDeferredTextureDecode();
+    benchmarkTextureHandoff();
+    benchmarkViewportResize();
+    testStaleHandlesAreRejected();
+    njgRuntimeTerm();
+    return 0;
+}
@@ -0,0 +1,56 @@
+// nicxc: builds a precompiled puppet cache (.nicxc) from an INP/INX file.
+//
+//   nicxc <puppet.inp|puppet.inx> [-o <out.nicxc>] [--keep-encoded]
+//
+// The cache loads through the same entry points as the source (njgLoadPuppet, inLoadPuppet).
+// --keep-encoded stores texture slots as their PNG/TGA payload instead of decoded pixels.
+
+#include "../fmt/fmt.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+int usage() {
+    std::fprintf(stderr, "usage: nicxc <puppet.inp|puppet.inx> [-o <out.nicxc>] [--keep-encoded]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string input;
+    std::string output;
+    nicxlive::core::fmt::PuppetCacheOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "--keep-encoded") {
+            options.keepEncodedTextures = true;
+        } else if (!arg.empty() && arg[0] != '-' && input.empty()) {
+            input = arg;
+        } else {
+            return usage();
+        }
+    }
+    if (input.empty()) return usage();
+    if (output.empty()) output = std::filesystem::path(input).replace_extension(".nicxc").string();
+
+    try {
+        const auto start = std::chrono::steady_clock::now();
+        nicxlive::core::fmt::inWritePuppetCache(input, output, options);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%s -> %s (%ju -> %ju bytes, %.1fms)\n", input.c_str(), output.c_str(),
+                    static_cast<uintmax_t>(std::filesystem::file_size(input)),
+                    static_cast<uintmax_t>(std::filesystem::file_size(output)), ms);
+    } catch (const std::exception& ex) {
+        std::fprintf(stderr, "nicxc: %s\n", ex.what());
+        return 1;
+    }
+    return 0;
+}
@@ -273,6 +273,158 @@ namespace Nicxlive.UnityBackend.Interop
             public nuint DeformCount;
         }
 
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgCommandHeader
+        {
+            public NjgRenderCommandKind Kind;
+            public uint Size;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgMaskApplyHeader
+        {
+            public MaskDrawableKind Kind;
+            public uint IsDodge;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgCommandStreamView
+        {
+            public IntPtr Data;
+            public nuint Size;
+            public nuint Count;
+        }
+
+        public enum NjgDeltaOp : uint
+        {
+            Keep,
+            Remove,
+            Insert,
+            Patch,
+        }
+
+        [Flags]
+        public enum NjgPartPatchField : uint
+        {
+            ModelMatrix = 1u << 0,
+            Render = 1u << 1,
+            Opacity = 1u << 2,
+            Tint = 1u << 3,
+            Offsets = 1u << 4,
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgDeltaOpHeader
+        {
+            public NjgDeltaOp Op;
+            public uint Size;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgDeltaRun
+        {
+            public uint Count;
+            public uint Reserved;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgPartPatchHeader
+        {
+            public NjgPartPatchField Fields;
+            public uint Reserved;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgPartRenderPatch
+        {
+            public Mat4 RenderMatrix;
+            public float RenderRotation;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgPartTintPatch
+        {
+            public Vec3 ClampedTint;
+            public Vec3 ClampedScreen;
+            public float EmissionStrength;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgPartOffsetsPatch
+        {
+            public nuint VertexOffset;
+            public nuint VertexAtlasStride;
+            public nuint UvOffset;
+            public nuint UvAtlasStride;
+            public nuint DeformOffset;
+            public nuint DeformAtlasStride;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgCommandDeltaView
+        {
+            public IntPtr Data;
+            public nuint Size;
+            public nuint OpCount;
+            public nuint BaseCount;
+            public nuint CommandCount;
+        }
+
+        public enum NjgSharedBufferKind : uint
+        {
+            Vertex,
+            Uv,
+            Deform,
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgDirtyRange
+        {
+            public nuint Offset;
+            public nuint Length;
+        }
+
+        public enum NjgLoadStage : uint
+        {
+            Queued,
+            Reading,
+            Parsing,
+            Building,
+            Ready,
+            Done,
+            Failed,
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgLoadProgress
+        {
+            public NjgLoadStage Stage;
+            public float Fraction;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgEmitState
+        {
+            public uint CommandsUnchanged;
+            public nuint EmitSerial;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgTexturePolicy
+        {
+            public uint DeferDecode;
+            public nuint ResidentBudgetBytes;
+            public uint ReleaseAfterUpload;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        public struct NjgTextureResidency
+        {
+            public nuint ResidentBytes;
+            public nuint ResidentCount;
+            public nuint DeferredCount;
+        }
+
         [StructLayout(LayoutKind.Sequential)]
         public struct NjgWasmLayout
         {
@@ -335,9 +487,33 @@ namespace Nicxlive.UnityBackend.Interop
         [DllImport(DllName, EntryPoint = "njgLoadPuppet", CallingConvention = CallingConvention.Cdecl)]
         public static extern NjgResult LoadPuppet(IntPtr renderer, [MarshalAs(UnmanagedType.LPUTF8Str)] string path, out IntPtr puppet);
 
+        [DllImport(DllName, EntryPoint = "njgLoadPuppetFromMemory", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult LoadPuppetFromMemory(IntPtr renderer, IntPtr data, nuint length, out IntPtr puppet);
+
         [DllImport(DllName, EntryPoint = "njgUnloadPuppet", CallingConvention = CallingConvention.Cdecl)]
         public static extern NjgResult UnloadPuppet(IntPtr renderer, IntPtr puppet);
 
+        [DllImport(DllName, EntryPoint = "njgLoadPuppetAsync", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult LoadPuppetAsync(IntPtr renderer, [MarshalAs(UnmanagedType.LPUTF8Str)] string path, out IntPtr load);
+
+        [DllImport(DllName, EntryPoint = "njgPollLoad", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult PollLoad(IntPtr load, out NjgLoadProgress progress, out IntPtr puppet);
+
+        [DllImport(DllName, EntryPoint = "njgCancelLoad", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult CancelLoad(IntPtr load);
+
+        [DllImport(DllName, EntryPoint = "njgSetTextureDecodeThreadCount", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetTextureDecodeThreadCount(nuint threadCount);
+
+        [DllImport(DllName, EntryPoint = "njgSetTexturePolicy", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult SetTexturePolicy(IntPtr renderer, ref NjgTexturePolicy policy);
+
+        [DllImport(DllName, EntryPoint = "njgGetTextureResidency", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult GetTextureResidency(IntPtr renderer, out NjgTextureResidency residency);
+
+        [DllImport(DllName, EntryPoint = "njgGetPuppetTextureResidency", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult GetPuppetTextureResidency(IntPtr puppet, out NjgTextureResidency residency);
+
         [DllImport(DllName, EntryPoint = "njgGetParameters", CallingConvention = CallingConvention.Cdecl)]
         public static extern NjgResult GetParameters(IntPtr puppet, IntPtr buffer, nuint bufferLength, out nuint outCount);
 
@@ -356,12 +532,30 @@ namespace Nicxlive.UnityBackend.Interop
         [DllImport(DllName, EntryPoint = "njgTickPuppet", CallingConvention = CallingConvention.Cdecl)]
         public static extern NjgResult TickPuppet(IntPtr puppet, double deltaSeconds);
 
+        [DllImport(DllName, EntryPoint = "njgTickPuppets", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult TickPuppets(IntPtr[] puppets, nuint count, double deltaSeconds);
+
+        [DllImport(DllName, EntryPoint = "njgSetWorkerThreadCount", CallingConvention = CallingConvention.Cdecl)]
+        public static extern void SetWorkerThreadCount(nuint threadCount);
+
         [DllImport(DllName, EntryPoint = "njgEmitCommands", CallingConvention = CallingConvention.Cdecl)]
         public static extern NjgResult EmitCommands(IntPtr renderer, out CommandQueueView view);
 
+        [DllImport(DllName, EntryPoint = "njgEmitCommandStream", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult EmitCommandStream(IntPtr renderer, out NjgCommandStreamView view);
+
+        [DllImport(DllName, EntryPoint = "njgEmitCommandDelta", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult EmitCommandDelta(IntPtr renderer, out NjgCommandDeltaView view);
+
+        [DllImport(DllName, EntryPoint = "njgGetEmitState", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult GetEmitState(IntPtr renderer, out NjgEmitState state);
+
         [DllImport(DllName, EntryPoint = "njgGetSharedBuffers", CallingConvention = CallingConvention.Cdecl)]
         public static extern NjgResult GetSharedBuffers(IntPtr renderer, out SharedBufferSnapshot snapshot);
 
+        [DllImport(DllName, EntryPoint = "njgGetSharedBufferDirtyRanges", CallingConvention = CallingConvention.Cdecl)]
+        public static extern NjgResult GetSharedBufferDirtyRanges(IntPtr renderer, NjgSharedBufferKind kind, IntPtr buffer, nuint bufferLength, out nuint outCount);
+
         [DllImport(DllName, EntryPoint = "njgGetWasmLayout", CallingConvention = CallingConvention.Cdecl)]
         public static extern NjgResult GetWasmLayout(out NjgWasmLayout layout);
     }